@@ -82,6 +82,31 @@
     #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+/** Serve small `lv_malloc()` requests from per-size-class slabs placed on top of the selected allocator.
+ *  Widgets, styles and event descriptors are made of many small short-lived allocations which are
+ *  much cheaper to take from a free list than from the general purpose heap. */
+#define LV_USE_MEM_SLAB 0
+#if LV_USE_MEM_SLAB
+    /** Memory reserved for the slabs at `lv_init()`. Requests fall back to the allocator when it's used up. */
+    #define LV_MEM_SLAB_SIZE (256 * 1024U)          /**< [bytes] */
+
+    /** Size of one slab. A slab holds blocks of only one size class and can be reused by another class
+     *  once all of its blocks are freed. Must be larger than `LV_MEM_SLAB_MAX_SIZE`. */
+    #define LV_MEM_SLAB_CHUNK_SIZE (4 * 1024U)      /**< [bytes] */
+
+    /** Largest request served from the slabs. Larger requests go to the allocator directly. */
+    #define LV_MEM_SLAB_MAX_SIZE 256                /**< [bytes] */
+
+    /** Number of free blocks per size class each thread can keep for itself, so that e.g. the
+     *  draw threads don't contend on the slab lock. 0: disable. Requires `LV_OS_PTHREAD`. */
+    #define LV_MEM_SLAB_THREAD_CACHE_CNT 0
+#endif
+
+/** Attribute each `lv_malloc()` to a subsystem (Widgets, styles, layers, images, fonts, ...) and
+ *  keep the current and peak size allocated by each. Works with every `LV_USE_STDLIB_MALLOC`.
+ *  Adds a header of two `size_t`s to every allocation. See `lv_mem_tag_get_info()`. */
+#define LV_USE_MEM_TAGS 0
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -150,6 +175,12 @@
  * Set it to 0 to have no limit. */
 #define LV_DRAW_LAYER_MAX_MEMORY (16 * 1024 * 1024)   /**< No limit by default [bytes]*/
 
+/** Allocate the draw tasks and their descriptors from per-layer arenas made of chunks of this size
+ *  instead of calling `lv_malloc()` for each draw task. When all the draw tasks of a layer are finished
+ *  its chunks are given back to a pool and reused for the next tasks, so steady frames don't allocate.
+ *  Set it to 0 to allocate each draw task separately. */
+#define LV_DRAW_TASK_ARENA_SIZE (16 * 1024)   /**< [bytes]*/
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -197,14 +228,23 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /** Allow buffering some shadow calculation.
          *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
+         *  `shadow_width + radius`.  The blurred corners are kept in an LRU cache with
+         *  `2 * LV_DRAW_SW_SHADOW_CACHE_SIZE^2` bytes budget, so one shadow of this size or several
+         *  smaller ones fit. */
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6` bytes are used per circle (the least recently used radiuses are dropped).
          *  - 0: disables caching */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+
+        /** Size of the cache of arcs' ring coverage in bytes.
+         *  With the cached ring only the angle needs to be applied when an arc is drawn again
+         *  with the same radius and width, e.g. for rotating or animated arcs.
+         *  A quarter of the ring is cached, using `radius^2` bytes (+ `arc_width^2` for rounded arcs).
+         *  - 0: disables caching */
+        #define LV_DRAW_SW_ARC_CACHE_SIZE (64 * 1024)
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -418,6 +458,13 @@
 /** 1: Draw a red overlay for ARGB layers and a green overlay for RGB layers*/
 #define LV_USE_LAYER_DEBUG 0
 
+/** 1: Draw a green border around the Widgets drawn from their render cache and a red one if the cache was (re)rendered*/
+#define LV_USE_RENDER_CACHE_DEBUG 0
+
+/** 1: Count the pixel writes of each frame to measure the overdraw and optionally draw a heatmap over the
+ *  redrawn areas. Works with the software renderer. Enable it with `lv_refr_overdraw_enable()`. */
+#define LV_USE_OVERDRAW_DEBUG 0
+
 /** 1: Adds the following behaviors for debugging:
  *  - Draw overlays with different colors for each draw_unit's tasks.
  *  - Draw index number of draw unit on white background.
@@ -457,9 +504,35 @@
  *  - 254: round up */
 #define LV_COLOR_MIX_ROUND_OFS  0
 
+/** Precompute the built-in ease-in, ease-out, ease-in-out and overshoot animation paths
+ *  into lookup tables on their first use. Each used path allocates about 2 kB and its
+ *  evaluation becomes a table read instead of solving the cubic bezier curve. */
+#define LV_ANIM_PATH_LUT        1
+
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      1
 
+/** Number of resolved style properties cached per object (0: disable).
+ *  Must be a power of 2. Each object allocates `LV_OBJ_STYLE_RESOLVED_CACHE_SIZE * 12` bytes
+ *  (8 bytes on 32-bit systems) on the first style property read. 64 is enough for most widgets.
+ *  Repeated property reads of unchanged objects (e.g. while redrawing) become a single lookup. */
+#define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE    64
+
+/** Memory budget for the rendered content of Widgets with `lv_obj_set_render_cache(obj, true)` (0: disable).
+ *  These Widgets and their children are rendered once into an ARGB8888 buffer which is drawn as an image
+ *  until one of them changes. The least recently drawn buffers are freed when the budget is exceeded. */
+#define LV_OBJ_RENDER_CACHE_SIZE    (512 * 1024)   /**< [bytes]*/
+
+/** 1: Skip drawing Widgets which are fully covered by opaque Widgets above them in the refreshed area.
+ *  The opaque areas are collected once per refresh and checked before drawing each Widget.
+ *  See `lv_refr_get_occlusion_stats()` for the number of pixels saved. */
+#define LV_USE_OCCLUSION_CULLING    1
+
+/** Keep a spatial index (a uniform grid) of the children of Widgets having at least this many children (0: disable).
+ *  Hit-testing and redrawing an area check only the children around the point or area
+ *  instead of all of them. It pays off for screens or containers with hundreds of children. */
+#define LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN    64
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -986,7 +1059,7 @@
 /* Documentation for several of the below items can be found here: https://docs.lvgl.io/master/details/auxiliary-modules/index.html . */
 
 /** 1: Enable API to take snapshot for object */
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /** 1: Enable system monitor component */
 #define LV_USE_SYSMON   0
@@ -1021,6 +1094,11 @@
     #if LV_USE_PROFILER_BUILTIN
         /** Default profiler trace buffer size */
         #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /**< [bytes] */
+        /** Max. number of threads with their own lock-free trace buffer of `LV_PROFILER_BUILTIN_BUF_SIZE`.
+         *  Used if `tid_get_cb` is set in the profiler's config. */
+        #define LV_PROFILER_BUILTIN_THREAD_MAX 8
+        /** Default output format. 0: Android systrace text; 1: Chrome trace event JSON */
+        #define LV_PROFILER_BUILTIN_DEFAULT_FORMAT 0
     #endif
 
     /** Header to include for profiler */
@@ -1038,6 +1116,9 @@
     /** Profiler end point function with custom tag */
     #define LV_PROFILER_END_TAG   LV_PROFILER_BUILTIN_END_TAG
 
+    /** Profiler function to record the value of a counter, e.g. memory usage */
+    #define LV_PROFILER_COUNTER   LV_PROFILER_BUILTIN_COUNTER
+
     /*Enable layout profiler*/
     #define LV_PROFILER_LAYOUT 1
 
@@ -1164,6 +1245,9 @@
     #define LV_X11_RENDER_MODE_PARTIAL 1  /**< Partial render mode (preferred) */
     #define LV_X11_RENDER_MODE_DIRECT  0  /**< Direct render mode */
     #define LV_X11_RENDER_MODE_FULL    0  /**< Full render mode */
+    /** Share the window image with the X server via MIT-SHM (XShmPutImage), requires linking libXext.
+     *  Falls back to XPutImage if the extension is not available (e.g. remote X server). */
+    #define LV_X11_USE_SHM             1
 #endif
 
 /** Use Wayland to open a window and handle input on Linux or BSD desktops */
@@ -1221,6 +1305,18 @@
      * The GBM library aims to provide a platform independent memory management system
      * it supports the major GPU vendors - This option requires linking with libgbm */
     #define LV_LINUX_DRM_GBM_BUFFERS 0
+
+    /** LV_DISPLAY_RENDER_MODE_DIRECT: LVGL renders into the two screen sized DRM buffers directly.
+     *  LV_DISPLAY_RENDER_MODE_PARTIAL: LVGL renders into a smaller buffer that is copied into the DRM buffers.
+     *  In both modes only the changed areas are sent to the kernel in the FB_DAMAGE_CLIPS plane property. */
+    #define LV_LINUX_DRM_RENDER_MODE LV_DISPLAY_RENDER_MODE_DIRECT
+
+    /** Size of the draw buffer in partial render mode (in number of rows) */
+    #define LV_LINUX_DRM_BUFFER_SIZE 60
+
+    /** Use three DRM buffers in partial render mode, so rendering can start while a page flip is pending.
+     *  Call `lv_linux_drm_handle_events()` when the fd returned by `lv_linux_drm_get_fd()` is readable. */
+    #define LV_LINUX_DRM_TRIPLE_BUFFER 0
 #endif
 
 /** Interface for TFT_eSPI */
@@ -1228,6 +1324,12 @@
 
 /** Driver for evdev input devices */
 #define LV_USE_EVDEV    0
+#if LV_USE_EVDEV
+    /** Read the devices in a thread blocking on their file descriptor instead of polling them
+     *  from the indev timer. Pointer motion is coalesced between reads, the indevs are switched
+     *  to event mode and read with `lv_lock()` held. Requires `LV_USE_OS`. */
+    #define LV_EVDEV_USE_THREAD    0
+#endif
 
 /** Driver for libinput input devices */
 #define LV_USE_LIBINPUT    0
@@ -80,6 +80,11 @@
     #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+/** Attribute each `lv_malloc()` to a subsystem (Widgets, styles, layers, images, fonts, ...) and
+ *  keep the current and peak size allocated by each. Works with every `LV_USE_STDLIB_MALLOC`.
+ *  Adds a header of two `size_t`s to every allocation. See `lv_mem_tag_get_info()`. */
+#define LV_USE_MEM_TAGS 0
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -189,14 +194,23 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /** Allow buffering some shadow calculation.
          *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
+         *  `shadow_width + radius`.  The blurred corners are kept in an LRU cache with
+         *  `2 * LV_DRAW_SW_SHADOW_CACHE_SIZE^2` bytes budget, so one shadow of this size or several
+         *  smaller ones fit. */
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6` bytes are used per circle (the least recently used radiuses are dropped).
          *  - 0: disables caching */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+
+        /** Size of the cache of arcs' ring coverage in bytes.
+         *  With the cached ring only the angle needs to be applied when an arc is drawn again
+         *  with the same radius and width, e.g. for rotating or animated arcs.
+         *  A quarter of the ring is cached, using `radius^2` bytes (+ `arc_width^2` for rounded arcs).
+         *  - 0: disables caching */
+        #define LV_DRAW_SW_ARC_CACHE_SIZE 0
     #endif
 
     #if !defined(LV_USE_DRAW_SW_ASM) && defined(RTE_Acceleration_Arm_2D)
@@ -383,6 +397,13 @@
 /** 1: Draw a red overlay for ARGB layers and a green overlay for RGB layers*/
 #define LV_USE_LAYER_DEBUG 0
 
+/** 1: Draw a green border around the Widgets drawn from their render cache and a red one if the cache was (re)rendered*/
+#define LV_USE_RENDER_CACHE_DEBUG 0
+
+/** 1: Count the pixel writes of each frame to measure the overdraw and optionally draw a heatmap over the
+ *  redrawn areas. Works with the software renderer. Enable it with `lv_refr_overdraw_enable()`. */
+#define LV_USE_OVERDRAW_DEBUG 0
+
 /** 1: Adds the following behaviors for debugging:
  *  - Draw overlays with different colors for each draw_unit's tasks.
  *  - Draw index number of draw unit on white background.
@@ -425,6 +446,21 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/** Memory budget for the rendered content of Widgets with `lv_obj_set_render_cache(obj, true)` (0: disable).
+ *  These Widgets and their children are rendered once into an ARGB8888 buffer which is drawn as an image
+ *  until one of them changes. The least recently drawn buffers are freed when the budget is exceeded. */
+#define LV_OBJ_RENDER_CACHE_SIZE    0   /**< [bytes]*/
+
+/** 1: Skip drawing Widgets which are fully covered by opaque Widgets above them in the refreshed area.
+ *  The opaque areas are collected once per refresh and checked before drawing each Widget.
+ *  See `lv_refr_get_occlusion_stats()` for the number of pixels saved. */
+#define LV_USE_OCCLUSION_CULLING    0
+
+/** Keep a spatial index (a uniform grid) of the children of Widgets having at least this many children (0: disable).
+ *  Hit-testing and redrawing an area check only the children around the point or area
+ *  instead of all of them. It pays off for screens or containers with hundreds of children. */
+#define LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN    0
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -926,6 +962,11 @@
     #if LV_USE_PROFILER_BUILTIN
         /** Default profiler trace buffer size */
         #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /**< [bytes] */
+        /** Max. number of threads with their own lock-free trace buffer of `LV_PROFILER_BUILTIN_BUF_SIZE`.
+         *  Used if `tid_get_cb` is set in the profiler's config. */
+        #define LV_PROFILER_BUILTIN_THREAD_MAX 8
+        /** Default output format. 0: Android systrace text; 1: Chrome trace event JSON */
+        #define LV_PROFILER_BUILTIN_DEFAULT_FORMAT 0
     #endif
 
     /** Header to include for profiler */
@@ -943,6 +984,9 @@
     /** Profiler end point function with custom tag */
     #define LV_PROFILER_END_TAG   LV_PROFILER_BUILTIN_END_TAG
 
+    /** Profiler function to record the value of a counter, e.g. memory usage */
+    #define LV_PROFILER_COUNTER   LV_PROFILER_BUILTIN_COUNTER
+
     /*Enable layout profiler*/
     #define LV_PROFILER_LAYOUT 1
 
@@ -1038,6 +1082,9 @@
     #define LV_X11_RENDER_MODE_PARTIAL 1  /**< Partial render mode (preferred) */
     #define LV_X11_RENDER_MODE_DIRECT  0  /**< Direct render mode */
     #define LV_X11_RENDER_MODE_FULL    0  /**< Full render mode */
+    /** Share the window image with the X server via MIT-SHM (XShmPutImage), requires linking libXext.
+     *  Falls back to XPutImage if the extension is not available (e.g. remote X server). */
+    #define LV_X11_USE_SHM             0
 #endif
 
 /** Use Wayland to open a window and handle input on Linux or BSD desktops */
@@ -1079,6 +1126,12 @@
 
 /** Driver for evdev input devices */
 #define LV_USE_EVDEV    0
+#if LV_USE_EVDEV
+    /** Read the devices in a thread blocking on their file descriptor instead of polling them
+     *  from the indev timer. Pointer motion is coalesced between reads, the indevs are switched
+     *  to event mode and read with `lv_lock()` held. Requires `LV_USE_OS`. */
+    #define LV_EVDEV_USE_THREAD    0
+#endif
 
 /** Driver for libinput input devices */
 #define LV_USE_LIBINPUT    0
@@ -55,6 +55,7 @@ extern "C" {
 #include "src/core/lv_obj_scroll_private.h"
 #include "src/core/lv_obj_draw_private.h"
 #include "src/core/lv_obj_class_private.h"
+#include "src/core/lv_obj_spatial_index_private.h"
 #include "src/core/lv_group_private.h"
 #include "src/core/lv_obj_event_private.h"
 #include "src/misc/lv_timer_private.h"
@@ -98,6 +99,7 @@ extern "C" {
 #include "src/widgets/tabview/lv_tabview_private.h"
 #include "src/tick/lv_tick_private.h"
 #include "src/stdlib/builtin/lv_tlsf_private.h"
+#include "src/stdlib/lv_mem_slab_private.h"
 #include "src/libs/rlottie/lv_rlottie_private.h"
 #include "src/libs/ffmpeg/lv_ffmpeg_private.h"
 #include "src/widgets/lottie/lv_lottie_private.h"
@@ -21,6 +21,7 @@ extern "C" {
 #include "../draw/sw/lv_draw_sw.h"
 #endif
 #include "../misc/lv_anim.h"
+#include "../misc/lv_array.h"
 #include "../misc/lv_area.h"
 #include "../misc/lv_color_op.h"
 #include "../misc/lv_ll.h"
@@ -52,6 +53,8 @@ extern "C" {
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
+#include "../stdlib/lv_mem_private.h"
+#include "../stdlib/lv_mem_slab_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../others/test/lv_test_private.h"
 #include "../layouts/lv_layout_private.h"
@@ -88,12 +91,27 @@ typedef struct _lv_global_t {
     lv_ll_t disp_ll;
     lv_display_t * disp_refresh;
     lv_display_t * disp_default;
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    lv_cache_t * obj_render_cache;
+    lv_array_t obj_render_cache_used;   /**< Entries drawn in the current refresh. Released when it's ready.*/
+#endif
+#if LV_USE_OCCLUSION_CULLING
+    lv_array_t refr_occluders;          /**< Opaque areas of the Widgets collected for the current refresh*/
+    lv_array_t refr_area_occluders;     /**< Occluders on the area being rendered*/
+    lv_layer_t * refr_occlusion_layer;  /**< Widgets drawn on this layer are culled*/
+#endif
 
     lv_ll_t style_trans_ll;
     bool style_refresh;
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    uint32_t style_resolved_cache_gen;      /**< Incremented on every change which can affect resolved style properties */
+    uint32_t style_resolved_cache_obj_cnt;
+    uint32_t style_resolved_cache_hit_cnt;
+    uint32_t style_resolved_cache_miss_cnt;
+#endif
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -128,11 +146,10 @@ typedef struct _lv_global_t {
 
     lv_draw_global_info_t draw_info;
     lv_ll_t draw_sw_blend_handler_ll;
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    lv_draw_sw_shadow_cache_t sw_shadow_cache;
-#endif
 #if LV_DRAW_SW_COMPLEX
-    lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    lv_cache_t * sw_shadow_cache;
+    lv_cache_t * sw_circle_cache;
+    lv_cache_t * sw_arc_cache;
 #endif
 
 #if LV_USE_LOG
@@ -159,6 +176,14 @@ typedef struct _lv_global_t {
     lv_tlsf_state_t tlsf_state;
 #endif
 
+#if LV_USE_MEM_TAGS
+    lv_mem_tag_state_t mem_tag_state;
+#endif
+
+#if LV_USE_MEM_SLAB
+    lv_mem_slab_state_t mem_slab_state;
+#endif
+
     lv_ll_t fsdrv_ll;
 #if LV_USE_FS_STDIO != '\0'
     lv_fs_drv_t stdio_fs_drv;
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_obj_private.h"
+#include "lv_obj_spatial_index_private.h"
 #include "../misc/lv_event_private.h"
 #include "../misc/lv_area_private.h"
 #include "lv_obj_style_private.h"
@@ -15,6 +16,7 @@
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
 #include "lv_refr.h"
+#include "lv_refr_private.h"
 #include "lv_group.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
@@ -30,6 +32,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_obj_class)
 #define LV_OBJ_DEF_WIDTH    (LV_DPX(100))
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
@@ -49,6 +54,8 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_scrollbar(lv_obj_t * obj, lv_layer_t * layer);
 static lv_result_t scrollbar_init_draw_dsc(lv_obj_t * obj, lv_draw_rect_dsc_t * dsc);
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
+static bool state_diff_is_scrollbar_only(lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
+static void invalidate_scrollbars(lv_obj_t * obj);
 static void update_obj_state(lv_obj_t * obj, lv_state_t new_state);
 static void null_on_delete_cb(lv_event_t * e);
 
@@ -548,6 +555,14 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         }
 #endif
 
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+        if(obj->spec_attr->render_cache) lv_refr_render_cache_invalidate(obj);
+#endif
+
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+        lv_obj_spatial_index_delete(obj);
+#endif
+
         lv_free(obj->spec_attr);
         obj->spec_attr = NULL;
     }
@@ -916,13 +931,25 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == LV_STYLE_STATE_CMP_SAME) {
         obj->state = new_state;
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+        /*The children might inherit from a style of the new state*/
+        lv_obj_style_resolved_cache_invalidate(obj, true);
+#endif
         return;
     }
 
+    /*If only the look of the scrollbars changes (e.g. in LV_STATE_SCROLLED) there is no need to redraw the whole object*/
+    bool scrollbar_only = cmp_res == LV_STYLE_STATE_CMP_DIFF_REDRAW &&
+                          state_diff_is_scrollbar_only(obj, prev_state, new_state);
+
     /*Invalidate the object in their current state*/
-    lv_obj_invalidate(obj);
+    if(scrollbar_only) invalidate_scrollbars(obj);
+    else lv_obj_invalidate(obj);
 
     obj->state = new_state;
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    lv_obj_style_resolved_cache_invalidate(obj, true);
+#endif
     lv_obj_update_layer_type(obj);
     lv_obj_style_transition_dsc_t * ts = lv_malloc_zeroed(sizeof(lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -969,7 +996,10 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
 
     lv_free(ts);
 
-    if(cmp_res == LV_STYLE_STATE_CMP_DIFF_REDRAW) {
+    if(scrollbar_only) {
+        invalidate_scrollbars(obj);
+    }
+    else if(cmp_res == LV_STYLE_STATE_CMP_DIFF_REDRAW) {
         /*Invalidation is not enough, e.g. layer type needs to be updated too*/
         lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
     }
@@ -982,6 +1012,38 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     }
 }
 
+/**
+ * Check if the styles which are different in two states are all on the scrollbar part
+ * @param obj       pointer to an object
+ * @param state1    a state
+ * @param state2    another state
+ * @return          true: only the scrollbars can look different in the two states
+ */
+static bool state_diff_is_scrollbar_only(lv_obj_t * obj, lv_state_t state1, lv_state_t state2)
+{
+    uint32_t i;
+    for(i = 0; i < obj->style_cnt; i++) {
+        if(obj->styles[i].is_trans) continue;
+
+        lv_state_t state_act = lv_obj_style_get_selector_state(obj->styles[i].selector);
+        bool valid1 = state_act & (~state1) ? false : true;
+        bool valid2 = state_act & (~state2) ? false : true;
+        if(valid1 == valid2) continue;
+
+        if(lv_obj_style_get_selector_part(obj->styles[i].selector) != LV_PART_SCROLLBAR) return false;
+    }
+
+    return true;
+}
+
+static void invalidate_scrollbars(lv_obj_t * obj)
+{
+    lv_area_t hor_area, ver_area;
+    lv_obj_get_scrollbar_area(obj, &hor_area, &ver_area);
+    lv_obj_invalidate_area(obj, &hor_area);
+    lv_obj_invalidate_area(obj, &ver_area);
+}
+
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find)
 {
     /*Check all children of `parent`*/
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_class_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_spatial_index_private.h"
 #include "../themes/lv_theme.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
@@ -16,6 +17,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_obj_class)
 
 /**********************
@@ -96,6 +100,9 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         parent->spec_attr->children = lv_realloc(parent->spec_attr->children,
                                                  sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
         parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+        lv_obj_spatial_index_mark_dirty(parent);
+#endif
     }
 
     return obj;
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_draw_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_spatial_index_private.h"
 #include "lv_obj_style.h"
 #include "../display/lv_display.h"
 #include "../indev/lv_indev.h"
@@ -371,7 +372,12 @@ void lv_obj_refresh_ext_draw_size(lv_obj_t * obj)
         obj->spec_attr->ext_draw_size = s_new;
     }
 
-    if(s_new != s_old) lv_obj_invalidate(obj);
+    if(s_new != s_old) {
+        lv_obj_invalidate(obj);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+        lv_obj_spatial_index_mark_dirty(lv_obj_get_parent(obj));
+#endif
+    }
     LV_PROFILER_DRAW_END;
 }
 
@@ -381,6 +387,27 @@ int32_t lv_obj_get_ext_draw_size(const lv_obj_t * obj)
     else return 0;
 }
 
+void lv_obj_set_render_cache(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    if(lv_obj_get_render_cache(obj) == en) return;
+
+    lv_obj_allocate_spec_attr(obj);
+
+    /*Also frees the already cached content*/
+    lv_obj_invalidate(obj);
+    obj->spec_attr->render_cache = en;
+}
+
+bool lv_obj_get_render_cache(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    if(obj->spec_attr) return obj->spec_attr->render_cache;
+    else return false;
+}
+
 lv_layer_type_t lv_obj_get_layer_type(const lv_obj_t * obj)
 {
 
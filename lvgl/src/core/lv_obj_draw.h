@@ -117,6 +117,24 @@ int32_t lv_obj_calculate_ext_draw_size(lv_obj_t * obj, lv_part_t part);
  */
 void lv_obj_refresh_ext_draw_size(lv_obj_t * obj);
 
+/**
+ * Keep the rendered content of a Widget and its children in a buffer and draw that buffer
+ * instead of redrawing them, until the Widget or one of its children changes.
+ * The buffers share the `LV_OBJ_RENDER_CACHE_SIZE` memory budget. The least recently drawn ones are freed if needed.
+ * @param obj       pointer to an object
+ * @param en        true: enable the render cache; false: disable it
+ * @note            It's useful for static but complex subtrees (shadows, gradients, rounded corners)
+ *                  and for transformed Widgets whose content doesn't change.
+ */
+void lv_obj_set_render_cache(lv_obj_t * obj, bool en);
+
+/**
+ * Get whether the rendered content of a Widget is cached
+ * @param obj       pointer to an object
+ * @return          true: the render cache is enabled
+ */
+bool lv_obj_get_render_cache(const lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
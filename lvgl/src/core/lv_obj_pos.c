@@ -12,6 +12,7 @@
 #include "lv_obj_draw_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_spatial_index_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
@@ -20,6 +21,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_obj_class)
 #define update_layout_mutex LV_GLOBAL_DEFAULT()->layout_update_mutex
 
@@ -33,6 +37,25 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void invalidate_area_core(const lv_obj_t * obj, const lv_area_t * area);
+static void mark_subtree_layout_as_dirty(lv_obj_t * obj);
+/**
+ * Mark the object and its ancestors to let `layout_update_core` find the dirty object
+ * without traversing the whole widget tree.
+ * @param obj   pointer to an object which has a pending layout or scroll readjustment
+ */
+static void mark_subtree_layout_as_dirty(lv_obj_t * obj)
+{
+    obj->subtree_layout_inv = 1;
+
+    /*The ancestors above an already marked parent are marked too*/
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent && !parent->subtree_layout_inv) {
+        parent->subtree_layout_inv = 1;
+        parent = lv_obj_get_parent(parent);
+    }
+}
+
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 static bool is_transformed(const lv_obj_t * obj);
 
@@ -188,6 +211,9 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    lv_obj_spatial_index_mark_dirty(parent);
+#endif
 
     /*Call the ancestor's event handler to the object with its new coordinates*/
     lv_obj_send_event(obj, LV_EVENT_SIZE_CHANGED, &ori);
@@ -199,6 +225,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_subtree_layout_as_dirty(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -282,6 +309,7 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
+    mark_subtree_layout_as_dirty(obj);
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
     lv_obj_t * scr = lv_obj_get_screen(obj);
@@ -722,8 +750,8 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
      *occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
 
-    /*Invalidate the original area*/
-    lv_obj_invalidate(obj);
+    /*Invalidate the original area. Only the position changes, so the cached content can be kept*/
+    lv_obj_invalidate_placement(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -745,6 +773,9 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
     obj->coords.y1 += diff.y;
     obj->coords.x2 += diff.x;
     obj->coords.y2 += diff.y;
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    lv_obj_spatial_index_mark_dirty(parent);
+#endif
 
     lv_obj_move_children_by(obj, diff.x, diff.y, false);
 
@@ -752,7 +783,7 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
     if(parent) lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj);
 
     /*Invalidate the new area*/
-    lv_obj_invalidate(obj);
+    lv_obj_invalidate_placement(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -766,9 +797,18 @@ void lv_obj_move_children_by(lv_obj_t * obj, int32_t x_diff, int32_t y_diff, boo
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    lv_obj_spatial_index_move(obj, x_diff, y_diff);
+#endif
     for(i = 0; i < child_cnt; i++) {
         lv_obj_t * child = obj->spec_attr->children[i];
-        if(ignore_floating && lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
+        if(ignore_floating && lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) {
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+            /*This child stays in place, so the index can't be simply shifted*/
+            lv_obj_spatial_index_mark_dirty(obj);
+#endif
+            continue;
+        }
         child->coords.x1 += x_diff;
         child->coords.y1 += y_diff;
         child->coords.x2 += x_diff;
@@ -823,28 +863,29 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    lv_display_t * disp   = lv_obj_get_display(obj);
-    if(!lv_display_is_invalidation_enabled(disp)) return;
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    /*Even if it's not visible now, the cached content is outdated*/
+    lv_refr_render_cache_invalidate(obj);
+#endif
 
-    lv_area_t area_tmp;
-    lv_area_copy(&area_tmp, area);
+    invalidate_area_core(obj, area);
+}
 
-    if(!lv_obj_area_is_visible(obj, &area_tmp)) return;
-#if LV_DRAW_TRANSFORM_USE_MATRIX
-    /**
-     * When using the global matrix, the vertex coordinates of clip_area lose precision after transformation,
-     * which can be solved by expanding the redrawing area.
-     */
-    lv_area_increase(&area_tmp, 5, 5);
-#else
-    if(obj->spec_attr && obj->spec_attr->layer_type == LV_LAYER_TYPE_TRANSFORM) {
-        /*Make the area slightly larger to avoid rounding errors.
-         *5 is an empirical value*/
-        lv_area_increase(&area_tmp, 5, 5);
-    }
+void lv_obj_invalidate_placement(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    /*The cached content of the object is still valid, but the parents' show it at the old place*/
+    lv_refr_render_cache_invalidate(obj->parent);
 #endif
 
-    lv_inv_area(lv_obj_get_display(obj),  &area_tmp);
+    lv_area_t obj_coords;
+    int32_t ext_size = lv_obj_get_ext_draw_size(obj);
+    lv_area_copy(&obj_coords, &obj->coords);
+    lv_area_increase(&obj_coords, ext_size, ext_size);
+
+    invalidate_area_core(obj, &obj_coords);
 }
 
 void lv_obj_invalidate(const lv_obj_t * obj)
@@ -936,6 +977,9 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, int32_t size)
 
     lv_obj_allocate_spec_attr(obj);
     obj->spec_attr->ext_click_pad = size;
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    lv_obj_spatial_index_mark_dirty(lv_obj_get_parent(obj));
+#endif
 }
 
 void lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
@@ -1223,6 +1267,10 @@ static int32_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
+    /*Nothing is dirty in this subtree, don't walk it*/
+    if(!obj->subtree_layout_inv) return;
+    obj->subtree_layout_inv = 0;
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
     for(i = 0; i < child_cnt; i++) {
@@ -1304,3 +1352,29 @@ static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p
 
     lv_point_array_transform(p, p_count, angle, scale_x, scale_y, &pivot, !inv);
 }
+
+static void invalidate_area_core(const lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_display_t * disp   = lv_obj_get_display(obj);
+    if(!lv_display_is_invalidation_enabled(disp)) return;
+
+    lv_area_t area_tmp;
+    lv_area_copy(&area_tmp, area);
+
+    if(!lv_obj_area_is_visible(obj, &area_tmp)) return;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    /**
+     * When using the global matrix, the vertex coordinates of clip_area lose precision after transformation,
+     * which can be solved by expanding the redrawing area.
+     */
+    lv_area_increase(&area_tmp, 5, 5);
+#else
+    if(obj->spec_attr && obj->spec_attr->layer_type == LV_LAYER_TYPE_TRANSFORM) {
+        /*Make the area slightly larger to avoid rounding errors.
+         *5 is an empirical value*/
+        lv_area_increase(&area_tmp, 5, 5);
+    }
+#endif
+
+    lv_inv_area(lv_obj_get_display(obj),  &area_tmp);
+}
@@ -37,6 +37,9 @@ struct _lv_obj_spec_attr_t {
     lv_event_list_t event_list;
 #if LV_USE_OBJ_NAME
     const char * name;              /**< Pointer to the name */
+#endif
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    struct _lv_obj_spatial_index_t * spatial_index;   /**< Grid of the children for hit-testing and redrawing*/
 #endif
     lv_point_t scroll;              /**< The current X/Y scroll offset*/
 
@@ -50,6 +53,7 @@ struct _lv_obj_spec_attr_t {
     uint16_t scroll_dir : 4;        /**< The allowed scroll direction(s), see `lv_dir_t`*/
     uint16_t layer_type : 2;        /**< Cache the layer type here. Element of lv_intermediate_layer_type_t */
     uint16_t name_static : 1;        /**< 1: `name` was not dynamically allocated */
+    uint16_t render_cache : 1;      /**< 1: Keep the rendered content in a buffer, see `lv_obj_set_render_cache()`*/
 };
 
 struct _lv_obj_t {
@@ -60,6 +64,9 @@ struct _lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    struct _lv_obj_style_resolved_t * style_resolved;   /**< Table of resolved style properties, allocated on demand*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -76,6 +83,7 @@ struct _lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+    uint16_t subtree_layout_inv : 1;    /**< The object or one of its descendants needs a layout update*/
 };
 
 
@@ -83,6 +91,15 @@ struct _lv_obj_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Mark the area of an object as invalid when only its position, transformation or layered
+ * opacity has changed, i.e. it looks the same, just at a different place.
+ * Unlike `lv_obj_invalidate()` it keeps the cached rendered content of the object
+ * (see `lv_obj_set_render_cache()`) and frees only its parents'.
+ * @param obj       pointer to an object
+ */
+void lv_obj_invalidate_placement(const lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -9,10 +9,12 @@
 #include "lv_obj_scroll_private.h"
 #include "../misc/lv_anim_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_draw_private.h"
+#include "lv_refr_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_scroll.h"
 #include "../display/lv_display.h"
-#include "../misc/lv_area.h"
+#include "../misc/lv_area_private.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +38,9 @@
 static void scroll_x_anim(void * obj, int32_t v);
 static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_end_cb(lv_anim_t * a);
+static bool get_scroll_move_area(lv_obj_t * obj, lv_area_t * area);
+static bool is_area_covered_by_children(lv_obj_t * parent, uint32_t start_id, const lv_area_t * area,
+                                        bool floating_only);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
 
@@ -416,13 +421,52 @@ lv_result_t lv_obj_scroll_by_raw(lv_obj_t * obj, int32_t x, int32_t y)
 
     lv_obj_allocate_spec_attr(obj);
 
+    /*Check before scrolling if the rendered content can be moved instead of redrawing it*/
+    lv_area_t move_area;
+    lv_area_t hor_area_old;
+    lv_area_t ver_area_old;
+    bool move = get_scroll_move_area(obj, &move_area);
+    if(move) lv_obj_get_scrollbar_area(obj, &hor_area_old, &ver_area_old);
+
     obj->spec_attr->scroll.x += x;
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RESULT_OK) return res;
-    lv_obj_invalidate(obj);
+
+    if(move && lv_inv_area_move(lv_obj_get_display(obj), &move_area, x, y)) {
+        /*Redraw only the border and the scrollbars around the moved content*/
+        lv_area_t a;
+        a = obj->coords;
+        a.y2 = move_area.y1 - 1;
+        lv_obj_invalidate_area(obj, &a);
+        a = obj->coords;
+        a.y1 = move_area.y2 + 1;
+        lv_obj_invalidate_area(obj, &a);
+        a = move_area;
+        a.x1 = obj->coords.x1;
+        a.x2 = move_area.x1 - 1;
+        lv_obj_invalidate_area(obj, &a);
+        a.x1 = move_area.x2 + 1;
+        a.x2 = obj->coords.x2;
+        lv_obj_invalidate_area(obj, &a);
+
+        /*The old scrollbars were moved with the content*/
+        lv_area_move(&hor_area_old, x, y);
+        lv_area_move(&ver_area_old, x, y);
+        lv_obj_invalidate_area(obj, &hor_area_old);
+        lv_obj_invalidate_area(obj, &ver_area_old);
+
+        lv_area_t hor_area;
+        lv_area_t ver_area;
+        lv_obj_get_scrollbar_area(obj, &hor_area, &ver_area);
+        lv_obj_invalidate_area(obj, &hor_area);
+        lv_obj_invalidate_area(obj, &ver_area);
+    }
+    else {
+        lv_obj_invalidate(obj);
+    }
     return LV_RESULT_OK;
 }
 
@@ -683,6 +727,118 @@ void lv_obj_readjust_scroll(lv_obj_t * obj, lv_anim_enable_t anim_en)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Check if the rendered content of a scrolled object can be simply moved
+ * and get the area whose content can be moved.
+ * It's possible only if nothing else is drawn on the area than the object's solid background and the scrolled children.
+ * @param obj       pointer to an object to scroll
+ * @param area      store the visible part of the object's inner area here
+ * @return          true: the content can be moved; false: the object needs to be redrawn
+ */
+static bool get_scroll_move_area(lv_obj_t * obj, lv_area_t * area)
+{
+    if(!lv_obj_has_flag(obj, LV_OBJ_FLAG_SCROLL_BLIT)) return false;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    lv_display_t * disp = lv_obj_get_display(obj);
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    if(scr != lv_display_get_screen_active(disp) || lv_display_get_screen_prev(disp) != NULL) return false;
+
+    /*The background needs to be the same everywhere*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_grad(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+
+    /*The scrollbars are redrawn, but they shouldn't draw out of their area*/
+    if(lv_obj_get_style_shadow_width(obj, LV_PART_SCROLLBAR) != 0) return false;
+    if(lv_obj_get_style_outline_width(obj, LV_PART_SCROLLBAR) != 0) return false;
+
+    /*Leave out the border and the rounded corners*/
+    int32_t w = lv_obj_get_width(obj);
+    int32_t h = lv_obj_get_height(obj);
+    int32_t r = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), LV_MIN(w, h) / 2);
+    int32_t bw = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    int32_t inner = LV_MAX(r, bw);
+    *area = obj->coords;
+    lv_area_increase(area, -inner, -inner);
+    if(lv_area_get_width(area) <= 0 || lv_area_get_height(area) <= 0) return false;
+
+    /*Only the visible part can be moved, the rest is the parents' content*/
+    lv_area_t vis_area = *area;
+    if(!lv_obj_area_is_visible(obj, &vis_area)) return false;
+
+    /*Floating children are not scrolled*/
+    if(is_area_covered_by_children(obj, 0, &vis_area, true)) return false;
+
+    /*Nothing can be drawn on the object by its parents or the later siblings*/
+    lv_obj_t * child = obj;
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        if(lv_obj_get_layer_type(child) != LV_LAYER_TYPE_NONE) return false;
+        if(lv_obj_get_render_cache(child)) return false;
+        if(lv_obj_get_style_clip_corner(parent, LV_PART_MAIN)) return false;
+        if(lv_obj_get_style_border_post(parent, LV_PART_MAIN) &&
+           lv_obj_get_style_border_width(parent, LV_PART_MAIN) > 0) return false;
+
+        lv_area_t hor_area;
+        lv_area_t ver_area;
+        lv_obj_get_scrollbar_area(parent, &hor_area, &ver_area);
+        if(lv_area_is_on(&hor_area, &vis_area) || lv_area_is_on(&ver_area, &vis_area)) return false;
+
+        if(is_area_covered_by_children(parent, lv_obj_get_index(child) + 1, &vis_area, false)) return false;
+
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+    if(lv_obj_get_layer_type(child) != LV_LAYER_TYPE_NONE) return false;
+    if(lv_obj_get_render_cache(child)) return false;
+
+    lv_obj_t * top = lv_display_get_layer_top(disp);
+    lv_obj_t * sys = lv_display_get_layer_sys(disp);
+    if(lv_obj_get_style_bg_opa(top, LV_PART_MAIN) > LV_OPA_MIN) return false;
+    if(lv_obj_get_style_bg_opa(sys, LV_PART_MAIN) > LV_OPA_MIN) return false;
+    if(is_area_covered_by_children(top, 0, &vis_area, false)) return false;
+    if(is_area_covered_by_children(sys, 0, &vis_area, false)) return false;
+
+    *area = vis_area;
+    return true;
+}
+
+/**
+ * Check if any visible child of an object is drawn on an area
+ * @param parent            pointer to an object
+ * @param start_id          check the children starting from this index
+ * @param area              the area to check
+ * @param floating_only     true: check only the `LV_OBJ_FLAG_FLOATING` children
+ * @return                  true: at least one child is drawn on the area
+ */
+static bool is_area_covered_by_children(lv_obj_t * parent, uint32_t start_id, const lv_area_t * area,
+                                        bool floating_only)
+{
+    uint32_t child_cnt = lv_obj_get_child_count(parent);
+    uint32_t i;
+    for(i = start_id; i < child_cnt; i++) {
+        lv_obj_t * child = parent->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        if(floating_only && !lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
+
+        /*The children of this child can be anywhere*/
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return true;
+
+        lv_area_t child_area = child->coords;
+        int32_t ext_size = lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&child_area, ext_size, ext_size);
+        if(lv_obj_get_layer_type(child) == LV_LAYER_TYPE_TRANSFORM) {
+            lv_obj_get_transformed_area(child, &child_area, LV_OBJ_POINT_TRANSFORM_FLAG_NONE);
+        }
+        if(lv_area_is_on(&child_area, area)) return true;
+    }
+
+    return false;
+}
+
 static void scroll_x_anim(void * obj, int32_t v)
 {
     lv_obj_scroll_by_raw(obj, v + lv_obj_get_scroll_x(obj), 0);
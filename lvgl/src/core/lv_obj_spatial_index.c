@@ -0,0 +1,413 @@
+/**
+ * @file lv_obj_spatial_index.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_spatial_index_private.h"
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+
+#include "lv_obj_private.h"
+#include "lv_obj_draw_private.h"
+#include "../misc/lv_area_private.h"
+#include "../misc/lv_math.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
+/*Size of the cells in pixels at least*/
+#define CELL_SIZE_MIN       16
+
+/*Don't create more cells than this in a row or column*/
+#define CELL_CNT_MAX        256
+
+/*Children covering more cells than this are not stored in the cells but checked on every query*/
+#define CHILD_CELL_CNT_MAX  16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A uniform grid over the children of an object.
+ * Each cell stores the indices of the children whose bounds overlap it, in increasing order.
+ * The bounds are in the coordinates of the last build, `ofs` is how much the children moved since then.
+ */
+struct _lv_obj_spatial_index_t {
+    lv_area_t * bounds;         /**< Extended area of each child*/
+    uint32_t * stamps;          /**< The last query which checked or found each child, see `stamp_act`*/
+    uint32_t * result;          /**< Indices of the children found by the last query*/
+    uint32_t * cell_start;      /**< Index of the first item of each cell in `items` (`cell_cnt + 1` elements)*/
+    uint32_t * items;           /**< Child indices grouped by cells*/
+    uint32_t * large;           /**< Children which are not in the cells (large or transformed)*/
+    uint32_t child_cap;         /**< Size of the per-child arrays*/
+    uint32_t item_cap;          /**< Size of `items`*/
+    uint32_t cell_cap;          /**< Size of `cell_start`*/
+    uint32_t large_cnt;
+    uint32_t stamp_act;
+    lv_area_t grid_area;        /**< The area covered by the cells*/
+    lv_point_t ofs;
+    int32_t cell_w;
+    int32_t cell_h;
+    int32_t col_cnt;
+    int32_t row_cnt;
+    uint8_t dirty : 1;
+};
+
+typedef struct _lv_obj_spatial_index_t lv_obj_spatial_index_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool index_build(lv_obj_t * obj, lv_obj_spatial_index_t * idx);
+static void get_child_bounds(lv_obj_t * child, lv_area_t * bounds);
+static void get_cell_range(const lv_obj_spatial_index_t * idx, const lv_area_t * area, lv_area_t * cells);
+static void sort_ids(uint32_t * ids, uint32_t cnt);
+static inline bool areas_overlap(const lv_area_t * a1, const lv_area_t * a2);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_obj_spatial_index_query(lv_obj_t * obj, const lv_area_t * area, const uint32_t ** ids, uint32_t * cnt)
+{
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    if(child_cnt < LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN) {
+        lv_obj_spatial_index_delete(obj);
+        return false;
+    }
+
+    lv_obj_spatial_index_t * idx = obj->spec_attr->spatial_index;
+    if(idx == NULL) {
+        idx = lv_malloc_zeroed(sizeof(lv_obj_spatial_index_t));
+        if(idx == NULL) return false;
+        idx->dirty = 1;
+        obj->spec_attr->spatial_index = idx;
+    }
+
+    if(idx->dirty) {
+        LV_PROFILER_REFR_BEGIN_TAG("spatial_index_build");
+        bool res = index_build(obj, idx);
+        LV_PROFILER_REFR_END_TAG("spatial_index_build");
+        if(!res) {
+            LV_LOG_WARN("couldn't allocate the spatial index");
+            lv_obj_spatial_index_delete(obj);
+            return false;
+        }
+    }
+
+    /*`stamp_act` marks the visited children and `stamp_act + 1` the found ones*/
+    idx->stamp_act += 2;
+    if(idx->stamp_act + 1 < 2) {
+        lv_memzero(idx->stamps, idx->child_cap * sizeof(uint32_t));
+        idx->stamp_act = 2;
+    }
+    const uint32_t visited = idx->stamp_act;
+    const uint32_t found = idx->stamp_act + 1;
+
+    /*The bounds are stored without the offset of the later moves*/
+    lv_area_t q = *area;
+    lv_area_move(&q, -idx->ofs.x, -idx->ofs.y);
+
+    uint32_t res_cnt = 0;
+    uint32_t src_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < idx->large_cnt; i++) {
+        uint32_t id = idx->large[i];
+        if(areas_overlap(&idx->bounds[id], &q)) {
+            idx->stamps[id] = found;
+            idx->result[res_cnt++] = id;
+        }
+    }
+    if(res_cnt) src_cnt++;
+
+    lv_area_t cells;
+    if(idx->col_cnt > 0 && lv_area_intersect(&cells, &q, &idx->grid_area)) {
+        get_cell_range(idx, &cells, &cells);
+        int32_t cx;
+        int32_t cy;
+        for(cy = cells.y1; cy <= cells.y2; cy++) {
+            for(cx = cells.x1; cx <= cells.x2; cx++) {
+                uint32_t c = cy * idx->col_cnt + cx;
+                uint32_t res_cnt_ori = res_cnt;
+                uint32_t k;
+                for(k = idx->cell_start[c]; k < idx->cell_start[c + 1]; k++) {
+                    uint32_t id = idx->items[k];
+                    if(idx->stamps[id] == visited || idx->stamps[id] == found) continue;
+                    if(areas_overlap(&idx->bounds[id], &q)) {
+                        idx->stamps[id] = found;
+                        idx->result[res_cnt++] = id;
+                    }
+                    else {
+                        idx->stamps[id] = visited;
+                    }
+                }
+                if(res_cnt != res_cnt_ori) src_cnt++;
+            }
+        }
+    }
+
+    /*The children are stored in increasing order in each list,
+     *so the result needs sorting only if it's merged from more lists*/
+    if(src_cnt > 1) {
+        if(res_cnt > child_cnt / 8) {
+            /*Many children were found, collecting them in order is cheaper than sorting*/
+            res_cnt = 0;
+            for(i = 0; i < child_cnt; i++) {
+                if(idx->stamps[i] == found) idx->result[res_cnt++] = i;
+            }
+        }
+        else {
+            sort_ids(idx->result, res_cnt);
+        }
+    }
+
+    *ids = idx->result;
+    *cnt = res_cnt;
+    return true;
+}
+
+void lv_obj_spatial_index_mark_dirty(lv_obj_t * obj)
+{
+    if(obj == NULL || obj->spec_attr == NULL || obj->spec_attr->spatial_index == NULL) return;
+
+    /*Don't keep the index if the children can be checked one by one again*/
+    if(obj->spec_attr->child_cnt < LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN) lv_obj_spatial_index_delete(obj);
+    else obj->spec_attr->spatial_index->dirty = 1;
+}
+
+void lv_obj_spatial_index_move(lv_obj_t * obj, int32_t x_ofs, int32_t y_ofs)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->spatial_index == NULL) return;
+    obj->spec_attr->spatial_index->ofs.x += x_ofs;
+    obj->spec_attr->spatial_index->ofs.y += y_ofs;
+}
+
+void lv_obj_spatial_index_delete(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->spatial_index == NULL) return;
+
+    lv_obj_spatial_index_t * idx = obj->spec_attr->spatial_index;
+    lv_free(idx->bounds);
+    lv_free(idx->stamps);
+    lv_free(idx->result);
+    lv_free(idx->large);
+    lv_free(idx->cell_start);
+    lv_free(idx->items);
+    lv_free(idx);
+    obj->spec_attr->spatial_index = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool index_build(lv_obj_t * obj, lv_obj_spatial_index_t * idx)
+{
+    uint32_t child_cnt = obj->spec_attr->child_cnt;
+    lv_obj_t ** children = obj->spec_attr->children;
+    uint32_t i;
+
+    if(child_cnt > idx->child_cap) {
+        lv_free(idx->bounds);
+        lv_free(idx->stamps);
+        lv_free(idx->result);
+        lv_free(idx->large);
+        idx->bounds = lv_malloc(child_cnt * sizeof(lv_area_t));
+        idx->stamps = lv_malloc_zeroed(child_cnt * sizeof(uint32_t));
+        idx->result = lv_malloc(child_cnt * sizeof(uint32_t));
+        idx->large = lv_malloc(child_cnt * sizeof(uint32_t));
+        idx->child_cap = child_cnt;
+        idx->stamp_act = 0;
+        if(idx->bounds == NULL || idx->stamps == NULL || idx->result == NULL || idx->large == NULL) return false;
+    }
+
+    idx->ofs.x = 0;
+    idx->ofs.y = 0;
+    idx->large_cnt = 0;
+
+    /*Collect the bounds and the area they cover*/
+    lv_area_t grid_area;
+    lv_area_set(&grid_area, LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN);
+    uint32_t grid_child_cnt = 0;
+    for(i = 0; i < child_cnt; i++) {
+        lv_area_t * b = &idx->bounds[i];
+        get_child_bounds(children[i], b);
+        if(b->x1 == LV_COORD_MIN) continue;     /*Transformed*/
+        if(b->x1 > b->x2 || b->y1 > b->y2) continue;    /*Empty*/
+
+        grid_area.x1 = LV_MIN(grid_area.x1, b->x1);
+        grid_area.y1 = LV_MIN(grid_area.y1, b->y1);
+        grid_area.x2 = LV_MAX(grid_area.x2, b->x2);
+        grid_area.y2 = LV_MAX(grid_area.y2, b->y2);
+        grid_child_cnt++;
+    }
+
+    idx->col_cnt = 0;
+    idx->row_cnt = 0;
+    idx->grid_area = grid_area;
+    if(grid_child_cnt) {
+        /*Aim for about one child per cell*/
+        int32_t w = lv_area_get_width(&grid_area);
+        int32_t h = lv_area_get_height(&grid_area);
+        uint64_t cell_area = ((uint64_t)w * h) / grid_child_cnt;
+        int32_t cell_size = lv_sqrt32((uint32_t)LV_MIN(cell_area, UINT32_MAX));
+        cell_size = LV_MAX(cell_size, CELL_SIZE_MIN);
+        idx->cell_w = LV_MAX(cell_size, (w + CELL_CNT_MAX - 1) / CELL_CNT_MAX);
+        idx->cell_h = LV_MAX(cell_size, (h + CELL_CNT_MAX - 1) / CELL_CNT_MAX);
+        idx->col_cnt = (w + idx->cell_w - 1) / idx->cell_w;
+        idx->row_cnt = (h + idx->cell_h - 1) / idx->cell_h;
+    }
+
+    uint32_t cell_cnt = idx->col_cnt * idx->row_cnt;
+    if(cell_cnt + 1 > idx->cell_cap) {
+        lv_free(idx->cell_start);
+        idx->cell_start = lv_malloc((cell_cnt + 1) * sizeof(uint32_t));
+        idx->cell_cap = idx->cell_start ? cell_cnt + 1 : 0;
+        if(idx->cell_start == NULL) return false;
+    }
+    lv_memzero(idx->cell_start, (cell_cnt + 1) * sizeof(uint32_t));
+
+    /*Count the items of the cells. The large and transformed children are checked separately.*/
+    for(i = 0; i < child_cnt; i++) {
+        const lv_area_t * b = &idx->bounds[i];
+        if(b->x1 > b->x2 || b->y1 > b->y2) continue;
+
+        if(b->x1 == LV_COORD_MIN) {
+            idx->large[idx->large_cnt++] = i;
+            continue;
+        }
+
+        lv_area_t cells;
+        get_cell_range(idx, b, &cells);
+        if(lv_area_get_size(&cells) > CHILD_CELL_CNT_MAX) {
+            idx->large[idx->large_cnt++] = i;
+            continue;
+        }
+
+        int32_t cx;
+        int32_t cy;
+        for(cy = cells.y1; cy <= cells.y2; cy++) {
+            for(cx = cells.x1; cx <= cells.x2; cx++) {
+                idx->cell_start[cy * idx->col_cnt + cx + 1]++;
+            }
+        }
+    }
+
+    uint32_t c;
+    for(c = 0; c < cell_cnt; c++) {
+        idx->cell_start[c + 1] += idx->cell_start[c];
+    }
+
+    uint32_t item_cnt = idx->cell_start[cell_cnt];
+    if(item_cnt > idx->item_cap) {
+        lv_free(idx->items);
+        idx->items = lv_malloc(item_cnt * sizeof(uint32_t));
+        idx->item_cap = idx->items ? item_cnt : 0;
+        if(idx->items == NULL) return false;
+    }
+
+    /*Fill the cells. `cell_start` is used as a write cursor and restored after.*/
+    uint32_t large_i = 0;
+    for(i = 0; i < child_cnt; i++) {
+        const lv_area_t * b = &idx->bounds[i];
+        if(b->x1 > b->x2 || b->y1 > b->y2) continue;
+        if(large_i < idx->large_cnt && idx->large[large_i] == i) {
+            large_i++;
+            continue;
+        }
+
+        lv_area_t cells;
+        get_cell_range(idx, b, &cells);
+        int32_t cx;
+        int32_t cy;
+        for(cy = cells.y1; cy <= cells.y2; cy++) {
+            for(cx = cells.x1; cx <= cells.x2; cx++) {
+                idx->items[idx->cell_start[cy * idx->col_cnt + cx]++] = i;
+            }
+        }
+    }
+
+    for(c = cell_cnt; c > 0; c--) {
+        idx->cell_start[c] = idx->cell_start[c - 1];
+    }
+    idx->cell_start[0] = 0;
+
+    idx->dirty = 0;
+    return true;
+}
+
+/**
+ * Get the area where a child can be drawn or clicked.
+ * Transformed children can be anywhere, they get `LV_COORD_MIN`..`LV_COORD_MAX`.
+ */
+static void get_child_bounds(lv_obj_t * child, lv_area_t * bounds)
+{
+    if(lv_obj_get_layer_type(child) == LV_LAYER_TYPE_TRANSFORM) {
+        lv_area_set(bounds, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MAX, LV_COORD_MAX);
+        return;
+    }
+
+    int32_t ext = 0;
+    if(child->spec_attr) ext = LV_MAX3(0, child->spec_attr->ext_draw_size, child->spec_attr->ext_click_pad);
+    *bounds = child->coords;
+    lv_area_increase(bounds, ext, ext);
+}
+
+/**
+ * Get the first and last column and row of the cells covered by an area.
+ * The area is clamped to the grid.
+ */
+static void get_cell_range(const lv_obj_spatial_index_t * idx, const lv_area_t * area, lv_area_t * cells)
+{
+    const lv_area_t * g = &idx->grid_area;
+    int32_t x1 = (LV_CLAMP(g->x1, area->x1, g->x2) - g->x1) / idx->cell_w;
+    int32_t y1 = (LV_CLAMP(g->y1, area->y1, g->y2) - g->y1) / idx->cell_h;
+    int32_t x2 = (LV_CLAMP(g->x1, area->x2, g->x2) - g->x1) / idx->cell_w;
+    int32_t y2 = (LV_CLAMP(g->y1, area->y2, g->y2) - g->y1) / idx->cell_h;
+    lv_area_set(cells, x1, y1, x2, y2);
+}
+
+/**
+ * Shell sort, the number of IDs is small compared to the number of children
+ */
+static void sort_ids(uint32_t * ids, uint32_t cnt)
+{
+    uint32_t gap = cnt / 2;
+    while(gap > 0) {
+        uint32_t i;
+        for(i = gap; i < cnt; i++) {
+            uint32_t v = ids[i];
+            uint32_t j = i;
+            while(j >= gap && ids[j - gap] > v) {
+                ids[j] = ids[j - gap];
+                j -= gap;
+            }
+            ids[j] = v;
+        }
+        gap = gap == 2 ? 1 : gap * 5 / 11;
+    }
+}
+
+static inline bool areas_overlap(const lv_area_t * a1, const lv_area_t * a2)
+{
+    return a1->x1 <= a2->x2 && a1->x2 >= a2->x1 && a1->y1 <= a2->y2 && a1->y2 >= a2->y1;
+}
+
+#endif /*LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0*/
@@ -0,0 +1,77 @@
+/**
+ * @file lv_obj_spatial_index_private.h
+ *
+ */
+
+#ifndef LV_OBJ_SPATIAL_INDEX_PRIVATE_H
+#define LV_OBJ_SPATIAL_INDEX_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_obj.h"
+
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the children of an object which can be drawn on or hit in an area.
+ * The index is (re)built here if the children changed since the last query.
+ * @param obj       pointer to an object
+ * @param area      the area to check (e.g. the clip area or a single point)
+ * @param ids       store the indices of the children here in increasing order.
+ *                  It's valid until the next query on `obj`.
+ * @param cnt       store the number of indices here
+ * @return          true: `ids` is set; false: `obj` is not indexed (too few children or out of memory),
+ *                  all the children should be checked
+ */
+bool lv_obj_spatial_index_query(lv_obj_t * obj, const lv_area_t * area, const uint32_t ** ids, uint32_t * cnt);
+
+/**
+ * Mark the spatial index of an object as outdated because a child was added, removed, reordered,
+ * resized or its extended draw or click area has changed.
+ * @param obj       pointer to an object whose children changed (NULL is ignored)
+ */
+void lv_obj_spatial_index_mark_dirty(lv_obj_t * obj);
+
+/**
+ * Shift the spatial index of an object when all its children were moved by the same amount (e.g. on scrolling).
+ * @param obj       pointer to an object
+ * @param x_ofs     the children were moved by this many pixels horizontally
+ * @param y_ofs     the children were moved by this many pixels vertically
+ */
+void lv_obj_spatial_index_move(lv_obj_t * obj, int32_t x_ofs, int32_t y_ofs);
+
+/**
+ * Free the spatial index of an object
+ * @param obj       pointer to an object
+ */
+void lv_obj_spatial_index_delete(lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_SPATIAL_INDEX_PRIVATE_H*/
@@ -7,7 +7,9 @@
  *      INCLUDES
  *********************/
 #include "lv_obj_private.h"
+#include "lv_obj_spatial_index_private.h"
 #include "../misc/lv_anim_private.h"
+#include "../misc/lv_style_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_class_private.h"
 #include "../display/lv_display.h"
@@ -18,11 +20,17 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_STYLE
+
 #define MY_CLASS (&lv_obj_class)
 #define style_refr LV_GLOBAL_DEFAULT()->style_refresh
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
+#define resolved_cache_gen LV_GLOBAL_DEFAULT()->style_resolved_cache_gen
+/*Check this many entries of the resolved property table before evicting one*/
+#define RESOLVED_PROBE_CNT LV_MIN(4, LV_OBJ_STYLE_RESOLVED_CACHE_SIZE)
 
 /**********************
  *      TYPEDEFS
@@ -66,8 +74,13 @@ static void full_cache_refresh(lv_obj_t * obj, lv_part_t part);
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
+static bool is_placement_prop(lv_style_prop_t prop);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    static lv_obj_style_resolved_t * get_resolved_table(lv_obj_t * obj);
+    static uint32_t get_resolved_index(const lv_obj_style_resolved_t * resolved, uint32_t key);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -84,6 +97,10 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 void lv_obj_style_init(void)
 {
     lv_ll_init(style_trans_ll_p, sizeof(trans_t));
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    /*Entries with 0 generation are unused*/
+    resolved_cache_gen = 1;
+#endif
 }
 
 void lv_obj_style_deinit(void)
@@ -135,6 +152,10 @@ void lv_obj_add_style(lv_obj_t * obj, const lv_style_t * style, lv_style_selecto
     obj->styles[i].style = style;
     obj->styles[i].selector = selector;
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    lv_obj_style_resolved_cache_invalidate(obj, true);
+#endif
+
 #if LV_OBJ_STYLE_CACHE
     uint32_t * prop_is_set = part == LV_PART_MAIN ? &obj->style_main_prop_is_set : &obj->style_other_prop_is_set;
     if(lv_style_is_const(style)) {
@@ -194,6 +215,9 @@ bool lv_obj_replace_style(lv_obj_t * obj, const lv_style_t * old_style, const lv
         /*Don't break and continue replacing other occurrences*/
     }
     if(replaced) {
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+        lv_obj_style_resolved_cache_invalidate(obj, true);
+#endif
         full_cache_refresh(obj, part);
         lv_obj_refresh_style(obj, part, LV_STYLE_PROP_ANY);
     }
@@ -247,6 +271,10 @@ void lv_obj_remove_style(lv_obj_t * obj, const lv_style_t * style, lv_style_sele
          *Therefore it doesn't needs to be incremented*/
     }
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    if(deleted) lv_obj_style_resolved_cache_invalidate(obj, true);
+#endif
+
     if(deleted && prop != LV_STYLE_PROP_INV) {
         full_cache_refresh(obj, part);
         lv_obj_refresh_style(obj, part, prop);
@@ -260,6 +288,10 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    lv_obj_style_resolved_cache_invalidate(NULL, true);
+#endif
+
     if(!style_refr) return;
     lv_display_t * d = lv_display_get_next(NULL);
 
@@ -276,12 +308,15 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    lv_obj_style_resolved_cache_invalidate(obj, prop == LV_STYLE_PROP_ANY ||
+                                           lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE));
+#endif
+
     if(!style_refr) return;
 
     LV_PROFILER_STYLE_BEGIN;
 
-    lv_obj_invalidate(obj);
-
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
@@ -289,6 +324,21 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
 
+    /*E.g. the scrollbar's opacity is changed: redraw only the scrollbars*/
+    if(part == LV_PART_SCROLLBAR && prop != LV_STYLE_PROP_ANY && !is_layout_refr && !is_ext_draw) {
+        lv_area_t hor_area, ver_area;
+        lv_obj_get_scrollbar_area(obj, &hor_area, &ver_area);
+        lv_obj_invalidate_area(obj, &hor_area);
+        lv_obj_invalidate_area(obj, &ver_area);
+        LV_PROFILER_STYLE_END;
+        return;
+    }
+
+    /*Transformations only change where the content is drawn, so the cached rendered content can be kept*/
+    bool is_placement = part == LV_PART_MAIN && is_placement_prop(prop);
+    if(is_placement) lv_obj_invalidate_placement(obj);
+    else lv_obj_invalidate(obj);
+
     if(is_layout_refr) {
         if(part == LV_PART_ANY ||
            part == LV_PART_MAIN ||
@@ -311,7 +361,8 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     if(prop == LV_STYLE_PROP_ANY || is_ext_draw) {
         lv_obj_refresh_ext_draw_size(obj);
     }
-    lv_obj_invalidate(obj);
+    if(is_placement) lv_obj_invalidate_placement(obj);
+    else lv_obj_invalidate(obj);
 
     if(prop == LV_STYLE_PROP_ANY || (is_inheritable && (is_ext_draw || is_layout_refr))) {
         if(part != LV_PART_SCROLLBAR) {
@@ -331,16 +382,80 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
 {
     LV_ASSERT_NULL(obj)
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    /*While comparing states the transitions are skipped so the result is not the real value*/
+    lv_obj_style_resolved_t * resolved = obj->skip_trans ? NULL : get_resolved_table((lv_obj_t *)obj);
+    uint32_t key = (uint32_t)prop | ((part >> 16) << 8) | ((uint32_t)obj->state << 12);
+    uint32_t idx = 0;
+    if(resolved) {
+        idx = get_resolved_index(resolved, key);
+        if(resolved->keys[idx] == key) {
+            LV_GLOBAL_DEFAULT()->style_resolved_cache_hit_cnt++;
+            return resolved->values[idx];
+        }
+        LV_GLOBAL_DEFAULT()->style_resolved_cache_miss_cnt++;
+    }
+#endif
+
     lv_style_selector_t selector = part | obj->state;
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
 
-    return lv_style_prop_get_default(prop);
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    if(resolved) {
+        resolved->keys[idx] = key;
+        resolved->values[idx] = value_act;
+    }
+#endif
+
+    return value_act;
 }
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+void lv_obj_style_get_resolved_cache_info(lv_obj_style_resolved_cache_info_t * info)
+{
+    LV_ASSERT_NULL(info);
+
+    info->obj_cnt = LV_GLOBAL_DEFAULT()->style_resolved_cache_obj_cnt;
+    info->mem_size = (size_t)info->obj_cnt * sizeof(lv_obj_style_resolved_t);
+    info->hit_cnt = LV_GLOBAL_DEFAULT()->style_resolved_cache_hit_cnt;
+    info->miss_cnt = LV_GLOBAL_DEFAULT()->style_resolved_cache_miss_cnt;
+}
+
+void lv_obj_style_resolved_cache_invalidate(lv_obj_t * obj, bool children)
+{
+    if(obj == NULL) {
+        resolved_cache_gen++;
+        /*0 marks the unused entries*/
+        if(resolved_cache_gen == 0) resolved_cache_gen = 1;
+        return;
+    }
+
+    /*The global generation is never 0 so the table will be cleared on the next read*/
+    if(obj->style_resolved) obj->style_resolved->gen = 0;
+
+    if(children) {
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_style_resolved_cache_invalidate(obj->spec_attr->children[i], true);
+        }
+    }
+}
+
+void lv_obj_style_resolved_cache_free(lv_obj_t * obj)
+{
+    if(obj->style_resolved == NULL) return;
+
+    lv_free(obj->style_resolved);
+    obj->style_resolved = NULL;
+    LV_GLOBAL_DEFAULT()->style_resolved_cache_obj_cnt--;
+}
+#endif
+
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
 {
     LV_ASSERT_NULL(obj)
@@ -364,10 +479,11 @@ void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_
 
     lv_style_t * style = get_local_style(obj, selector);
     if(selector == LV_PART_MAIN && lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_TRANSFORM)) {
-        lv_obj_invalidate(obj);
+        if(is_placement_prop(prop)) lv_obj_invalidate_placement(obj);
+        else lv_obj_invalidate(obj);
     }
 
-    lv_style_set_prop(style, prop, value);
+    lv_style_set_prop_no_invalidate(style, prop, value);
 
 #if LV_OBJ_STYLE_CACHE
     uint32_t prop_shifted = STYLE_PROP_SHIFTED(prop);
@@ -441,7 +557,7 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
     obj->state = new_state;
 
     lv_obj_style_t * style_trans = get_trans_style(obj, part);
-    lv_style_set_prop((lv_style_t *)style_trans->style, tr_dsc->prop, v1);  /*Be sure `trans_style` has a valid value*/
+    lv_style_set_prop_no_invalidate((lv_style_t *)style_trans->style, tr_dsc->prop, v1);  /*Be sure `trans_style` has a valid value*/
     lv_obj_refresh_style(obj, tr_dsc->selector, tr_dsc->prop);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
@@ -639,6 +755,13 @@ lv_opa_t lv_obj_get_style_opa_recursive(const lv_obj_t * obj, lv_part_t part)
 void lv_obj_update_layer_type(lv_obj_t * obj)
 {
     lv_layer_type_t layer_type = calculate_layer_type(obj);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    /*Transformed children are not placed in the grid of the parent*/
+    bool was_transformed = obj->spec_attr && obj->spec_attr->layer_type == LV_LAYER_TYPE_TRANSFORM;
+    if(was_transformed != (layer_type == LV_LAYER_TYPE_TRANSFORM)) {
+        lv_obj_spatial_index_mark_dirty(lv_obj_get_parent(obj));
+    }
+#endif
     if(obj->spec_attr) obj->spec_attr->layer_type = layer_type;
     else if(layer_type != LV_LAYER_TYPE_NONE) {
         lv_obj_allocate_spec_attr(obj);
@@ -951,7 +1074,7 @@ static void trans_anim_cb(void * _tr, int32_t v)
                 refr = false;
             }
         }
-        lv_style_set_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
+        lv_style_set_prop_no_invalidate((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
         if(refr) lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
         break;
 
@@ -977,7 +1100,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     /*Be sure `trans_style` has a valid value*/
-    lv_style_set_prop((lv_style_t *)style_trans->style, tr->prop, tr->start_value);
+    lv_style_set_prop_no_invalidate((lv_style_t *)style_trans->style, tr->prop, tr->start_value);
     lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
 
 }
@@ -1119,6 +1242,33 @@ static bool style_has_flag(const lv_style_t * style, uint32_t flag)
     return false;
 }
 
+/**
+ * Check if a property changes only where and how the rendered content of an object is placed
+ * (position, transformation, translation and layered opacity) but not the content itself.
+ * Note that the transform width/height are not such as they change the drawn size.
+ */
+static bool is_placement_prop(lv_style_prop_t prop)
+{
+    switch(prop) {
+        case LV_STYLE_X:
+        case LV_STYLE_Y:
+        case LV_STYLE_ALIGN:
+        case LV_STYLE_TRANSFORM_SCALE_X:
+        case LV_STYLE_TRANSFORM_SCALE_Y:
+        case LV_STYLE_TRANSFORM_ROTATION:
+        case LV_STYLE_TRANSFORM_SKEW_X:
+        case LV_STYLE_TRANSFORM_SKEW_Y:
+        case LV_STYLE_TRANSFORM_PIVOT_X:
+        case LV_STYLE_TRANSFORM_PIVOT_Y:
+        case LV_STYLE_TRANSLATE_X:
+        case LV_STYLE_TRANSLATE_Y:
+        case LV_STYLE_OPA_LAYERED:
+            return true;
+        default:
+            return false;
+    }
+}
+
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act)
 {
@@ -1190,3 +1340,51 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+/**
+ * Get the resolved style property table of an object. It's allocated on the first call
+ * and cleared if it was invalidated since the last call.
+ * @param obj       pointer to an object
+ * @return          pointer to the table or NULL if it couldn't be allocated
+ */
+static lv_obj_style_resolved_t * get_resolved_table(lv_obj_t * obj)
+{
+    lv_obj_style_resolved_t * resolved = obj->style_resolved;
+    if(resolved == NULL) {
+        resolved = lv_malloc(sizeof(lv_obj_style_resolved_t));
+        if(resolved == NULL) return NULL;
+        resolved->gen = 0;
+        obj->style_resolved = resolved;
+        LV_GLOBAL_DEFAULT()->style_resolved_cache_obj_cnt++;
+    }
+
+    if(resolved->gen != resolved_cache_gen) {
+        lv_memzero(resolved->keys, sizeof(resolved->keys));
+        resolved->gen = resolved_cache_gen;
+    }
+
+    return resolved;
+}
+
+/**
+ * Find the index of a key in a resolved style property table
+ * @param resolved  pointer to a resolved style property table
+ * @param key       the key to find
+ * @return          index of `key`; if not found the index of a free or evictable entry
+ */
+static uint32_t get_resolved_index(const lv_obj_style_resolved_t * resolved, uint32_t key)
+{
+    /*Properties of the same group have consecutive IDs and are often read together,
+     *so scatter them to reduce the collisions*/
+    uint32_t home = ((key * 0x9E3779B1U) >> 16) & (LV_OBJ_STYLE_RESOLVED_CACHE_SIZE - 1);
+    uint32_t i;
+    for(i = 0; i < RESOLVED_PROBE_CNT; i++) {
+        uint32_t idx = (home + i) & (LV_OBJ_STYLE_RESOLVED_CACHE_SIZE - 1);
+        if(resolved->keys[idx] == key || resolved->keys[idx] == 0) return idx;
+    }
+
+    /*All the checked entries are used by other properties. Replace the first one*/
+    return home;
+}
+#endif
@@ -34,6 +34,15 @@ typedef enum {
 
 typedef uint32_t lv_style_selector_t;
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+typedef struct {
+    uint32_t obj_cnt;       /**< Number of objects having a resolved style property table */
+    size_t mem_size;        /**< Memory used by the tables in bytes */
+    uint32_t hit_cnt;       /**< Property reads served from the tables */
+    uint32_t miss_cnt;      /**< Property reads which needed to walk the styles */
+} lv_obj_style_resolved_cache_info_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -129,6 +138,14 @@ void lv_obj_enable_style_refresh(bool en);
  */
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+/**
+ * Get the memory usage and the efficiency of the resolved style property tables.
+ * @param info      store the result here
+ */
+void lv_obj_style_get_resolved_cache_info(lv_obj_style_resolved_cache_info_t * info);
+#endif
+
 /**
  * Check if an object has a specified style property for a given style selector.
  * @param obj       pointer to an object
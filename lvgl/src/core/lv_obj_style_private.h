@@ -40,6 +40,19 @@ struct _lv_obj_style_transition_dsc_t {
     void * user_data;
 };
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+#if (LV_OBJ_STYLE_RESOLVED_CACHE_SIZE & (LV_OBJ_STYLE_RESOLVED_CACHE_SIZE - 1)) != 0
+#error "LV_OBJ_STYLE_RESOLVED_CACHE_SIZE must be a power of 2"
+#endif
+
+/** The resolved style properties of an object */
+typedef struct _lv_obj_style_resolved_t {
+    uint32_t gen;                                           /**< The cache generation the entries are valid for*/
+    uint32_t keys[LV_OBJ_STYLE_RESOLVED_CACHE_SIZE];        /**< Property, part and state of the entries. 0: unused*/
+    lv_style_value_t values[LV_OBJ_STYLE_RESOLVED_CACHE_SIZE];  /**< The results of `lv_obj_get_style_prop()`*/
+} lv_obj_style_resolved_t;
+#endif
+
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -84,6 +97,22 @@ lv_style_state_cmp_t lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t state
  */
 void lv_obj_update_layer_type(lv_obj_t * obj);
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+/**
+ * Mark the resolved style properties of an object as outdated.
+ * Needs to be called when something changes the result of `lv_obj_get_style_prop()`.
+ * @param obj       pointer to an object, or NULL to invalidate all objects
+ * @param children  true: invalidate the descendants of `obj` too (e.g. they inherit a changed property)
+ */
+void lv_obj_style_resolved_cache_invalidate(lv_obj_t * obj, bool children);
+
+/**
+ * Free the resolved style property table of an object
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_resolved_cache_free(lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -7,7 +7,9 @@
  *      INCLUDES
  *********************/
 #include "lv_obj_private.h"
+#include "lv_obj_spatial_index_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_style_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
 #include "../display/lv_display.h"
@@ -19,6 +21,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_obj_class)
 #define disp_ll_p &(LV_GLOBAL_DEFAULT()->disp_ll)
 
@@ -190,6 +195,14 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children[lv_obj_get_child_count(parent) - 1] = obj;
 
     obj->parent = parent;
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    lv_obj_spatial_index_mark_dirty(old_parent);
+    lv_obj_spatial_index_mark_dirty(parent);
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    /*Inherited properties come from the new parent*/
+    lv_obj_style_resolved_cache_invalidate(obj, true);
+#endif
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
@@ -250,6 +263,9 @@ void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
     }
 
     parent->spec_attr->children[index] = obj;
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    lv_obj_spatial_index_mark_dirty(parent);
+#endif
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, NULL);
     lv_obj_invalidate(parent);
 }
@@ -273,6 +289,14 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent2->spec_attr->children[index2] = obj1;
     obj1->parent = parent2;
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    lv_obj_spatial_index_mark_dirty(parent);
+    lv_obj_spatial_index_mark_dirty(parent2);
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    lv_obj_style_resolved_cache_invalidate(obj1, true);
+    lv_obj_style_resolved_cache_invalidate(obj2, true);
+#endif
 
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_obj_send_event(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -698,8 +722,15 @@ static void obj_delete_core(lv_obj_t * obj)
         obj->parent->spec_attr->child_cnt--;
         obj->parent->spec_attr->children = lv_realloc(obj->parent->spec_attr->children,
                                                       obj->parent->spec_attr->child_cnt * sizeof(lv_obj_t *));
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+        lv_obj_spatial_index_mark_dirty(obj->parent);
+#endif
     }
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    lv_obj_style_resolved_cache_free(obj);
+#endif
+
     /*Free the object itself*/
     lv_free(obj);
 }
@@ -9,9 +9,10 @@
 #include "lv_refr_private.h"
 #include "lv_obj_draw_private.h"
 #include "../misc/lv_area_private.h"
-#include "../draw/sw/lv_draw_sw_mask_private.h"
+#include "../misc/lv_array.h"
 #include "../draw/lv_draw_mask_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_spatial_index_private.h"
 #include "lv_obj_event_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
@@ -23,6 +24,7 @@
 #include "../draw/lv_draw_private.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_cache.h"
 #include "lv_global.h"
 
 /*********************
@@ -32,25 +34,67 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+#define render_cache_p LV_GLOBAL_DEFAULT()->obj_render_cache
+#define render_cache_used_p (&LV_GLOBAL_DEFAULT()->obj_render_cache_used)
+
+#define occluders_p (&LV_GLOBAL_DEFAULT()->refr_occluders)
+#define area_occluders_p (&LV_GLOBAL_DEFAULT()->refr_area_occluders)
+#define occlusion_layer LV_GLOBAL_DEFAULT()->refr_occlusion_layer
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+typedef struct {
+    lv_cache_slot_size_t slot;
+    const lv_obj_t * obj;       /**< The key*/
+    lv_draw_buf_t * buf;        /**< The rendered content of the object and its children*/
+    lv_opa_t opa;               /**< The inherited opacity the content was rendered with*/
+    lv_color32_t recolor;       /**< The inherited recolor the content was rendered with*/
+} render_cache_data_t;
+#endif
+
+#if LV_USE_OCCLUSION_CULLING
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;             /**< The Widget fully covers this area*/
+} occluder_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
+static void refr_move_area(const lv_area_t * area_p, const lv_point_t * ofs);
 static void refr_area(const lv_area_t * area_p, int32_t y_offset);
 static void refr_configured_layer(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
+static void refr_obj_children(lv_layer_t * layer, lv_obj_t * obj, uint32_t start_id);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    static bool refr_obj_from_cache(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa_layered);
+    static lv_cache_entry_t * render_cache_get(lv_layer_t * layer, lv_obj_t * obj, const lv_area_t * area, bool * hit);
+    static void render_cache_release_all(void);
+    static bool render_cache_create_cb(render_cache_data_t * data, void * user_data);
+    static void render_cache_free_cb(render_cache_data_t * data, void * user_data);
+    static lv_cache_compare_res_t render_cache_compare_cb(const render_cache_data_t * lhs, const render_cache_data_t * rhs);
+#endif
+#if LV_USE_OCCLUSION_CULLING
+    static void occluders_collect(void);
+    static void occluders_collect_obj(lv_obj_t * obj, const lv_area_t * clip_area);
+    static void occluders_filter(const lv_area_t * area);
+    static bool refr_obj_cull(lv_layer_t * layer, lv_obj_t * obj);
+    static bool obj_is_drawn_above(const lv_obj_t * obj_above, const lv_obj_t * obj);
+    static uint32_t get_root_order(const lv_obj_t * root);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -74,10 +118,38 @@ static void wait_for_flushing(lv_display_t * disp);
  */
 void lv_refr_init(void)
 {
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    const lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)render_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)render_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)render_cache_free_cb,
+    };
+
+    render_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(render_cache_data_t),
+                                   LV_OBJ_RENDER_CACHE_SIZE, ops);
+    lv_cache_set_name(render_cache_p, "OBJ_RENDER");
+    lv_array_init(render_cache_used_p, 8, sizeof(lv_cache_entry_t *));
+#endif
+#if LV_USE_OCCLUSION_CULLING
+    lv_array_init(occluders_p, 16, sizeof(occluder_t));
+    lv_array_init(area_occluders_p, 16, sizeof(occluder_t));
+#endif
 }
 
 void lv_refr_deinit(void)
 {
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    if(render_cache_p) {
+        render_cache_release_all();
+        lv_array_deinit(render_cache_used_p);
+        lv_cache_destroy(render_cache_p, NULL);
+        render_cache_p = NULL;
+    }
+#endif
+#if LV_USE_OCCLUSION_CULLING
+    lv_array_deinit(occluders_p);
+    lv_array_deinit(area_occluders_p);
+#endif
 }
 
 void lv_refr_now(lv_display_t * disp)
@@ -145,7 +217,6 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     }
 
     if(refr_children) {
-        uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_count(obj);
         if(child_cnt == 0) {
             /*If the object was visible on the clip area call the post draw events too*/
@@ -166,10 +237,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
             }
 
             if(clip_corner == false) {
-                for(i = 0; i < child_cnt; i++) {
-                    lv_obj_t * child = obj->spec_attr->children[i];
-                    refr_obj(layer, child);
-                }
+                refr_obj_children(layer, obj, 0);
 
                 /*If the object was visible on the clip area call the post draw events too*/
                 layer->_clip_area = clip_coords_for_obj;
@@ -196,10 +264,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 if(lv_area_intersect(&bottom, &bottom, &clip_area_ori)) {
                     layer_children = lv_draw_layer_create(layer, LV_COLOR_FORMAT_ARGB8888, &bottom);
 
-                    for(i = 0; i < child_cnt; i++) {
-                        lv_obj_t * child = obj->spec_attr->children[i];
-                        refr_obj(layer_children, child);
-                    }
+                    refr_obj_children(layer_children, obj, 0);
 
                     /*If all the children are redrawn send 'post draw' draw*/
                     lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
@@ -217,10 +282,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 if(lv_area_intersect(&top, &top, &clip_area_ori)) {
                     layer_children = lv_draw_layer_create(layer, LV_COLOR_FORMAT_ARGB8888, &top);
 
-                    for(i = 0; i < child_cnt; i++) {
-                        lv_obj_t * child = obj->spec_attr->children[i];
-                        refr_obj(layer_children, child);
-                    }
+                    refr_obj_children(layer_children, obj, 0);
 
                     /*If all the children are redrawn send 'post draw' draw*/
                     lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
@@ -239,10 +301,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 mid.y2 -= rout;
                 if(lv_area_intersect(&mid, &mid, &clip_area_ori)) {
                     layer->_clip_area = mid;
-                    for(i = 0; i < child_cnt; i++) {
-                        lv_obj_t * child = obj->spec_attr->children[i];
-                        refr_obj(layer, child);
-                    }
+                    refr_obj_children(layer, obj, 0);
 
                     /*If all the children are redrawn make 'post draw' draw*/
                     lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
@@ -281,6 +340,7 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+        disp->move_p = 0;
         return;
     }
 
@@ -332,10 +392,134 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+bool lv_inv_area_move(lv_display_t * disp, const lv_area_t * area_p, int32_t x_ofs, int32_t y_ofs)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return false;
+    if(!lv_display_is_invalidation_enabled(disp)) return false;
+
+    /*Only in direct mode is the content of the whole screen kept in the buffer*/
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(lv_display_get_rotation(disp) != LV_DISPLAY_ROTATION_0) return false;
+    if(lv_color_format_get_bpp(disp->color_format) < 8) return false;
+
+    LV_ASSERT_MSG(!disp->rendering_in_progress, "Invalidate area is not allowed during rendering.");
+
+    if(x_ofs == 0 && y_ofs == 0) return true;
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_display_get_horizontal_resolution(disp) - 1;
+    scr_area.y2 = lv_display_get_vertical_resolution(disp) - 1;
+
+    lv_area_t move_area;
+    if(!lv_area_intersect(&move_area, area_p, &scr_area)) return true; /*Out of the screen*/
+
+    /*The content of the area which remains visible after the move*/
+    lv_area_t dest_area = move_area;
+    lv_area_move(&dest_area, x_ofs, y_ofs);
+    if(!lv_area_intersect(&dest_area, &dest_area, &move_area)) return false;
+
+    /*Don't bother if the area will be redrawn anyway*/
+    uint32_t inv_p = disp->inv_p;
+    uint32_t i;
+    for(i = 0; i < inv_p; i++) {
+        if(lv_area_is_in(&move_area, &disp->inv_areas[i], 0)) return false;
+    }
+
+    /*Multiple moves of the same area (e.g. continuous scrolling) can be combined*/
+    bool merge = disp->move_p > 0 && lv_area_is_equal(&disp->move_areas[disp->move_p - 1], &move_area);
+    if(!merge && disp->move_p >= LV_INV_MOVE_BUF_SIZE) return false;
+
+    /*The moved content will be flushed as it is, so the driver can't modify the area*/
+    lv_area_t flush_area = dest_area;
+    lv_result_t res = lv_display_send_event(disp, LV_EVENT_INVALIDATE_AREA, &flush_area);
+    if(res != LV_RESULT_OK || !lv_area_is_equal(&flush_area, &dest_area)) return false;
+
+    /*The already invalidated areas will be redrawn after the move,
+     *so invalidate where their content is moved too*/
+    for(i = 0; i < inv_p; i++) {
+        lv_area_t a;
+        if(!lv_area_intersect(&a, &disp->inv_areas[i], &move_area)) continue;
+        lv_area_move(&a, x_ofs, y_ofs);
+        if(lv_area_intersect(&a, &a, &move_area)) lv_inv_area(disp, &a);
+    }
+
+    /*Invalidate the uncovered parts*/
+    lv_area_t uncovered = move_area;
+    if(x_ofs > 0) uncovered.x2 = dest_area.x1 - 1;
+    else if(x_ofs < 0) uncovered.x1 = dest_area.x2 + 1;
+    if(x_ofs != 0) lv_inv_area(disp, &uncovered);
+
+    uncovered = move_area;
+    if(y_ofs > 0) uncovered.y2 = dest_area.y1 - 1;
+    else if(y_ofs < 0) uncovered.y1 = dest_area.y2 + 1;
+    if(y_ofs != 0) lv_inv_area(disp, &uncovered);
+
+    if(merge) {
+        disp->move_ofs[disp->move_p - 1].x += x_ofs;
+        disp->move_ofs[disp->move_p - 1].y += y_ofs;
+    }
+    else {
+        disp->move_areas[disp->move_p] = move_area;
+        disp->move_ofs[disp->move_p].x = x_ofs;
+        disp->move_ofs[disp->move_p].y = y_ofs;
+        disp->move_p++;
+    }
+
+    return true;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
  */
+void lv_refr_render_cache_invalidate(const lv_obj_t * obj)
+{
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    if(render_cache_p == NULL) return;
+
+    render_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+
+    /*The cached content of the parents contains this object too*/
+    while(obj) {
+        if(obj->spec_attr && obj->spec_attr->render_cache) {
+            search_key.obj = obj;
+            lv_cache_drop(render_cache_p, &search_key, NULL);
+        }
+        obj = obj->parent;
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
+#if LV_USE_OCCLUSION_CULLING
+
+void lv_refr_get_occlusion_stats(lv_display_t * disp, lv_refr_occlusion_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) {
+        lv_memzero(stats, sizeof(*stats));
+        return;
+    }
+
+    *stats = disp->occlusion_stats;
+}
+
+void lv_refr_reset_occlusion_stats(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_memzero(&disp->occlusion_stats, sizeof(disp->occlusion_stats));
+}
+
+#endif /*LV_USE_OCCLUSION_CULLING*/
+
 lv_display_t * lv_refr_get_disp_refreshing(void)
 {
     return disp_refr;
@@ -396,13 +580,23 @@ void lv_display_refr_timer(lv_timer_t * tmr)
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+        disp_refr->move_p = 0;
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
     lv_refr_join_area();
     refr_sync_areas();
+#if LV_USE_PERF_MONITOR
+    lv_sysmon_input_latency_frame_start(disp_refr, disp_refr->inv_p > 0);
+#endif
+#if LV_USE_OVERDRAW_DEBUG
+    if(disp_refr->inv_p > 0) lv_refr_overdraw_frame_start(disp_refr);
+#endif
     refr_invalid_areas();
+#if LV_USE_OVERDRAW_DEBUG
+    lv_refr_overdraw_frame_end(disp_refr);
+#endif
 
     if(disp_refr->inv_p == 0) goto refr_finish;
     /*In double buffered direct mode save the updated areas.
@@ -416,16 +610,24 @@ void lv_display_refr_timer(lv_timer_t * tmr)
             lv_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
             *sync_area = disp_refr->inv_areas[i];
         }
+
+        /*The moved areas have been changed too*/
+        for(i = 0; i < disp_refr->move_p; i++) {
+            lv_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
+            *sync_area = disp_refr->move_areas[i];
+        }
     }
 
     lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
     lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
     disp_refr->inv_p = 0;
+    disp_refr->move_p = 0;
 
 refr_finish:
 
-#if LV_DRAW_SW_COMPLEX == 1
-    lv_draw_sw_mask_cleanup();
+#if LV_USE_MEM_TAGS && LV_USE_PROFILER
+    /*Put the memory usage next to the frames in the trace*/
+    lv_mem_tag_trace();
 #endif
 
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
@@ -504,13 +706,15 @@ static void refr_sync_areas(void)
     uint32_t hor_res = lv_display_get_horizontal_resolution(disp_refr);
     uint32_t ver_res = lv_display_get_vertical_resolution(disp_refr);
 
-    /*Iterate through invalidated areas to see if sync area should be copied*/
+    /*Iterate through invalidated areas to see if sync area should be copied.
+     *If some content will be moved all the sync areas are needed as the moved content can come from anywhere.*/
     uint16_t i;
     int8_t j;
     lv_area_t res[4] = {0};
     int8_t res_c;
     lv_area_t * sync_area, * new_area, * next_area;
-    for(i = 0; i < disp_refr->inv_p; i++) {
+    uint16_t inv_p = disp_refr->move_p == 0 ? disp_refr->inv_p : 0;
+    for(i = 0; i < inv_p; i++) {
         /*Skip joined areas*/
         if(disp_refr->inv_area_joined[i]) continue;
 
@@ -585,6 +789,15 @@ static void refr_invalid_areas(void)
     disp_refr->last_part = 0;
     disp_refr->rendering_in_progress = true;
 
+    /*Move the content first as the invalidated areas are already in the coordinates after the move*/
+    for(i = 0; i < (int32_t)disp_refr->move_p; i++) {
+        refr_move_area(&disp_refr->move_areas[i], &disp_refr->move_ofs[i]);
+    }
+
+#if LV_USE_OCCLUSION_CULLING
+    occluders_collect();
+#endif
+
     for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
         if(disp_refr->inv_area_joined[i]) continue;
@@ -637,11 +850,64 @@ static void refr_invalid_areas(void)
         }
     }
 
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    /*All the draw tasks are ready, the drawn cache entries are not used anymore*/
+    render_cache_release_all();
+#endif
+
     lv_display_send_event(disp_refr, LV_EVENT_RENDER_READY, NULL);
     disp_refr->rendering_in_progress = false;
     LV_PROFILER_REFR_END;
 }
 
+/**
+ * Move the content of an area in the display's buffer and flush the changed part
+ * @param area_p    the area whose content should be moved. The content is clipped to this area.
+ * @param ofs       move the content by this vector
+ */
+static void refr_move_area(const lv_area_t * area_p, const lv_point_t * ofs)
+{
+    lv_area_t dest_area = *area_p;
+    lv_area_move(&dest_area, ofs->x, ofs->y);
+    if(!lv_area_intersect(&dest_area, &dest_area, area_p)) return;
+
+    LV_PROFILER_REFR_BEGIN;
+
+    /*In single buffered mode the buffer can be modified only when it's not being transferred*/
+    if(!lv_display_is_double_buffered(disp_refr)) {
+        wait_for_flushing(disp_refr);
+    }
+
+    lv_draw_buf_t * buf = disp_refr->buf_act;
+    int32_t stride = buf->header.stride;
+    uint32_t line_size = lv_area_get_width(&dest_area) * lv_color_format_get_size(disp_refr->color_format);
+    int32_t h = lv_area_get_height(&dest_area);
+    uint8_t * dest_buf = lv_draw_buf_goto_xy(buf, dest_area.x1, dest_area.y1);
+    uint8_t * src_buf = lv_draw_buf_goto_xy(buf, dest_area.x1 - ofs->x, dest_area.y1 - ofs->y);
+
+    /*When moving down start from the last line to not overwrite the lines which are not moved yet*/
+    if(ofs->y > 0) {
+        dest_buf += (h - 1) * stride;
+        src_buf += (h - 1) * stride;
+        stride = -stride;
+    }
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        lv_memmove(dest_buf, src_buf, line_size);
+        dest_buf += stride;
+        src_buf += stride;
+    }
+
+    /*The real invalidated areas are flushed after this, so it can't be the last one*/
+    disp_refr->last_area = 0;
+    disp_refr->last_part = 1;
+    disp_refr->refreshed_area = dest_area;
+    draw_buf_flush(disp_refr);
+
+    LV_PROFILER_REFR_END;
+}
+
 /**
  * Reshape the draw buffer if required
  * @param layer  pointer to a layer which will be drawn
@@ -810,6 +1076,12 @@ static void refr_configured_layer(lv_layer_t * layer)
         lv_draw_buf_clear(layer->draw_buf, &clear_area);
     }
 
+#if LV_USE_OCCLUSION_CULLING
+    occluders_filter(&layer->_clip_area);
+    occlusion_layer = layer;
+    disp_refr->occlusion_stats.rendered_px += lv_area_get_size(&layer->_clip_area);
+#endif
+
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -849,6 +1121,10 @@ static void refr_configured_layer(lv_layer_t * layer)
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
 
+#if LV_USE_OCCLUSION_CULLING
+    occlusion_layer = NULL;
+#endif
+
     LV_PROFILER_REFR_END;
 }
 
@@ -876,6 +1152,21 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 
     int32_t i;
     int32_t child_cnt = lv_obj_get_child_count(obj);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    /*A child covering the area has to be on its top left corner*/
+    const uint32_t * ids;
+    uint32_t id_cnt;
+    lv_area_t corner;
+    lv_area_set(&corner, area_p->x1, area_p->y1, area_p->x1, area_p->y1);
+    if(child_cnt >= LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN &&
+       lv_obj_spatial_index_query(obj, &corner, &ids, &id_cnt)) {
+        for(i = id_cnt - 1; i >= 0; i--) {
+            found_p = lv_refr_get_top_obj(area_p, obj->spec_attr->children[ids[i]]);
+            if(found_p != NULL) break;
+        }
+        child_cnt = 0;
+    }
+#endif
     for(i = child_cnt - 1; i >= 0; i--) {
         lv_obj_t * child = obj->spec_attr->children[i];
         found_p = lv_refr_get_top_obj(area_p, child);
@@ -924,19 +1215,7 @@ static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj)
 
     /*Do until not reach the screen*/
     while(parent != NULL) {
-        bool go = false;
-        uint32_t i;
-        uint32_t child_cnt = lv_obj_get_child_count(parent);
-        for(i = 0; i < child_cnt; i++) {
-            lv_obj_t * child = parent->spec_attr->children[i];
-            if(!go) {
-                if(child == border_p) go = true;
-            }
-            else {
-                /*Refresh the objects*/
-                refr_obj(layer, child);
-            }
-        }
+        refr_obj_children(layer, parent, lv_obj_get_index(border_p) + 1);
 
         /*Call the post draw function of the parents of the to object*/
         lv_obj_send_event(parent, LV_EVENT_DRAW_POST_BEGIN, (void *)layer);
@@ -1100,9 +1379,19 @@ static void refr_obj_matrix(lv_layer_t * layer, lv_obj_t * obj)
 
     layer->_clip_area = clip_area;
 
+#if LV_USE_OCCLUSION_CULLING
+    /* the children are not drawn at their coordinates, don't cull them */
+    lv_layer_t * occlusion_layer_ori = occlusion_layer;
+    occlusion_layer = NULL;
+#endif
+
     /* redraw obj */
     lv_obj_redraw(layer, obj);
 
+#if LV_USE_OCCLUSION_CULLING
+    occlusion_layer = occlusion_layer_ori;
+#endif
+
     /* restore original matrix */
     layer->matrix = ori_matrix;
     /* restore clip area */
@@ -1135,10 +1424,43 @@ static bool refr_check_obj_clip_overflow(lv_layer_t * layer, lv_obj_t * obj)
 
 #endif /* LV_DRAW_TRANSFORM_USE_MATRIX */
 
+/**
+ * Draw the children of an object on the clip area of a layer
+ * @param layer     the layer to draw to
+ * @param obj       the parent of the children
+ * @param start_id  draw the children from this index (the ones before are covered by the top object)
+ */
+static void refr_obj_children(lv_layer_t * layer, lv_obj_t * obj, uint32_t start_id)
+{
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    /*Draw only the children on the clip area if they are indexed*/
+    const uint32_t * ids;
+    uint32_t id_cnt;
+    if(child_cnt >= LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN &&
+       lv_obj_spatial_index_query(obj, &layer->_clip_area, &ids, &id_cnt)) {
+        for(i = 0; i < id_cnt; i++) {
+            if(ids[i] >= start_id) refr_obj(layer, obj->spec_attr->children[ids[i]]);
+        }
+        return;
+    }
+#endif
+
+    for(i = start_id; i < child_cnt; i++) {
+        refr_obj(layer, obj->spec_attr->children[i]);
+    }
+}
+
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
+#if LV_USE_OCCLUSION_CULLING
+    const lv_area_t clip_area_ori = layer->_clip_area;
+    if(!refr_obj_cull(layer, obj)) return;
+#endif
+
     /*If `opa_layered != LV_OPA_COVER` draw the widget on a new layer and blend that layer with the given opacity.*/
     const lv_opa_t opa_layered = lv_obj_get_style_opa_layered(obj, LV_PART_MAIN);
     if(opa_layered < LV_OPA_MIN) return;
@@ -1154,8 +1476,17 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 
     layer->recolor = lv_obj_style_apply_recolor(obj, LV_PART_MAIN, layer->recolor);
 
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+    bool cached = obj->spec_attr && obj->spec_attr->render_cache && refr_obj_from_cache(layer, obj, opa_layered);
+#else
+    bool cached = false;
+#endif
+
     lv_layer_type_t layer_type = lv_obj_get_layer_type(obj);
-    if(layer_type == LV_LAYER_TYPE_NONE) {
+    if(cached) {
+        /*Already drawn from the render cache*/
+    }
+    else if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(layer, obj);
     }
 #if LV_DRAW_TRANSFORM_USE_MATRIX
@@ -1168,7 +1499,14 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
         lv_area_t layer_area_full;
         lv_area_t obj_draw_size;
         lv_result_t res = layer_get_area(layer, obj, layer_type, &layer_area_full, &obj_draw_size);
-        if(res != LV_RESULT_OK) return;
+        if(res != LV_RESULT_OK) {
+            layer->opa = layer_opa_ori;
+            layer->recolor = layer_recolor;
+#if LV_USE_OCCLUSION_CULLING
+            layer->_clip_area = clip_area_ori;
+#endif
+            return;
+        }
 
         /*Simple layers can be subdivided into smaller layers*/
         uint32_t max_rgb_row_height = lv_area_get_height(&layer_area_full);
@@ -1244,6 +1582,9 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     /* Restore the original layer opa and recolor */
     layer->opa = layer_opa_ori;
     layer->recolor = layer_recolor;
+#if LV_USE_OCCLUSION_CULLING
+    layer->_clip_area = clip_area_ori;
+#endif
 }
 
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
@@ -1304,6 +1645,10 @@ static void draw_buf_flush(lv_display_t * disp)
         lv_draw_dispatch();
     }
 
+#if LV_USE_OVERDRAW_DEBUG
+    lv_refr_overdraw_draw_heatmap(disp, layer);
+#endif
+
     /* In double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer.
      * If we need to wait here it means that the content of one buffer is being sent to display
@@ -1319,6 +1664,10 @@ static void draw_buf_flush(lv_display_t * disp)
 
     bool flushing_last = disp->flushing_last;
 
+#if LV_USE_PERF_MONITOR
+    if(flushing_last) lv_sysmon_input_latency_flush_start(disp);
+#endif
+
     if(disp->flush_cb) {
         call_flush_cb(disp, &disp->refreshed_area, layer->draw_buf->data);
     }
@@ -1375,6 +1724,9 @@ static void wait_for_flushing(lv_display_t * disp)
     else {
         while(disp->flushing);
     }
+#if LV_USE_PERF_MONITOR
+    if(disp->flushing_last) lv_sysmon_input_latency_flush_ready(disp);
+#endif
     disp->flushing_last = 0;
 
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_FINISH, NULL);
@@ -1382,3 +1734,446 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("end");
     LV_PROFILER_REFR_END;
 }
+
+#if LV_OBJ_RENDER_CACHE_SIZE > 0
+
+/**
+ * Draw an object and its children from its render cache.
+ * If the content is not cached yet or it's outdated, render it into the cache first.
+ * @param layer         the layer to draw to
+ * @param obj           pointer to an object with render cache
+ * @param opa_layered   the layered opacity of the object
+ * @return              true: the object is drawn; false: it's not possible, draw it as usual
+ */
+static bool refr_obj_from_cache(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa_layered)
+{
+    /*The bitmap mask is supported only when drawing layers*/
+    if(lv_obj_get_style_bitmap_mask_src(obj, 0)) return false;
+
+    lv_area_t obj_draw_size;
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &obj_draw_size);
+    lv_area_increase(&obj_draw_size, ext_draw_size, ext_draw_size);
+
+    /*Nothing to draw if it's out of the clip area*/
+    lv_area_t tranf_coords = obj_draw_size;
+    lv_obj_get_transformed_area(obj, &tranf_coords, LV_OBJ_POINT_TRANSFORM_FLAG_NONE);
+    if(!lv_area_is_on(&tranf_coords, &layer->_clip_area)) return true;
+
+    bool hit;
+    lv_cache_entry_t * entry = render_cache_get(layer, obj, &obj_draw_size, &hit);
+    if(entry == NULL) return false;
+
+    /*The buffer can't be freed until the draw task is ready, so release the entry only after the refresh*/
+    if(lv_array_push_back(render_cache_used_p, &entry) != LV_RESULT_OK) {
+        lv_cache_release(render_cache_p, entry, NULL);
+        return false;
+    }
+
+    const render_cache_data_t * data = lv_cache_entry_get_data(entry);
+
+    lv_point_t pivot = {
+        .x = lv_obj_get_style_transform_pivot_x(obj, 0),
+        .y = lv_obj_get_style_transform_pivot_y(obj, 0)
+    };
+
+    if(LV_COORD_IS_PCT(pivot.x)) {
+        pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
+    }
+    if(LV_COORD_IS_PCT(pivot.y)) {
+        pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
+    }
+
+    lv_draw_image_dsc_t draw_dsc;
+    lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.src = data->buf;
+    draw_dsc.pivot.x = obj->coords.x1 + pivot.x - obj_draw_size.x1;
+    draw_dsc.pivot.y = obj->coords.y1 + pivot.y - obj_draw_size.y1;
+    draw_dsc.opa = opa_layered;
+    draw_dsc.rotation = lv_obj_get_style_transform_rotation(obj, 0);
+    while(draw_dsc.rotation > 3600) draw_dsc.rotation -= 3600;
+    while(draw_dsc.rotation < 0) draw_dsc.rotation += 3600;
+    draw_dsc.scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
+    draw_dsc.scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
+    draw_dsc.skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
+    draw_dsc.skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
+    draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    draw_dsc.antialias = disp_refr->antialiasing;
+
+    lv_draw_image(layer, &draw_dsc, &obj_draw_size);
+
+#if LV_USE_RENDER_CACHE_DEBUG
+    lv_draw_rect_dsc_t debug_dsc;
+    lv_draw_rect_dsc_init(&debug_dsc);
+    debug_dsc.bg_opa = LV_OPA_TRANSP;
+    debug_dsc.border_color = hit ? lv_color_hex(0x00ff00) : lv_color_hex(0xff0000);
+    debug_dsc.border_width = 2;
+    lv_draw_rect(layer, &debug_dsc, &tranf_coords);
+#else
+    LV_UNUSED(hit);
+#endif
+
+    return true;
+}
+
+/**
+ * Get the cached content of an object. Render it if it's not cached yet or it's outdated.
+ * @param layer     the layer where the content will be drawn. Its opacity and recolor are applied on the content.
+ * @param obj       pointer to an object with render cache
+ * @param area      the area of the object including its extra draw size
+ * @param hit       store here whether the content was already cached
+ * @return          the acquired cache entry or NULL if the content couldn't be cached
+ */
+static lv_cache_entry_t * render_cache_get(lv_layer_t * layer, lv_obj_t * obj, const lv_area_t * area, bool * hit)
+{
+    if(render_cache_p == NULL) return NULL;
+
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+
+    render_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.obj = obj;
+    search_key.opa = layer->opa;
+    /*Without alpha the color of the recolor doesn't matter*/
+    if(layer->recolor.alpha > LV_OPA_TRANSP) search_key.recolor = layer->recolor;
+    search_key.slot.size = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) * h;
+    if(search_key.slot.size > lv_cache_get_max_size(render_cache_p, NULL)) return NULL;
+
+    *hit = false;
+    lv_cache_entry_t * entry = lv_cache_acquire(render_cache_p, &search_key, NULL);
+    if(entry) {
+        const render_cache_data_t * data = lv_cache_entry_get_data(entry);
+        if(data->buf->header.w == w && data->buf->header.h == h &&
+           data->opa == search_key.opa && lv_color32_eq(data->recolor, search_key.recolor)) {
+            *hit = true;
+            return entry;
+        }
+
+        /*The parents' opacity or recolor has changed*/
+        lv_cache_release(render_cache_p, entry, NULL);
+        lv_cache_drop(render_cache_p, &search_key, NULL);
+    }
+
+    LV_PROFILER_REFR_BEGIN_TAG("render_cache");
+    lv_draw_buf_t * buf = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate the render cache");
+        LV_PROFILER_REFR_END_TAG("render_cache");
+        return NULL;
+    }
+    lv_draw_buf_clear(buf, NULL);
+
+    /*Render the object to the buffer the same way as snapshots are taken*/
+    lv_layer_t cache_layer;
+    lv_layer_init(&cache_layer);
+    cache_layer.draw_buf = buf;
+    cache_layer.buf_area = *area;
+    cache_layer._clip_area = *area;
+    cache_layer.phy_clip_area = *area;
+    cache_layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    cache_layer.opa = search_key.opa;
+    cache_layer.recolor = search_key.recolor;
+
+    lv_layer_t * layer_head_ori = disp_refr->layer_head;
+    disp_refr->layer_head = &cache_layer;
+
+    lv_obj_redraw(&cache_layer, obj);
+    while(cache_layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp_refr->layer_head = layer_head_ori;
+    LV_PROFILER_REFR_END_TAG("render_cache");
+
+    search_key.buf = buf;
+    entry = lv_cache_acquire_or_create(render_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        /*All the other buffers are in use in this refresh*/
+        lv_draw_buf_destroy(buf);
+        return NULL;
+    }
+
+    const render_cache_data_t * data = lv_cache_entry_get_data(entry);
+    if(data->buf != buf) lv_draw_buf_destroy(buf);
+
+    return entry;
+}
+
+static void render_cache_release_all(void)
+{
+    uint32_t i;
+    uint32_t cnt = lv_array_size(render_cache_used_p);
+    for(i = 0; i < cnt; i++) {
+        lv_cache_entry_t ** entry = lv_array_at(render_cache_used_p, i);
+        lv_cache_release(render_cache_p, *entry, NULL);
+    }
+    lv_array_clear(render_cache_used_p);
+}
+
+static bool render_cache_create_cb(render_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*The content is already rendered and `buf` is set in the key*/
+    return data->buf != NULL;
+}
+
+static void render_cache_free_cb(render_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_draw_buf_destroy(data->buf);
+    data->buf = NULL;
+}
+
+static lv_cache_compare_res_t render_cache_compare_cb(const render_cache_data_t * lhs, const render_cache_data_t * rhs)
+{
+    if(lhs->obj != rhs->obj) return lhs->obj > rhs->obj ? 1 : -1;
+
+    return 0;
+}
+
+#endif /*LV_OBJ_RENDER_CACHE_SIZE > 0*/
+
+#if LV_USE_OCCLUSION_CULLING
+
+/**
+ * Collect the areas which are fully covered by opaque Widgets on the invalidated areas.
+ * Called once per refresh, the cover check results are reused for all the areas and their parts.
+ */
+static void occluders_collect(void)
+{
+    lv_array_clear(occluders_p);
+
+    /*Only the Widgets on the invalidated areas can hide others*/
+    lv_area_t inv_area;
+    bool inv_area_valid = false;
+    uint32_t i;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i]) continue;
+
+        if(inv_area_valid) lv_area_join(&inv_area, &inv_area, &disp_refr->inv_areas[i]);
+        else inv_area = disp_refr->inv_areas[i];
+        inv_area_valid = true;
+    }
+
+    if(!inv_area_valid) return;
+
+    LV_PROFILER_REFR_BEGIN;
+    /*The bottom layer is always drawn first, nothing can be hidden by it*/
+    if(disp_refr->prev_scr) occluders_collect_obj(disp_refr->prev_scr, &inv_area);
+    if(disp_refr->act_scr) occluders_collect_obj(disp_refr->act_scr, &inv_area);
+    if(disp_refr->top_layer) occluders_collect_obj(disp_refr->top_layer, &inv_area);
+    if(disp_refr->sys_layer) occluders_collect_obj(disp_refr->sys_layer, &inv_area);
+    LV_PROFILER_REFR_END;
+}
+
+/**
+ * Add the area covered by a Widget and its children to the occluders
+ * @param obj           pointer to a Widget
+ * @param clip_area     the Widget is visible only on this area
+ */
+static void occluders_collect_obj(lv_obj_t * obj, const lv_area_t * clip_area)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    /*Layers and transformations change where and how the Widget and its children appear*/
+    if(lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return;
+    if(lv_obj_get_style_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return;
+
+    lv_area_t area;
+    if(!lv_area_intersect(&area, clip_area, &obj->coords)) return;
+
+    int32_t short_side = LV_MIN(lv_area_get_width(&obj->coords), lv_area_get_height(&obj->coords));
+    int32_t radius = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), short_side >> 1);
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &area;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+
+    /*Rounded Widgets still cover the band between the top and bottom corners*/
+    if(info.res == LV_COVER_RES_NOT_COVER && radius > 0) {
+        area.y1 = LV_MAX(area.y1, obj->coords.y1 + radius);
+        area.y2 = LV_MIN(area.y2, obj->coords.y2 - radius);
+        if(area.y1 <= area.y2) {
+            info.res = LV_COVER_RES_COVER;
+            lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+        }
+    }
+
+    if(info.res == LV_COVER_RES_COVER) {
+        occluder_t occluder;
+        occluder.obj = obj;
+        occluder.area = area;
+        lv_array_push_back(occluders_p, &occluder);
+    }
+
+    /*The children are clipped to the Widget, and are masked at the corners with `clip_corner`*/
+    lv_area_t clip_area_children = obj->coords;
+    if(lv_obj_get_style_clip_corner(obj, LV_PART_MAIN)) {
+        clip_area_children.y1 += radius;
+        clip_area_children.y2 -= radius;
+    }
+    if(!lv_area_intersect(&clip_area_children, &clip_area_children, clip_area)) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+    const uint32_t * ids;
+    uint32_t id_cnt;
+    if(child_cnt >= LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN &&
+       lv_obj_spatial_index_query(obj, &clip_area_children, &ids, &id_cnt)) {
+        for(i = 0; i < id_cnt; i++) {
+            occluders_collect_obj(obj->spec_attr->children[ids[i]], &clip_area_children);
+        }
+        return;
+    }
+#endif
+    for(i = 0; i < child_cnt; i++) {
+        occluders_collect_obj(obj->spec_attr->children[i], &clip_area_children);
+    }
+}
+
+/**
+ * Select the occluders of the area to render
+ * @param area      the area being rendered
+ */
+static void occluders_filter(const lv_area_t * area)
+{
+    lv_array_clear(area_occluders_p);
+
+    uint32_t i;
+    uint32_t occluder_cnt = lv_array_size(occluders_p);
+    for(i = 0; i < occluder_cnt; i++) {
+        occluder_t * occluder = lv_array_at(occluders_p, i);
+        occluder_t area_occluder;
+        area_occluder.obj = occluder->obj;
+        if(lv_area_intersect(&area_occluder.area, &occluder->area, area)) {
+            lv_array_push_back(area_occluders_p, &area_occluder);
+        }
+    }
+}
+
+/**
+ * Remove the parts of a Widget which are hidden by opaque Widgets drawn above it.
+ * The clip area of the layer is reduced if a side of the Widget is covered.
+ * @param layer     the layer where the Widget would be drawn
+ * @param obj       pointer to a Widget
+ * @return          false: the Widget is fully hidden, it and its children don't need to be drawn
+ */
+static bool refr_obj_cull(lv_layer_t * layer, lv_obj_t * obj)
+{
+    /*Only the areas of the display's layer are known*/
+    if(layer != occlusion_layer) return true;
+
+    uint32_t occluder_cnt = lv_array_size(area_occluders_p);
+    if(occluder_cnt == 0) return true;
+
+    /*The Widget and its children are drawn only here*/
+    lv_area_t area;
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &area);
+    lv_area_increase(&area, ext_draw_size, ext_draw_size);
+
+    /*The pixels of transformed Widgets depend on the drawn area, so they can be only skipped*/
+    bool clip_en = true;
+    if(lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) {
+        lv_obj_get_transformed_area(obj, &area, LV_OBJ_POINT_TRANSFORM_FLAG_NONE);
+        clip_en = false;
+    }
+
+    if(!lv_area_intersect(&area, &area, &layer->_clip_area)) return true;
+
+    uint32_t size_ori = lv_area_get_size(&area);
+    bool clipped = false;
+    uint32_t i;
+    for(i = 0; i < occluder_cnt; i++) {
+        occluder_t * occluder = lv_array_at(area_occluders_p, i);
+        const lv_area_t * covered = &occluder->area;
+        if(!lv_area_is_on(&area, covered)) continue;
+
+        /*Only a fully covered width or height leaves a rectangular area to draw*/
+        bool cover_ver = covered->y1 <= area.y1 && covered->y2 >= area.y2;
+        bool cover_hor = covered->x1 <= area.x1 && covered->x2 >= area.x2;
+        if(!cover_ver && !cover_hor) continue;
+        if(!(cover_ver && cover_hor) && !clip_en) continue;
+        if(cover_ver && !cover_hor && covered->x1 > area.x1 && covered->x2 < area.x2) continue;
+        if(cover_hor && !cover_ver && covered->y1 > area.y1 && covered->y2 < area.y2) continue;
+
+        if(!obj_is_drawn_above(occluder->obj, obj)) continue;
+
+        if(cover_ver && cover_hor) {
+            disp_refr->occlusion_stats.culled_px += size_ori;
+            disp_refr->occlusion_stats.culled_obj_cnt++;
+            return false;
+        }
+
+        if(cover_ver) {
+            if(covered->x1 <= area.x1) area.x1 = covered->x2 + 1;
+            else area.x2 = covered->x1 - 1;
+        }
+        else {
+            if(covered->y1 <= area.y1) area.y1 = covered->y2 + 1;
+            else area.y2 = covered->y1 - 1;
+        }
+        clipped = true;
+    }
+
+    if(clipped) {
+        disp_refr->occlusion_stats.culled_px += size_ori - lv_area_get_size(&area);
+        layer->_clip_area = area;
+    }
+
+    return true;
+}
+
+/**
+ * Check if a Widget is drawn later than an other one, and not as its part
+ * @param obj_above     pointer to a Widget
+ * @param obj           pointer to an other Widget
+ * @return              true: `obj_above` is drawn after `obj` and its children
+ */
+static bool obj_is_drawn_above(const lv_obj_t * obj_above, const lv_obj_t * obj)
+{
+    uint32_t depth_above = 0;
+    const lv_obj_t * parent;
+    for(parent = obj_above->parent; parent; parent = parent->parent) depth_above++;
+
+    uint32_t depth = 0;
+    for(parent = obj->parent; parent; parent = parent->parent) depth++;
+
+    /*Go up to the same level*/
+    for(; depth_above > depth; depth_above--) obj_above = obj_above->parent;
+    for(; depth > depth_above; depth--) obj = obj->parent;
+
+    /*One of them is the ancestor of the other*/
+    if(obj_above == obj) return false;
+
+    while(obj_above->parent != obj->parent) {
+        obj_above = obj_above->parent;
+        obj = obj->parent;
+    }
+
+    if(obj_above->parent == NULL) return get_root_order(obj_above) > get_root_order(obj);
+    else return lv_obj_get_index(obj_above) > lv_obj_get_index(obj);
+}
+
+/**
+ * Get the drawing order of a screen or layer on the display being refreshed
+ * @param root      pointer to a screen or a display layer
+ * @return          larger value: drawn later
+ */
+static uint32_t get_root_order(const lv_obj_t * root)
+{
+    if(root == disp_refr->bottom_layer) return 0;
+    if(root == disp_refr->top_layer) return 3;
+    if(root == disp_refr->sys_layer) return 4;
+
+    /*The active or the previous screen*/
+    bool prev = root == disp_refr->prev_scr;
+    return prev == (bool)disp_refr->draw_prev_over_act ? 2 : 1;
+}
+
+#endif /*LV_USE_OCCLUSION_CULLING*/
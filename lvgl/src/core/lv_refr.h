@@ -21,10 +21,42 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Number of Widgets listed in `lv_refr_overdraw_stats_t` */
+#define LV_REFR_OVERDRAW_TOP_CNT    5
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_OCCLUSION_CULLING
+/** Statistics of the occlusion culling on a display*/
+typedef struct {
+    uint32_t rendered_px;       /**< Number of pixels in the refreshed areas*/
+    uint32_t culled_px;         /**< Number of pixels not drawn as opaque Widgets above covered them*/
+    uint32_t culled_obj_cnt;    /**< Number of Widgets skipped as they were fully covered*/
+} lv_refr_occlusion_stats_t;
+#endif
+
+#if LV_USE_OVERDRAW_DEBUG
+/** Fill-rate statistics of a frame. A pixel write is a pixel blended by the software renderer.*/
+typedef struct {
+    uint32_t frame;             /**< Number of the frame since the statistics were enabled*/
+    uint32_t screen_px;         /**< Number of pixels of the display*/
+    uint32_t invalidated_px;    /**< Number of pixels in the invalidated areas*/
+    uint32_t drawn_px;          /**< Number of pixels written at least once*/
+    uint32_t overdrawn_px;      /**< Number of pixels written more than once*/
+    uint32_t written_px;        /**< Number of pixel writes. `written_px / drawn_px` is the overdraw ratio*/
+    /** The Widgets with the most pixel writes, the largest first. `obj` is NULL in unused slots
+     *  and for writes without Widget. The pointers can be used only in the report callback.*/
+    struct {
+        lv_obj_t * obj;
+        uint32_t written_px;
+    } top[LV_REFR_OVERDRAW_TOP_CNT];
+} lv_refr_overdraw_stats_t;
+
+typedef void (*lv_refr_overdraw_report_cb_t)(lv_display_t * disp, const lv_refr_overdraw_stats_t * stats);
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -50,6 +82,81 @@ extern "C" {
  */
 void lv_refr_now(lv_display_t * disp);
 
+#if LV_USE_OCCLUSION_CULLING
+
+/**
+ * Get how much overdraw was avoided by occlusion culling since the last reset.
+ * `culled_px` counts each skipped Widget's area, so it can be larger than `rendered_px`.
+ * @param disp      pointer to a display. NULL to use the default display.
+ * @param stats     store the statistics here
+ */
+void lv_refr_get_occlusion_stats(lv_display_t * disp, lv_refr_occlusion_stats_t * stats);
+
+/**
+ * Reset the occlusion culling statistics of a display
+ * @param disp      pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_occlusion_stats(lv_display_t * disp);
+
+#endif /*LV_USE_OCCLUSION_CULLING*/
+
+#if LV_USE_OVERDRAW_DEBUG
+
+/**
+ * Start or stop counting the pixel writes of each frame on a display.
+ * It needs one byte per pixel of the display.
+ * @param disp      pointer to a display. NULL to use the default display.
+ * @param en        true: count the writes
+ */
+void lv_refr_overdraw_enable(lv_display_t * disp, bool en);
+
+/**
+ * Tint the redrawn pixels by how many times they were written in the frame:
+ * blue: 2, green: 3, pink: 4, red: 5 or more times. Enables counting too.
+ * @param disp      pointer to a display. NULL to use the default display.
+ * @param en        true: draw the heatmap
+ */
+void lv_refr_overdraw_set_heatmap(lv_display_t * disp, bool en);
+
+/**
+ * Set a callback to call with the statistics after each frame
+ * @param disp      pointer to a display. NULL to use the default display.
+ * @param cb        the callback, e.g. `lv_refr_overdraw_report_csv`. NULL to remove.
+ */
+void lv_refr_overdraw_set_report_cb(lv_display_t * disp, lv_refr_overdraw_report_cb_t cb);
+
+/**
+ * Get the statistics of the last frame
+ * @param disp      pointer to a display. NULL to use the default display.
+ * @param stats     store the statistics here. Zeroed if counting is not enabled.
+ */
+void lv_refr_overdraw_get_stats(lv_display_t * disp, lv_refr_overdraw_stats_t * stats);
+
+/**
+ * Get the header line of the CSV format of the statistics
+ * @return          the names of the columns separated by commas, without new line
+ */
+const char * lv_refr_overdraw_get_csv_header(void);
+
+/**
+ * Print the statistics of a frame as a CSV line. The top Widgets are listed in the last column
+ * as `class_name:written_px` separated by semicolons.
+ * @param stats     the statistics of a frame
+ * @param buf       store the line here, without new line
+ * @param buf_size  size of `buf`. The line is truncated if it doesn't fit.
+ */
+void lv_refr_overdraw_stats_to_csv(const lv_refr_overdraw_stats_t * stats, char * buf, uint32_t buf_size);
+
+/**
+ * A report callback which logs the statistics as a CSV line with `LV_LOG`.
+ * The header is logged before the first line.
+ * @param disp      pointer to the display
+ * @param stats     the statistics of a frame
+ */
+void lv_refr_overdraw_report_csv(lv_display_t * disp, const lv_refr_overdraw_stats_t * stats);
+
+#endif /*LV_USE_OVERDRAW_DEBUG*/
+
 /**
  * Redrawn on object and all its children using the passed draw context
  * @param layer pointer to a layer where to draw.
@@ -0,0 +1,394 @@
+/**
+ * @file lv_refr_overdraw.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_refr_private.h"
+
+#if LV_USE_OVERDRAW_DEBUG
+
+#include "lv_obj_private.h"
+#include "lv_obj_class_private.h"
+#include "../display/lv_display_private.h"
+#include "../draw/lv_draw_private.h"
+#include "../draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "../misc/lv_array.h"
+#include "../misc/lv_area_private.h"
+#include "../osal/lv_os.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../stdlib/lv_sprintf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define HEATMAP_OPA         LV_OPA_50
+#define HEATMAP_LEVEL_CNT   4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_obj_t * obj;
+    uint32_t written_px;
+} obj_px_t;
+
+struct _lv_refr_overdraw_t {
+    uint8_t * counters;     /*Number of writes of each pixel in the current frame, saturated at 255*/
+    int32_t hor_res;
+    int32_t ver_res;
+    lv_array_t objs;        /*obj_px_t: the pixel writes of each Widget in the current frame*/
+    uint32_t last_obj_idx;  /*Index of the last Widget in `objs` as usually the same Widget blends many times*/
+    uint32_t frame_cnt;
+    lv_refr_overdraw_stats_t stats;
+    lv_refr_overdraw_stats_t last_stats;
+    lv_refr_overdraw_report_cb_t report_cb;
+    lv_mutex_t lock;        /*The draw units can blend in parallel*/
+    uint8_t counting : 1;
+    uint8_t heatmap : 1;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_refr_overdraw_t * overdraw_get(lv_display_t * disp, bool create);
+static void invalidate_all(lv_display_t * disp);
+static int32_t heatmap_level(uint8_t cnt);
+static void add_obj_px(lv_refr_overdraw_t * od, lv_obj_t * obj, uint32_t px);
+static void collect_top_objs(lv_refr_overdraw_t * od);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const uint32_t heatmap_colors[HEATMAP_LEVEL_CNT] = {0x2060ff, 0x20e020, 0xff60ff, 0xff2020};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_refr_overdraw_enable(lv_display_t * disp, bool en)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    if(en) {
+        overdraw_get(disp, true);
+    }
+    else if(disp->overdraw) {
+        lv_refr_overdraw_delete(disp);
+        invalidate_all(disp);
+    }
+}
+
+void lv_refr_overdraw_set_heatmap(lv_display_t * disp, bool en)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_refr_overdraw_t * od = overdraw_get(disp, en);
+    if(od == NULL) return;
+
+    od->heatmap = en;
+    invalidate_all(disp);
+}
+
+void lv_refr_overdraw_set_report_cb(lv_display_t * disp, lv_refr_overdraw_report_cb_t cb)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_refr_overdraw_t * od = overdraw_get(disp, cb != NULL);
+    if(od == NULL) return;
+
+    od->report_cb = cb;
+}
+
+void lv_refr_overdraw_get_stats(lv_display_t * disp, lv_refr_overdraw_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL || disp->overdraw == NULL) {
+        lv_memzero(stats, sizeof(*stats));
+        return;
+    }
+
+    *stats = disp->overdraw->last_stats;
+}
+
+const char * lv_refr_overdraw_get_csv_header(void)
+{
+    return "frame,screen_px,invalidated_px,drawn_px,overdrawn_px,written_px,overdraw_pct,top_objs";
+}
+
+void lv_refr_overdraw_stats_to_csv(const lv_refr_overdraw_stats_t * stats, char * buf, uint32_t buf_size)
+{
+    uint32_t overdraw_pct = stats->drawn_px ? (uint32_t)((uint64_t)stats->written_px * 100 / stats->drawn_px) : 0;
+    uint32_t len = (uint32_t)lv_snprintf(buf, buf_size,
+                                         "%" LV_PRIu32 ",%" LV_PRIu32 ",%" LV_PRIu32 ",%" LV_PRIu32 ",%" LV_PRIu32 ",%" LV_PRIu32
+                                         ",%" LV_PRIu32 ",",
+                                         stats->frame, stats->screen_px, stats->invalidated_px, stats->drawn_px,
+                                         stats->overdrawn_px, stats->written_px, overdraw_pct);
+
+    /*List the top Widgets as "class:written_px" separated by ';' in the last column*/
+    uint32_t i;
+    for(i = 0; i < LV_REFR_OVERDRAW_TOP_CNT && stats->top[i].written_px > 0 && len < buf_size; i++) {
+        lv_obj_t * obj = stats->top[i].obj;
+        const char * name = obj && obj->class_p->name ? obj->class_p->name : "-";
+        len += (uint32_t)lv_snprintf(buf + len, buf_size - len, "%s%s:%" LV_PRIu32,
+                                     i == 0 ? "" : ";", name, stats->top[i].written_px);
+    }
+}
+
+void lv_refr_overdraw_report_csv(lv_display_t * disp, const lv_refr_overdraw_stats_t * stats)
+{
+    LV_UNUSED(disp);
+    static bool header_logged = false;
+    if(!header_logged) {
+        LV_LOG("%s\n", lv_refr_overdraw_get_csv_header());
+        header_logged = true;
+    }
+
+    char buf[256];
+    lv_refr_overdraw_stats_to_csv(stats, buf, sizeof(buf));
+    LV_LOG("%s\n", buf);
+}
+
+void lv_refr_overdraw_frame_start(lv_display_t * disp)
+{
+    lv_refr_overdraw_t * od = disp->overdraw;
+    if(od == NULL) return;
+
+    if(od->hor_res != disp->hor_res || od->ver_res != disp->ver_res) {
+        lv_free(od->counters);
+        od->hor_res = disp->hor_res;
+        od->ver_res = disp->ver_res;
+        od->counters = lv_malloc((size_t)od->hor_res * od->ver_res);
+        if(od->counters == NULL) {
+            LV_LOG_WARN("Couldn't allocate the overdraw counters");
+            od->hor_res = 0;
+            od->ver_res = 0;
+            return;
+        }
+    }
+
+    lv_memzero(od->counters, (size_t)od->hor_res * od->ver_res);
+    lv_memzero(&od->stats, sizeof(od->stats));
+    lv_array_clear(&od->objs);
+    od->last_obj_idx = 0;
+
+    od->frame_cnt++;
+    od->stats.frame = od->frame_cnt;
+    od->stats.screen_px = od->hor_res * od->ver_res;
+
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i]) continue;
+        od->stats.invalidated_px += lv_area_get_size(&disp->inv_areas[i]);
+    }
+
+    od->counting = 1;
+}
+
+void lv_refr_overdraw_frame_end(lv_display_t * disp)
+{
+    lv_refr_overdraw_t * od = disp->overdraw;
+    if(od == NULL || od->counting == 0) return;
+
+    od->counting = 0;
+    collect_top_objs(od);
+    od->last_stats = od->stats;
+
+    if(od->report_cb) od->report_cb(disp, &od->last_stats);
+}
+
+void lv_refr_overdraw_add(lv_draw_task_t * t, const lv_area_t * area)
+{
+    lv_display_t * disp = lv_refr_get_disp_refreshing();
+    if(disp == NULL) return;
+    lv_refr_overdraw_t * od = disp->overdraw;
+    if(od == NULL || od->counting == 0) return;
+
+    lv_area_t scr_area = {0, 0, od->hor_res - 1, od->ver_res - 1};
+    lv_area_t a;
+    if(!lv_area_intersect(&a, area, &scr_area)) return;
+
+    lv_mutex_lock(&od->lock);
+
+    uint32_t drawn_px = 0;
+    uint32_t overdrawn_px = 0;
+    int32_t w = lv_area_get_width(&a);
+    int32_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        uint8_t * c = &od->counters[y * od->hor_res + a.x1];
+        int32_t x;
+        for(x = 0; x < w; x++) {
+            if(c[x] == 0) drawn_px++;
+            else if(c[x] == 1) overdrawn_px++;
+            if(c[x] < 255) c[x]++;
+        }
+    }
+
+    uint32_t written_px = lv_area_get_size(&a);
+    od->stats.drawn_px += drawn_px;
+    od->stats.overdrawn_px += overdrawn_px;
+    od->stats.written_px += written_px;
+
+    const lv_draw_dsc_base_t * base = t->draw_dsc;
+    add_obj_px(od, base ? base->obj : NULL, written_px);
+
+    lv_mutex_unlock(&od->lock);
+}
+
+void lv_refr_overdraw_draw_heatmap(lv_display_t * disp, lv_layer_t * layer)
+{
+#if LV_USE_DRAW_SW
+    lv_refr_overdraw_t * od = disp->overdraw;
+    if(od == NULL || od->heatmap == 0 || od->counting == 0) return;
+
+    lv_area_t scr_area = {0, 0, od->hor_res - 1, od->ver_res - 1};
+    lv_area_t area;
+    if(!lv_area_intersect(&area, &disp->refreshed_area, &scr_area)) return;
+    if(!lv_area_intersect(&area, &area, &layer->buf_area)) return;
+
+    /*Blend directly as the layer is already rendered and it's not drawn by tasks anymore*/
+    lv_draw_task_t t;
+    lv_memzero(&t, sizeof(t));
+    t.target_layer = layer;
+    t.clip_area = area;
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.opa = HEATMAP_OPA;
+    blend_dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+    /*Don't count the heatmap itself*/
+    od->counting = 0;
+
+    int32_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        const uint8_t * c = &od->counters[y * od->hor_res];
+        int32_t x = area.x1;
+        while(x <= area.x2) {
+            /*Fill the runs of the same level at once. Pixels written at most once are not tinted.*/
+            int32_t level = heatmap_level(c[x]);
+            int32_t x_start = x;
+            while(x <= area.x2 && heatmap_level(c[x]) == level) x++;
+            if(level < 0) continue;
+
+            lv_area_t run_area = {x_start, y, x - 1, y};
+            blend_dsc.blend_area = &run_area;
+            blend_dsc.color = lv_color_hex(heatmap_colors[level]);
+            lv_draw_sw_blend(&t, &blend_dsc);
+        }
+    }
+
+    od->counting = 1;
+#else
+    LV_UNUSED(disp);
+    LV_UNUSED(layer);
+#endif
+}
+
+void lv_refr_overdraw_delete(lv_display_t * disp)
+{
+    lv_refr_overdraw_t * od = disp->overdraw;
+    if(od == NULL) return;
+
+    lv_free(od->counters);
+    lv_array_deinit(&od->objs);
+    lv_mutex_delete(&od->lock);
+    lv_free(od);
+    disp->overdraw = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_refr_overdraw_t * overdraw_get(lv_display_t * disp, bool create)
+{
+    if(disp->overdraw || !create) return disp->overdraw;
+
+    lv_refr_overdraw_t * od = lv_malloc_zeroed(sizeof(lv_refr_overdraw_t));
+    LV_ASSERT_MALLOC(od);
+    if(od == NULL) return NULL;
+
+    lv_array_init(&od->objs, 32, sizeof(obj_px_t));
+    lv_mutex_init(&od->lock);
+    disp->overdraw = od;
+    return od;
+}
+
+static void invalidate_all(lv_display_t * disp)
+{
+    lv_area_t area = {0, 0, lv_display_get_horizontal_resolution(disp) - 1, lv_display_get_vertical_resolution(disp) - 1};
+    lv_inv_area(disp, &area);
+}
+
+/**
+ * Get the heatmap color index of a pixel
+ * @param cnt       number of writes of the pixel
+ * @return          index in `heatmap_colors` or -1 if it's not tinted
+ */
+static int32_t heatmap_level(uint8_t cnt)
+{
+    if(cnt < 2) return -1;
+    return LV_MIN(cnt, HEATMAP_LEVEL_CNT + 1) - 2;
+}
+
+static void add_obj_px(lv_refr_overdraw_t * od, lv_obj_t * obj, uint32_t px)
+{
+    uint32_t cnt = lv_array_size(&od->objs);
+    if(od->last_obj_idx < cnt) {
+        obj_px_t * last = lv_array_at(&od->objs, od->last_obj_idx);
+        if(last->obj == obj) {
+            last->written_px += px;
+            return;
+        }
+    }
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        obj_px_t * e = lv_array_at(&od->objs, i);
+        if(e->obj == obj) {
+            e->written_px += px;
+            od->last_obj_idx = i;
+            return;
+        }
+    }
+
+    obj_px_t e = {obj, px};
+    if(lv_array_push_back(&od->objs, &e) == LV_RESULT_OK) od->last_obj_idx = cnt;
+}
+
+static void collect_top_objs(lv_refr_overdraw_t * od)
+{
+    uint32_t cnt = lv_array_size(&od->objs);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        obj_px_t * e = lv_array_at(&od->objs, i);
+
+        /*Insert into the sorted list if it's larger than the smallest one*/
+        int32_t j = LV_REFR_OVERDRAW_TOP_CNT - 1;
+        if(e->written_px <= od->stats.top[j].written_px) continue;
+        while(j > 0 && od->stats.top[j - 1].written_px < e->written_px) {
+            od->stats.top[j] = od->stats.top[j - 1];
+            j--;
+        }
+        od->stats.top[j].obj = e->obj;
+        od->stats.top[j].written_px = e->written_px;
+    }
+}
+
+#endif /*LV_USE_OVERDRAW_DEBUG*/
@@ -24,6 +24,10 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_OVERDRAW_DEBUG
+typedef struct _lv_refr_overdraw_t lv_refr_overdraw_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -46,6 +50,25 @@ void lv_refr_deinit(void);
  */
 void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+/**
+ * Move the already rendered content of an area on the next refresh instead of redrawing it.
+ * Only the parts of the area which are uncovered by the move are invalidated.
+ * It's supported only in `LV_DISPLAY_RENDER_MODE_DIRECT` without rotation.
+ * @param disp      pointer to display where the area should be moved (NULL: the default display)
+ * @param area_p    the area whose content should be moved. The content is clipped to this area.
+ * @param x_ofs     move the content by this many pixels horizontally
+ * @param y_ofs     move the content by this many pixels vertically
+ * @return          true: the move is scheduled; false: the move is not possible, invalidate the area instead
+ */
+bool lv_inv_area_move(lv_display_t * disp, const lv_area_t * area_p, int32_t x_ofs, int32_t y_ofs);
+
+/**
+ * Free the cached rendered content of a Widget and of its parents which use render cache
+ * as it's outdated. See `lv_obj_set_render_cache()`.
+ * @param obj       pointer to an object which has changed
+ */
+void lv_refr_render_cache_invalidate(const lv_obj_t * obj);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -58,6 +81,42 @@ lv_display_t * lv_refr_get_disp_refreshing(void);
  */
 void lv_refr_set_disp_refreshing(lv_display_t * disp);
 
+#if LV_USE_OVERDRAW_DEBUG
+
+/**
+ * Start counting the pixel writes of a frame if enabled on the display
+ * @param disp      the display to be refreshed
+ */
+void lv_refr_overdraw_frame_start(lv_display_t * disp);
+
+/**
+ * Finish the statistics of a frame and report them
+ * @param disp      the refreshed display
+ */
+void lv_refr_overdraw_frame_end(lv_display_t * disp);
+
+/**
+ * Count the pixels written by a draw task on the display being refreshed
+ * @param t         the draw task
+ * @param area      the written area in absolute coordinates
+ */
+void lv_refr_overdraw_add(lv_draw_task_t * t, const lv_area_t * area);
+
+/**
+ * Draw the heatmap on the rendered area before flushing it, if enabled
+ * @param disp      the refreshed display
+ * @param layer     the display's layer with the rendered content
+ */
+void lv_refr_overdraw_draw_heatmap(lv_display_t * disp, lv_layer_t * layer);
+
+/**
+ * Free the statistics of a display
+ * @param disp      the display being deleted
+ */
+void lv_refr_overdraw_delete(lv_display_t * disp);
+
+#endif /*LV_USE_OVERDRAW_DEBUG*/
+
 /**********************
  *      MACROS
  **********************/
@@ -206,6 +206,9 @@ void lv_display_delete(lv_display_t * disp)
     }
 
     lv_ll_clear(&disp->sync_areas);
+#if LV_USE_OVERDRAW_DEBUG
+    lv_refr_overdraw_delete(disp);
+#endif
     lv_ll_remove(disp_ll_p, disp);
     if(disp->refr_timer) lv_timer_delete(disp->refr_timer);
 
@@ -576,6 +579,9 @@ bool lv_display_get_antialiasing(lv_display_t * disp)
 
 LV_ATTRIBUTE_FLUSH_READY void lv_display_flush_ready(lv_display_t * disp)
 {
+#if LV_USE_PERF_MONITOR
+    if(disp->flushing_last) lv_sysmon_input_latency_flush_ready(disp);
+#endif
     disp->flushing = 0;
 }
 
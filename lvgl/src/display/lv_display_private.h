@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "../misc/lv_types.h"
 #include "../core/lv_obj.h"
+#include "../core/lv_refr.h"
 #include "../draw/lv_draw.h"
 #include "lv_display.h"
 
@@ -29,6 +30,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_INV_MOVE_BUF_SIZE
+#define LV_INV_MOVE_BUF_SIZE 4 /**< Buffer size for areas whose content is moved instead of redrawn */
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -105,6 +110,11 @@ struct _lv_display_t {
     uint32_t inv_p;
     int32_t inv_en_cnt;
 
+    /** Areas whose already rendered content is moved by `move_ofs` before the next refresh*/
+    lv_area_t move_areas[LV_INV_MOVE_BUF_SIZE];
+    lv_point_t move_ofs[LV_INV_MOVE_BUF_SIZE];
+    uint32_t move_p;
+
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
 
@@ -159,6 +169,14 @@ struct _lv_display_t {
     lv_area_t refreshed_area;
     uint32_t vsync_count;
 
+#if LV_USE_OCCLUSION_CULLING
+    lv_refr_occlusion_stats_t occlusion_stats;
+#endif
+
+#if LV_USE_OVERDRAW_DEBUG
+    struct _lv_refr_overdraw_t * overdraw;  /**< Pixel write statistics, NULL if not enabled*/
+#endif
+
 #if LV_USE_PERF_MONITOR
     lv_obj_t * perf_label;
     lv_sysmon_backend_data_t perf_sysmon_backend;
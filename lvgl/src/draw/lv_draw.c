@@ -24,8 +24,16 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
+
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    #define TASK_ARENA_HEADER_SIZE  LV_ALIGN_UP(sizeof(lv_draw_task_arena_chunk_t), 8)
+    #define TASK_ARENA_DATA_SIZE    (LV_DRAW_TASK_ARENA_SIZE - TASK_ARENA_HEADER_SIZE)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -37,6 +45,10 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
 static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
 static inline size_t get_draw_dsc_size(lv_draw_task_type_t type);
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer);
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    static void * task_arena_alloc(lv_layer_t * layer, size_t size);
+    static void task_arena_release(lv_layer_t * layer);
+#endif
 
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
@@ -79,6 +91,15 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    while(_draw_info.task_arena_pool) {
+        lv_draw_task_arena_chunk_t * chunk = _draw_info.task_arena_pool;
+        _draw_info.task_arena_pool = chunk->next;
+        lv_free(chunk);
+    }
+    _draw_info.task_arena_info.chunk_cnt = 0;
+#endif
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -100,7 +121,19 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     LV_PROFILER_DRAW_BEGIN;
     size_t dsc_size = get_draw_dsc_size(type);
     LV_ASSERT_FORMAT_MSG(dsc_size > 0, "Draw task size is 0 for type %d", type);
-    lv_draw_task_t * new_task = lv_malloc_zeroed(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size);
+    size_t task_size = LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size;
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    lv_draw_task_t * new_task = task_arena_alloc(layer, task_size);
+    if(new_task) {
+        lv_memzero(new_task, task_size);
+        new_task->from_arena = 1;
+    }
+    else {
+        new_task = lv_malloc_zeroed(task_size);
+    }
+#else
+    lv_draw_task_t * new_task = lv_malloc_zeroed(task_size);
+#endif
     LV_ASSERT_MALLOC(new_task);
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -253,6 +286,11 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
         t = t_next;
     }
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    /*No draw task points into the arena anymore, it can be reused*/
+    if(layer->draw_task_head == NULL) task_arena_release(layer);
+#endif
+
     bool task_dispatched = false;
 
     /*This layer is ready, enable blending its buffer*/
@@ -362,6 +400,14 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
     return NULL;
 }
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+void lv_draw_get_task_arena_info(lv_draw_task_arena_info_t * info)
+{
+    LV_ASSERT_NULL(info);
+    *info = _draw_info.task_arena_info;
+}
+#endif
+
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 {
     if(t_check == NULL) return 0;
@@ -480,6 +526,10 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
         return NULL;
     }
 
+#if LV_USE_MEM_TAGS
+    lv_draw_buf_set_mem_tag(layer->draw_buf, LV_MEM_TAG_LAYER);
+#endif
+
     _draw_info.used_memory_for_layers += layer_size_byte;
     LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB", get_layer_size_kb(_draw_info.used_memory_for_layers));
 
@@ -635,6 +685,9 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
                 disp->layer_deinit(disp, layer_drawn);
                 LV_PROFILER_DRAW_END_TAG("layer_deinit");
             }
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+            task_arena_release(layer_drawn);
+#endif
             lv_free(layer_drawn);
         }
     }
@@ -644,7 +697,12 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
         draw_label_dsc->text = NULL;
     }
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    /*Tasks of the arena are released together when the layer is drained*/
+    if(!t->from_arena) lv_free(t);
+#else
     lv_free(t);
+#endif
     LV_PROFILER_DRAW_END;
 }
 
@@ -676,3 +734,65 @@ static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
     LV_PROFILER_DRAW_END;
     return t;
 }
+
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+
+/**
+ * Allocate memory from the arena of a layer. Take a new chunk if the current one is full.
+ * @param layer     the layer whose arena should be used
+ * @param size      size of the memory to allocate
+ * @return          pointer to the allocated memory or NULL if it doesn't fit into a chunk or out of memory
+ */
+static void * task_arena_alloc(lv_layer_t * layer, size_t size)
+{
+    lv_draw_task_arena_info_t * info = &_draw_info.task_arena_info;
+
+    size = LV_ALIGN_UP(size, 8);
+    if(size > TASK_ARENA_DATA_SIZE) {
+        info->fallback_cnt++;
+        return NULL;
+    }
+
+    lv_draw_task_arena_chunk_t * chunk = layer->task_arena;
+    if(chunk == NULL || chunk->used + size > TASK_ARENA_DATA_SIZE) {
+        chunk = _draw_info.task_arena_pool;
+        if(chunk) {
+            _draw_info.task_arena_pool = chunk->next;
+        }
+        else {
+            chunk = lv_malloc(LV_DRAW_TASK_ARENA_SIZE);
+            if(chunk == NULL) {
+                info->fallback_cnt++;
+                return NULL;
+            }
+            info->chunk_cnt++;
+            info->chunk_alloc_cnt++;
+        }
+
+        chunk->used = 0;
+        chunk->next = layer->task_arena;
+        layer->task_arena = chunk;
+    }
+
+    void * p = (uint8_t *)chunk + TASK_ARENA_HEADER_SIZE + chunk->used;
+    chunk->used += size;
+    info->task_cnt++;
+
+    return p;
+}
+
+/**
+ * Give the chunks of a layer back to the pool. No draw task of the layer can be used after this.
+ * @param layer     pointer to a layer
+ */
+static void task_arena_release(lv_layer_t * layer)
+{
+    while(layer->task_arena) {
+        lv_draw_task_arena_chunk_t * chunk = layer->task_arena;
+        layer->task_arena = chunk->next;
+        chunk->next = _draw_info.task_arena_pool;
+        _draw_info.task_arena_pool = chunk;
+    }
+}
+
+#endif /*LV_DRAW_TASK_ARENA_SIZE > 0*/
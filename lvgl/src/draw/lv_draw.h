@@ -112,12 +112,26 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    /** Arena chunks the draw tasks of this layer are allocated from. Used internally. */
+    struct _lv_draw_task_arena_chunk_t * task_arena;
+#endif
+
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
     void * user_data;
 };
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+typedef struct {
+    uint32_t chunk_cnt;         /**< Number of chunks allocated currently, in use or kept for reuse */
+    uint32_t chunk_alloc_cnt;   /**< Number of times a new chunk had to be allocated */
+    uint32_t task_cnt;          /**< Number of draw tasks allocated from the arenas */
+    uint32_t fallback_cnt;      /**< Number of draw tasks allocated with `lv_malloc()` as they didn't fit into a chunk */
+} lv_draw_task_arena_info_t;
+#endif
+
 typedef struct {
     /**The widget for which draw descriptor was created */
     lv_obj_t * obj;
@@ -235,6 +249,16 @@ lv_draw_task_t * lv_draw_get_available_task(lv_layer_t * layer, lv_draw_task_t *
  */
 lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_task_t * t_prev, uint8_t draw_unit_id);
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+/**
+ * Get the statistics of the draw task arenas.
+ * E.g. if `chunk_alloc_cnt` and `fallback_cnt` don't change between two frames, the frame was rendered
+ * without allocating memory for the draw tasks.
+ * @param info      the result will be stored here
+ */
+void lv_draw_get_task_arena_info(lv_draw_task_arena_info_t * info);
+#endif
+
 /**
  * Tell how many draw task are waiting to be drawn on the area of `t_check`.
  * It can be used to determine if a GPU shall combine many draw tasks into one or not.
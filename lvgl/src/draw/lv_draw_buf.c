@@ -16,6 +16,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
+
 #define default_handlers LV_GLOBAL_DEFAULT()->draw_buf_handlers
 #define font_draw_buf_handlers LV_GLOBAL_DEFAULT()->font_draw_buf_handlers
 #define image_cache_draw_buf_handlers LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers
@@ -646,6 +649,21 @@ void lv_image_buf_free(lv_image_dsc_t * dsc)
     }
 }
 
+#if LV_USE_MEM_TAGS
+void lv_draw_buf_set_mem_tag(const lv_draw_buf_t * draw_buf, lv_mem_tag_t tag)
+{
+    LV_ASSERT_NULL(draw_buf);
+    if(!(draw_buf->header.flags & LV_IMAGE_FLAGS_ALLOCATED)) return;
+
+    lv_mem_tag_set((void *)draw_buf, tag);
+
+    /*Custom handlers might not allocate with `lv_malloc()`*/
+    if(draw_buf->handlers && draw_buf->handlers->buf_malloc_cb == buf_malloc) {
+        lv_mem_tag_set(draw_buf->unaligned_data, tag);
+    }
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
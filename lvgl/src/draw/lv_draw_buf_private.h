@@ -42,6 +42,16 @@ struct _lv_draw_buf_handlers_t {
  */
 void lv_draw_buf_init_handlers(void);
 
+#if LV_USE_MEM_TAGS
+/**
+ * Attribute the memory of a draw buffer to a tag, e.g. to tell the layers and the cached images apart.
+ * Only the buffers allocated by the default handlers are retagged.
+ * @param draw_buf  pointer to a draw buffer allocated by `lv_draw_buf_create()` or similar
+ * @param tag       the new tag
+ */
+void lv_draw_buf_set_mem_tag(const lv_draw_buf_t * draw_buf, lv_mem_tag_t tag);
+#endif
+
 /**********************
  *      MACROS
  **********************/
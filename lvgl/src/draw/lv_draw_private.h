@@ -81,6 +81,10 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    /** 1: allocated from the arena of the target layer, released with the arena */
+    uint8_t from_arena;
+#endif
 };
 
 struct _lv_draw_mask_t {
@@ -173,6 +177,13 @@ struct _lv_draw_unit_t {
     int32_t (*delete_cb)(lv_draw_unit_t * draw_unit);
 };
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+typedef struct _lv_draw_task_arena_chunk_t {
+    struct _lv_draw_task_arena_chunk_t * next;
+    uint32_t used;      /**< Bytes used from the data area following this header */
+} lv_draw_task_arena_chunk_t;
+#endif
+
 typedef struct {
     lv_draw_unit_t * unit_head;
     uint32_t unit_cnt;
@@ -182,8 +193,11 @@ typedef struct {
 #else
     volatile int dispatch_req;
 #endif
-    lv_mutex_t circle_cache_mutex;
     bool task_running;
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    lv_draw_task_arena_chunk_t * task_arena_pool;   /**< Chunks of drained layers, ready for reuse */
+    lv_draw_task_arena_info_t task_arena_info;
+#endif
 } lv_draw_global_info_t;
 
 /**********************
@@ -30,6 +30,8 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
 
 #ifndef M_PI
     #define M_PI 3.1415926f
@@ -230,6 +230,11 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
     lv_image_cache_data_t * cached_data;
     cached_data = lv_cache_entry_get_data(cache_entry);
 
+#if LV_USE_MEM_TAGS
+    /*Account the decoded image to the image cache from now on*/
+    lv_draw_buf_set_mem_tag(decoded, LV_MEM_TAG_IMAGE);
+#endif
+
     /*Set the cache entry to decoder data*/
     cached_data->decoded = decoded;
     if(cached_data->src_type == LV_IMAGE_SRC_FILE) {
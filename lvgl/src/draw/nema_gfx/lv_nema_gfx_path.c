@@ -39,6 +39,12 @@
 
 #include "lv_nema_gfx_path.h"
 
+/*********************
+ *      DEFINES
+ *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
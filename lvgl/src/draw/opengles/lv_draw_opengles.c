@@ -31,6 +31,8 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
 
 #define DRAW_UNIT_ID_OPENGLES 6
 
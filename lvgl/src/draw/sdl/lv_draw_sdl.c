@@ -20,6 +20,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
+
 #define DRAW_UNIT_ID_SDL     100
 
 /**********************
@@ -10,6 +10,7 @@
 #include "lv_draw_sw_blend_private.h"
 #include "../../lv_draw_private.h"
 #include "../lv_draw_sw.h"
+#include "../../../core/lv_refr_private.h"
 #if LV_DRAW_SW_SUPPORT_L8
     #include "lv_draw_sw_blend_to_l8.h"
 #endif
@@ -79,6 +80,9 @@ void lv_draw_sw_blend(lv_draw_task_t * t, const lv_draw_sw_blend_dsc_t * blend_d
 
     lv_draw_sw_blend_handler_t handler = lv_draw_sw_get_blend_handler(layer->color_format);
     if(handler) {
+#if LV_USE_OVERDRAW_DEBUG
+        lv_refr_overdraw_add(t, &blend_area);
+#endif
         handler(t, blend_dsc);
         LV_PROFILER_DRAW_END;
         return;
@@ -108,6 +112,9 @@ void lv_draw_sw_blend(lv_draw_task_t * t, const lv_draw_sw_blend_dsc_t * blend_d
                                  (blend_area.x1 - blend_dsc->mask_area->x1);
         }
 
+#if LV_USE_OVERDRAW_DEBUG
+        lv_refr_overdraw_add(t, &blend_area);
+#endif
         lv_draw_sw_blend_color(layer->color_format, &fill_dsc);
     }
     else {
@@ -159,6 +166,9 @@ void lv_draw_sw_blend(lv_draw_task_t * t, const lv_draw_sw_blend_dsc_t * blend_d
         image_dsc.dest_buf = lv_draw_layer_go_to_xy(layer, blend_area.x1 - layer->buf_area.x1,
                                                     blend_area.y1 - layer->buf_area.y1);
 
+#if LV_USE_OVERDRAW_DEBUG
+        lv_refr_overdraw_add(t, &blend_area);
+#endif
         lv_draw_sw_blend_image(layer->color_format, &image_dsc);
     }
     LV_PROFILER_DRAW_END;
@@ -15,6 +15,7 @@
 #include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
 #include "../../misc/lv_area_private.h"
+#include "../../misc/lv_profiler_builtin.h"
 
 #if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
     #if LV_USE_THORVG_EXTERNAL
@@ -77,6 +78,8 @@ void lv_draw_sw_init(void)
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_init();
+    lv_draw_sw_box_shadow_cache_init();
+    lv_draw_sw_arc_cache_init();
 #endif
 
     lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
@@ -115,6 +118,8 @@ void lv_draw_sw_deinit(void)
 #endif
 
 #if LV_DRAW_SW_COMPLEX == 1
+    lv_draw_sw_arc_cache_deinit();
+    lv_draw_sw_box_shadow_cache_deinit();
     lv_draw_sw_mask_deinit();
 #endif
 }
@@ -338,6 +343,13 @@ static void render_thread_cb(void * ptr)
 {
     lv_draw_sw_thread_dsc_t * thread_dsc = ptr;
 
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    /*Show each render thread on its own track*/
+    char name[16];
+    lv_snprintf(name, sizeof(name), "swdraw-%d", (int)thread_dsc->idx);
+    lv_profiler_builtin_set_thread_name(name);
+#endif
+
     lv_thread_sync_init(&thread_dsc->sync);
     thread_dsc->inited = true;
 
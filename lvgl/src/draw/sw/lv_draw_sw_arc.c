@@ -16,27 +16,56 @@
 
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_log.h"
+#include "../../misc/cache/lv_cache.h"
+#include "../../misc/cache/lv_cache_private.h"
+#include "../../core/lv_global.h"
 #include "../../stdlib/lv_mem.h"
 #include "../../stdlib/lv_string.h"
 #include "../lv_draw_private.h"
 
-static void add_circle(const lv_opa_t * circle_mask, const lv_area_t * blend_area, const lv_area_t * circle_area,
-                       lv_opa_t * mask_buf,  int32_t width);
-static void get_rounded_area(int16_t angle, int32_t radius, uint8_t thickness, lv_area_t * res_area);
-
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
+
 #define SPLIT_RADIUS_LIMIT 10  /*With radius greater than this the arc will drawn in quarters. A quarter is drawn only if there is arc in it*/
 #define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
+#define arc_cache LV_GLOBAL_DEFAULT()->sw_arc_cache
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    /** The first element must be the slot used by the size based cache. Its size is the size of `buf`. */
+    lv_cache_slot_size_t slot;
+
+    int32_t w;          /**< Width of the arc's area */
+    int32_t h;          /**< Height of the arc's area */
+    int32_t radius;
+    int32_t width;      /**< Arc width */
+    int32_t rounded;
+
+    /** The ring coverage of the top left quarter of the area (it's symmetric) and
+     *  the coverage of the rounded ending after it. Read only once calculated. */
+    lv_opa_t * buf;
+} arc_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void add_circle(const lv_opa_t * circle_mask, const lv_area_t * blend_area, const lv_area_t * circle_area,
+                       lv_opa_t * mask_buf,  int32_t width);
+static void get_rounded_area(int16_t angle, int32_t radius, uint8_t thickness, lv_area_t * res_area);
+static void calc_circle_mask(lv_opa_t * circle_mask, int32_t width);
+static lv_cache_entry_t * get_ring(const lv_area_t * area_out, const lv_draw_arc_dsc_t * dsc, int32_t width);
+static lv_draw_sw_mask_res_t get_ring_line(const arc_cache_data_t * ring, const lv_area_t * area_out,
+                                           const lv_area_t * blend_area, void * mask_list[], lv_opa_t * mask_buf,
+                                           lv_opa_t * angle_buf);
+static bool arc_cache_create_cb(arc_cache_data_t * data, void * user_data);
+static void arc_cache_free_cb(arc_cache_data_t * data, void * user_data);
+static lv_cache_compare_res_t arc_cache_compare_cb(const arc_cache_data_t * lhs, const arc_cache_data_t * rhs);
 
 /**********************
  *  STATIC VARIABLES
@@ -50,6 +79,26 @@ static void get_rounded_area(int16_t angle, int32_t radius, uint8_t thickness, l
  *   GLOBAL FUNCTIONS
  **********************/
 
+void lv_draw_sw_arc_cache_init(void)
+{
+    const lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)arc_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)arc_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)arc_cache_free_cb,
+    };
+
+    arc_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(arc_cache_data_t), LV_DRAW_SW_ARC_CACHE_SIZE, ops);
+    lv_cache_set_name(arc_cache, "SW_ARC");
+}
+
+void lv_draw_sw_arc_cache_deinit(void)
+{
+    if(arc_cache == NULL) return;
+
+    lv_cache_destroy(arc_cache, NULL);
+    arc_cache = NULL;
+}
+
 void lv_draw_sw_arc(lv_draw_task_t * t, const lv_draw_arc_dsc_t * dsc, const lv_area_t * coords)
 {
 #if LV_DRAW_SW_COMPLEX
@@ -110,10 +159,15 @@ void lv_draw_sw_arc(lv_draw_task_t * t, const lv_draw_arc_dsc_t * dsc, const lv_
         mask_in_param_valid = true;
     }
 
+    /*If the coverage of the ring is cached only the angle mask needs to be applied on most pixels*/
+    lv_cache_entry_t * ring_entry = get_ring(&area_out, dsc, width);
+    const arc_cache_data_t * ring = ring_entry ? lv_cache_entry_get_data(ring_entry) : NULL;
+
     int32_t blend_h = lv_area_get_height(&clipped_area);
     int32_t blend_w = lv_area_get_width(&clipped_area);
     int32_t h;
     lv_opa_t * mask_buf = lv_malloc(blend_w);
+    lv_opa_t * angle_buf = ring ? lv_malloc(blend_w) : NULL;
 
     lv_area_t blend_area = clipped_area;
     lv_area_t img_area;
@@ -152,28 +206,20 @@ void lv_draw_sw_arc(lv_draw_task_t * t, const lv_draw_arc_dsc_t * dsc, const lv_
         }
     }
 
-    lv_opa_t * circle_mask = NULL;
+    const lv_opa_t * circle_mask = NULL;
+    lv_opa_t * circle_mask_buf = NULL;
     lv_area_t round_area_1;
     lv_area_t round_area_2;
     if(dsc->rounded) {
-        circle_mask = lv_malloc(width * width);
-        LV_ASSERT_MALLOC(circle_mask);
-        lv_memset(circle_mask, 0xff, width * width);
-        lv_area_t circle_area = {0, 0, width - 1, width - 1};
-        lv_draw_sw_mask_radius_param_t circle_mask_param;
-        lv_draw_sw_mask_radius_init(&circle_mask_param, &circle_area, width / 2, false);
-        void * circle_mask_list[2] = {&circle_mask_param, NULL};
-
-        lv_opa_t * circle_mask_tmp = circle_mask;
-        for(h = 0; h < width; h++) {
-            lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(circle_mask_list, circle_mask_tmp, 0, h, width);
-            if(res == LV_DRAW_SW_MASK_RES_TRANSP) {
-                lv_memzero(circle_mask_tmp, width);
-            }
-
-            circle_mask_tmp += width;
+        if(ring) {
+            circle_mask = ring->buf + ((ring->w + 1) / 2) * ((ring->h + 1) / 2);
+        }
+        else {
+            circle_mask_buf = lv_malloc(width * width);
+            LV_ASSERT_MALLOC(circle_mask_buf);
+            calc_circle_mask(circle_mask_buf, width);
+            circle_mask = circle_mask_buf;
         }
-        lv_draw_sw_mask_free_param(&circle_mask_param);
 
         get_rounded_area(start_angle, dsc->radius, width, &round_area_1);
         lv_area_move(&round_area_1, dsc->center.x, dsc->center.y);
@@ -184,8 +230,13 @@ void lv_draw_sw_arc(lv_draw_task_t * t, const lv_draw_arc_dsc_t * dsc, const lv_
 
     blend_area.y2 = blend_area.y1;
     for(h = 0; h < blend_h; h++) {
-        lv_memset(mask_buf, 0xff, blend_w);
-        blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, blend_area.y1, blend_w);
+        if(ring) {
+            blend_dsc.mask_res = get_ring_line(ring, &area_out, &blend_area, mask_list, mask_buf, angle_buf);
+        }
+        else {
+            lv_memset(mask_buf, 0xff, blend_w);
+            blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, blend_area.y1, blend_w);
+        }
 
         if(dsc->rounded) {
             if(blend_area.y1 >= round_area_1.y1 && blend_area.y1 <= round_area_1.y2) {
@@ -232,8 +283,10 @@ void lv_draw_sw_arc(lv_draw_task_t * t, const lv_draw_arc_dsc_t * dsc, const lv_
     }
 
     lv_free(mask_buf);
+    if(angle_buf) lv_free(angle_buf);
+    if(ring_entry) lv_cache_release(arc_cache, ring_entry, NULL);
     if(dsc->img_src) lv_image_decoder_close(&decoder_dsc);
-    if(circle_mask) lv_free(circle_mask);
+    if(circle_mask_buf) lv_free(circle_mask_buf);
 #else
     LV_LOG_WARN("Can't draw arc with LV_DRAW_SW_COMPLEX == 0");
     LV_UNUSED(center);
@@ -249,6 +302,198 @@ void lv_draw_sw_arc(lv_draw_task_t * t, const lv_draw_arc_dsc_t * dsc, const lv_
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Calculate the mask of the rounded ending of an arc
+ * @param circle_mask   store the result here. Its size should be `width * width`
+ * @param width         the arc width
+ */
+static void calc_circle_mask(lv_opa_t * circle_mask, int32_t width)
+{
+    lv_memset(circle_mask, 0xff, width * width);
+    lv_area_t circle_area = {0, 0, width - 1, width - 1};
+    lv_draw_sw_mask_radius_param_t circle_mask_param;
+    lv_draw_sw_mask_radius_init(&circle_mask_param, &circle_area, width / 2, false);
+    void * circle_mask_list[2] = {&circle_mask_param, NULL};
+
+    int32_t h;
+    lv_opa_t * circle_mask_tmp = circle_mask;
+    for(h = 0; h < width; h++) {
+        lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(circle_mask_list, circle_mask_tmp, 0, h, width);
+        if(res == LV_DRAW_SW_MASK_RES_TRANSP) {
+            lv_memzero(circle_mask_tmp, width);
+        }
+
+        circle_mask_tmp += width;
+    }
+    lv_draw_sw_mask_free_param(&circle_mask_param);
+}
+
+/**
+ * Get the ring coverage of an arc from the cache or calculate and cache it.
+ * @param area_out  the area of the arc
+ * @param dsc       the arc draw descriptor
+ * @param width     the arc width clamped to the radius
+ * @return          the cache entry of the ring or NULL if it can't be cached
+ */
+static lv_cache_entry_t * get_ring(const lv_area_t * area_out, const lv_draw_arc_dsc_t * dsc, int32_t width)
+{
+    if(arc_cache == NULL) return NULL;
+
+    /*The coverage is the same everywhere relative to the arc's area, so it's enough to store it once*/
+    arc_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.w = lv_area_get_width(area_out);
+    search_key.h = lv_area_get_height(area_out);
+    search_key.radius = dsc->radius;
+    search_key.width = dsc->width;
+    search_key.rounded = dsc->rounded;
+
+    int32_t qw = (search_key.w + 1) / 2;
+    int32_t qh = (search_key.h + 1) / 2;
+    search_key.slot.size = (size_t)qw * qh;
+    if(dsc->rounded) search_key.slot.size += (size_t)width * width;
+
+    if(search_key.slot.size > lv_cache_get_max_size(arc_cache, NULL)) return NULL;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(arc_cache, &search_key, NULL);
+    if(entry) return entry;
+
+    /*Calculate the coverage without holding the cache's lock to not block the other draw threads*/
+    lv_opa_t * buf = lv_malloc(search_key.slot.size);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return NULL;
+
+    lv_area_t ring_out = {0, 0, search_key.w - 1, search_key.h - 1};
+    lv_area_t ring_in = ring_out;
+    lv_area_increase(&ring_in, -dsc->width, -dsc->width);
+
+    void * mask_list[3] = {0};
+    lv_draw_sw_mask_radius_param_t mask_out_param;
+    lv_draw_sw_mask_radius_init(&mask_out_param, &ring_out, LV_RADIUS_CIRCLE, false);
+    mask_list[0] = &mask_out_param;
+
+    lv_draw_sw_mask_radius_param_t mask_in_param;
+    bool mask_in_param_valid = false;
+    if(lv_area_get_width(&ring_in) > 0 && lv_area_get_height(&ring_in) > 0) {
+        lv_draw_sw_mask_radius_init(&mask_in_param, &ring_in, LV_RADIUS_CIRCLE, true);
+        mask_list[1] = &mask_in_param;
+        mask_in_param_valid = true;
+    }
+
+    int32_t y;
+    lv_opa_t * buf_tmp = buf;
+    for(y = 0; y < qh; y++) {
+        lv_memset(buf_tmp, 0xff, qw);
+        lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(mask_list, buf_tmp, 0, y, qw);
+        if(res == LV_DRAW_SW_MASK_RES_TRANSP) lv_memzero(buf_tmp, qw);
+        buf_tmp += qw;
+    }
+
+    lv_draw_sw_mask_free_param(&mask_out_param);
+    if(mask_in_param_valid) lv_draw_sw_mask_free_param(&mask_in_param);
+
+    if(dsc->rounded) calc_circle_mask(buf_tmp, width);
+
+    search_key.buf = buf;
+    entry = lv_cache_acquire_or_create(arc_cache, &search_key, NULL);
+    if(entry == NULL) {
+        lv_free(buf);
+        return NULL;
+    }
+
+    /*Another thread might have added the same ring in the meantime*/
+    arc_cache_data_t * data = lv_cache_entry_get_data(entry);
+    if(data->buf != buf) lv_free(buf);
+
+    return entry;
+}
+
+/**
+ * Get the mask of a line of the arc using the cached ring coverage.
+ * The result is the same as applying the angle and radius masks on the whole line,
+ * but the radius masks are applied only where the angle mask is anti-aliased.
+ * @param ring          the cached ring
+ * @param area_out      the area of the arc
+ * @param blend_area    the line to get
+ * @param mask_list     the angle mask followed by the radius masks
+ * @param mask_buf      store the result here
+ * @param angle_buf     a buffer for the angle mask with the same size as `mask_buf`
+ * @return              the result of the masking as with `lv_draw_sw_mask_apply`
+ */
+static lv_draw_sw_mask_res_t get_ring_line(const arc_cache_data_t * ring, const lv_area_t * area_out,
+                                           const lv_area_t * blend_area, void * mask_list[], lv_opa_t * mask_buf,
+                                           lv_opa_t * angle_buf)
+{
+    int32_t len = lv_area_get_width(blend_area);
+    void * angle_mask_list[2] = {mask_list[0], NULL};
+
+    lv_memset(angle_buf, 0xff, len);
+    lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(angle_mask_list, angle_buf, blend_area->x1, blend_area->y1, len);
+    if(res == LV_DRAW_SW_MASK_RES_TRANSP) return LV_DRAW_SW_MASK_RES_TRANSP;
+
+    /*Mirror the cached quarter to the other quarters*/
+    int32_t qw = (ring->w + 1) / 2;
+    int32_t ry = blend_area->y1 - area_out->y1;
+    const lv_opa_t * ring_line = ring->buf + LV_MIN(ry, ring->h - 1 - ry) * qw;
+    int32_t rx = blend_area->x1 - area_out->x1;
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        mask_buf[i] = ring_line[LV_MIN(rx + i, ring->w - 1 - rx - i)];
+    }
+
+    if(res == LV_DRAW_SW_MASK_RES_FULL_COVER) return LV_DRAW_SW_MASK_RES_CHANGED;
+
+    /*Apply the angle mask. Where it's anti-aliased apply the radius masks on it
+     *to get exactly the same result as the masks would be applied on the whole line.*/
+    for(i = 0; i < len; i++) {
+        if(angle_buf[i] == LV_OPA_COVER) continue;
+        if(angle_buf[i] == LV_OPA_TRANSP) {
+            mask_buf[i] = LV_OPA_TRANSP;
+            continue;
+        }
+
+        int32_t aa_len = 1;
+        while(i + aa_len < len && angle_buf[i + aa_len] != LV_OPA_COVER && angle_buf[i + aa_len] != LV_OPA_TRANSP) {
+            aa_len++;
+        }
+
+        lv_draw_sw_mask_res_t aa_res = lv_draw_sw_mask_apply(&mask_list[1], &angle_buf[i], blend_area->x1 + i,
+                                                             blend_area->y1, aa_len);
+        if(aa_res == LV_DRAW_SW_MASK_RES_TRANSP) lv_memzero(&mask_buf[i], aa_len);
+        else lv_memcpy(&mask_buf[i], &angle_buf[i], aa_len);
+
+        i += aa_len - 1;
+    }
+
+    return LV_DRAW_SW_MASK_RES_CHANGED;
+}
+
+static bool arc_cache_create_cb(arc_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*The ring is already calculated and `buf` is set in the key*/
+    return data->buf != NULL;
+}
+
+static void arc_cache_free_cb(arc_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(data->buf);
+    data->buf = NULL;
+}
+
+static lv_cache_compare_res_t arc_cache_compare_cb(const arc_cache_data_t * lhs, const arc_cache_data_t * rhs)
+{
+    if(lhs->w != rhs->w) return lhs->w > rhs->w ? 1 : -1;
+    if(lhs->h != rhs->h) return lhs->h > rhs->h ? 1 : -1;
+    if(lhs->radius != rhs->radius) return lhs->radius > rhs->radius ? 1 : -1;
+    if(lhs->width != rhs->width) return lhs->width > rhs->width ? 1 : -1;
+    if(lhs->rounded != rhs->rounded) return lhs->rounded > rhs->rounded ? 1 : -1;
+
+    return 0;
+}
+
 static void add_circle(const lv_opa_t * circle_mask, const lv_area_t * blend_area, const lv_area_t * circle_area,
                        lv_opa_t * mask_buf,  int32_t width)
 {
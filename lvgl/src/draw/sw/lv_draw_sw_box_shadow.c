@@ -19,29 +19,49 @@
 #include "../../misc/lv_math.h"
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
+#include "../../misc/cache/lv_cache.h"
+#include "../../misc/cache/lv_cache_private.h"
 #include "../../stdlib/lv_string.h"
 #include "../lv_draw_mask.h"
 
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
+
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
-#endif
+#define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    /** The first element must be the slot used by the size based cache. Its size is the size of `buf`. */
+    lv_cache_slot_size_t slot;
+
+    int32_t sw;         /**< Shadow width */
+    int32_t r;          /**< Clamped radius of the shadow */
+    int32_t w;          /**< Width of the blurred rectangle (limited to the part affecting the corner) */
+    int32_t h;          /**< Height of the blurred rectangle (limited to the part affecting the corner) */
+
+    /** The corner and next to it its horizontally mirrored version. Read only once calculated. */
+    lv_opa_t * buf;
+} shadow_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+static lv_opa_t * shadow_get_corners(const lv_area_t * coords, int32_t sw, int32_t r, lv_cache_entry_t ** entry);
+static bool shadow_cache_create_cb(shadow_cache_data_t * data, void * user_data);
+static void shadow_cache_free_cb(shadow_cache_data_t * data, void * user_data);
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs, const shadow_cache_data_t * rhs);
 
 /**********************
  *  STATIC VARIABLES
@@ -55,6 +75,29 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t
  *   GLOBAL FUNCTIONS
  **********************/
 
+void lv_draw_sw_box_shadow_cache_init(void)
+{
+    const lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)shadow_cache_free_cb,
+    };
+
+    /*A corner of `LV_DRAW_SW_SHADOW_CACHE_SIZE` size with its mirrored version fits,
+     *or several smaller ones*/
+    shadow_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(shadow_cache_data_t),
+                                   2 * LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE, ops);
+    lv_cache_set_name(shadow_cache, "SW_SHADOW");
+}
+
+void lv_draw_sw_box_shadow_cache_deinit(void)
+{
+    if(shadow_cache == NULL) return;
+
+    lv_cache_destroy(shadow_cache, NULL);
+    shadow_cache = NULL;
+}
+
 void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
 {
     /*Calculate the rectangle which is blurred to get the shadow in `shadow_area`*/
@@ -97,34 +140,11 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->width  + r_sh;
 
-    lv_opa_t * sh_buf;
-
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        LV_ASSERT_MALLOC(sh_buf);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        LV_ASSERT_MALLOC(sh_buf);
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
-    }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    LV_ASSERT_MALLOC(sh_buf);
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    /*Get the right corner and its mirrored version for the left side.
+     *If it's cached it's shared with the other draw threads so it's only read.*/
+    lv_cache_entry_t * sh_entry = NULL;
+    lv_opa_t * sh_corners = shadow_get_corners(&core_area, dsc->width, r_sh, &sh_entry);
+    const lv_opa_t * sh_buf = sh_corners;
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -141,7 +161,7 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     lv_opa_t * mask_buf = lv_malloc(lv_area_get_width(&shadow_area));
     lv_area_t blend_area;
     lv_area_t clip_area_sub;
-    lv_opa_t * sh_buf_tmp;
+    const lv_opa_t * sh_buf_tmp;
     int32_t y;
     bool simple_sub;
 
@@ -382,22 +402,8 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
         }
     }
 
-    /*Mirror the shadow corner buffer horizontally*/
-    sh_buf_tmp = sh_buf ;
-    for(y = 0; y < corner_size; y++) {
-        int32_t x;
-        lv_opa_t * start = sh_buf_tmp;
-        lv_opa_t * end = sh_buf_tmp + corner_size - 1;
-        for(x = 0; x < corner_size / 2; x++) {
-            lv_opa_t tmp = *start;
-            *start = *end;
-            *end = tmp;
-
-            start++;
-            end--;
-        }
-        sh_buf_tmp += corner_size;
-    }
+    /*Use the horizontally mirrored shadow corner from now*/
+    sh_buf = sh_corners + corner_size * corner_size;
 
     /*Left side*/
     blend_area.x1 = shadow_area.x1;
@@ -555,7 +561,8 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     if(!simple) {
         lv_draw_sw_mask_free_param(&mask_rout_param);
     }
-    lv_free(sh_buf);
+    if(sh_entry) lv_cache_release(shadow_cache, sh_entry, NULL);
+    else lv_free(sh_corners);
     lv_free(mask_buf);
 }
 
@@ -563,6 +570,97 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the blurred right corner and its horizontally mirrored version from the cache
+ * or calculate them. The corners are stored next to each other in a `(sw + r)^2 * 2` sized buffer.
+ * @param coords    coordinates of the blurred rectangle
+ * @param sw        shadow width
+ * @param r         radius
+ * @param entry     store the cache entry here to release it later.
+ *                  NULL if the corners were not cached and the returned buffer needs to be freed.
+ * @return          the corner buffer
+ */
+static lv_opa_t * shadow_get_corners(const lv_area_t * coords, int32_t sw, int32_t r, lv_cache_entry_t ** entry)
+{
+    int32_t size = sw + r;
+
+    /*The rectangle's size matters only if it's small enough to affect the corner.
+     *(The spread is already added to `coords`.)*/
+    shadow_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.sw = sw;
+    search_key.r = r;
+    search_key.w = LV_MIN(lv_area_get_width(coords), 2 * size);
+    search_key.h = LV_MIN(lv_area_get_height(coords), 2 * size);
+    search_key.slot.size = (size_t)size * size * 2;
+
+    *entry = NULL;
+    bool cacheable = shadow_cache && search_key.slot.size <= lv_cache_get_max_size(shadow_cache, NULL);
+    if(cacheable) {
+        *entry = lv_cache_acquire(shadow_cache, &search_key, NULL);
+        if(*entry) {
+            shadow_cache_data_t * data = lv_cache_entry_get_data(*entry);
+            return data->buf;
+        }
+    }
+
+    /*Calculate the corner without holding the cache's lock to not block the other draw threads.
+     *A larger buffer is required for calculation which has room for the mirrored corner too.*/
+    lv_opa_t * buf = lv_malloc(size * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(buf);
+    shadow_draw_corner_buf(coords, (uint16_t *)buf, sw, r);
+
+    int32_t y;
+    const lv_opa_t * src = buf;
+    lv_opa_t * dest = buf + size * size;
+    for(y = 0; y < size; y++) {
+        int32_t x;
+        for(x = 0; x < size; x++) {
+            dest[x] = src[size - 1 - x];
+        }
+        src += size;
+        dest += size;
+    }
+
+    if(cacheable) {
+        search_key.buf = buf;
+        *entry = lv_cache_acquire_or_create(shadow_cache, &search_key, NULL);
+        if(*entry) {
+            shadow_cache_data_t * data = lv_cache_entry_get_data(*entry);
+            /*Another thread might have added the same corner in the meantime*/
+            if(data->buf != buf) lv_free(buf);
+            return data->buf;
+        }
+    }
+
+    return buf;
+}
+
+static bool shadow_cache_create_cb(shadow_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*The corners are already calculated and `buf` is set in the key*/
+    return data->buf != NULL;
+}
+
+static void shadow_cache_free_cb(shadow_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(data->buf);
+    data->buf = NULL;
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs, const shadow_cache_data_t * rhs)
+{
+    if(lhs->sw != rhs->sw) return lhs->sw > rhs->sw ? 1 : -1;
+    if(lhs->r != rhs->r) return lhs->r > rhs->r ? 1 : -1;
+    if(lhs->w != rhs->w) return lhs->w > rhs->w ? 1 : -1;
+    if(lhs->h != rhs->h) return lhs->h > rhs->h ? 1 : -1;
+
+    return 0;
+}
+
 /**
  * Calculate a blurred corner
  * @param coords Coordinates of the shadow
@@ -16,6 +16,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_DRAW
+
 #define GRAD_CM(r,g,b) lv_color_make(r,g,b)
 #define GRAD_CONV(t, x) t = x
 
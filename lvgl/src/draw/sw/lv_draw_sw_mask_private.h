@@ -31,9 +31,7 @@ typedef struct  {
     lv_opa_t * cir_opa;         /**< Opacity of values on the circumference of an 1/4 circle */
     uint16_t * x_start_on_y;    /**< The x coordinate of the circle for each y value */
     uint16_t * opa_start_on_y;  /**< The index of `cir_opa` for each y value */
-    int32_t life;               /**< How many times the entry way used */
-    uint32_t used_cnt;          /**< Like a semaphore to count the referencing masks */
-    int32_t radius;             /**< The radius of the entry */
+    int32_t radius;             /**< The radius of the entry. It's the key in the circle cache. */
 } lv_draw_sw_mask_radius_circle_dsc_t;
 
 struct _lv_draw_sw_mask_common_dsc_t {
@@ -106,6 +104,9 @@ struct _lv_draw_sw_mask_radius_param_t {
     } cfg;
 
     lv_draw_sw_mask_radius_circle_dsc_t * circle;
+
+    /** The circle cache entry of `circle`, or NULL if `circle` is allocated only for this mask */
+    lv_cache_entry_t * circle_entry;
 };
 
 struct _lv_draw_sw_mask_fade_param_t {
@@ -132,18 +133,10 @@ struct _lv_draw_sw_mask_map_param_t {
     } cfg;
 };
 
-typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
-/**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
- */
-void lv_draw_sw_mask_cleanup(void);
-
 /**********************
  *      MACROS
  **********************/
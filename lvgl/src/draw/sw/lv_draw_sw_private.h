@@ -50,18 +50,34 @@ struct _lv_draw_sw_unit_t {
 #endif
 };
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
-} lv_draw_sw_shadow_cache_t;
-#endif
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_DRAW_SW_COMPLEX
+/**
+ * Create the cache of the blurred shadow corners.
+ * Its size is set by `LV_DRAW_SW_SHADOW_CACHE_SIZE`.
+ */
+void lv_draw_sw_box_shadow_cache_init(void);
+
+/**
+ * Delete the cache of the blurred shadow corners
+ */
+void lv_draw_sw_box_shadow_cache_deinit(void);
+
+/**
+ * Create the cache of the arcs' ring coverage.
+ * Its size is set by `LV_DRAW_SW_ARC_CACHE_SIZE`.
+ */
+void lv_draw_sw_arc_cache_init(void);
+
+/**
+ * Delete the cache of the arcs' ring coverage
+ */
+void lv_draw_sw_arc_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
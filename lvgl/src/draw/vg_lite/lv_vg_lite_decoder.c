@@ -20,6 +20,8 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_IMAGE
 
 #define DECODER_NAME    "VG_LITE"
 
@@ -24,6 +24,8 @@
 
 #include "../../../stdlib/lv_sprintf.h"
 #include "../../../draw/lv_draw_buf.h"
+#include "../../../display/lv_display_private.h"
+#include "../../../misc/lv_area_private.h"
 
 #if LV_LINUX_DRM_GBM_BUFFERS
 
@@ -44,7 +46,11 @@
     #error LV_COLOR_DEPTH not supported
 #endif
 
-#define BUFFER_CNT 2
+/*A third buffer is used only in partial mode as LVGL can render directly into two buffers*/
+#define BUFFER_CNT_MAX 3
+
+/*Number of damage rectangles passed to the kernel in one commit*/
+#define DAMAGE_CNT LV_INV_BUF_SIZE
 
 /**********************
  *      TYPEDEFS
@@ -56,6 +62,10 @@ typedef struct {
     unsigned long int size;
     uint8_t * map;
     uint32_t fb_handle;
+    uint32_t damage_cnt;
+    struct drm_mode_rect damage[DAMAGE_CNT];    /*Areas changed by the frame in this buffer*/
+    uint32_t stale_cnt;
+    struct drm_mode_rect stale[DAMAGE_CNT];     /*Areas changed by newer frames in other buffers*/
 } drm_buffer_t;
 
 typedef struct {
@@ -78,8 +88,16 @@ typedef struct {
     drmModePropertyPtr plane_props[128];
     drmModePropertyPtr crtc_props[128];
     drmModePropertyPtr conn_props[128];
-    drm_buffer_t drm_bufs[BUFFER_CNT];
-    drm_buffer_t * act_buf;
+    drm_buffer_t drm_bufs[BUFFER_CNT_MAX];
+    uint32_t buf_cnt;
+    drm_buffer_t * act_buf;             /*Being rendered*/
+    drm_buffer_t * front_buf;           /*On the screen*/
+    drm_buffer_t * pending_buf;         /*Committed, waiting for the page flip*/
+    drm_buffer_t * queued_buf;          /*Rendered, waiting for the pending page flip to be committed*/
+    drm_buffer_t * latest_buf;          /*Contains the newest frame*/
+    bool damage_clips_supported;
+    uint64_t vblank_time_us;
+    uint32_t vblank_sequence;
 } drm_dev_t;
 
 /**********************
@@ -107,6 +125,14 @@ static int drm_setup_buffers(drm_dev_t * drm_dev);
 static void drm_flush_wait(lv_display_t * drm_dev);
 static void drm_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void drm_dmabuf_set_active_buf(lv_event_t * event);
+static void drm_buf_begin_cpu_access(drm_buffer_t * buf);
+static void drm_commit(drm_dev_t * drm_dev, drm_buffer_t * buf);
+static void drm_wait_event(drm_dev_t * drm_dev, int timeout);
+static drm_buffer_t * drm_acquire_buf(drm_dev_t * drm_dev);
+static void drm_add_rect(struct drm_mode_rect * rects, uint32_t * cnt, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+static void drm_add_damage(drm_dev_t * drm_dev, const lv_area_t * area);
+static void drm_copy_forward(lv_display_t * disp, drm_dev_t * drm_dev);
+static void drm_copy_area(lv_display_t * disp, drm_dev_t * drm_dev, const lv_area_t * area, const uint8_t * px_map);
 
 static uint32_t tick_get_cb(void);
 
@@ -151,6 +177,11 @@ lv_display_t * lv_linux_drm_create(void)
         return NULL;
     }
     drm_dev->fd = -1;
+    drm_dev->buf_cnt = 2;
+    if(LV_LINUX_DRM_TRIPLE_BUFFER) {
+        if(LV_LINUX_DRM_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) drm_dev->buf_cnt = 3;
+        else LV_LOG_WARN("Triple buffering requires partial render mode, using two buffers");
+    }
     lv_display_set_driver_data(disp, drm_dev);
     lv_display_set_flush_wait_cb(disp, drm_flush_wait);
     lv_display_set_flush_cb(disp, drm_flush);
@@ -159,6 +190,33 @@ lv_display_t * lv_linux_drm_create(void)
     return disp;
 }
 
+int lv_linux_drm_get_fd(lv_display_t * disp)
+{
+    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
+    return drm_dev->fd;
+}
+
+void lv_linux_drm_handle_events(lv_display_t * disp)
+{
+    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
+    if(drm_dev->fd < 0) return;
+
+    drm_wait_event(drm_dev, 0);
+}
+
+uint32_t lv_linux_drm_get_vblank(lv_display_t * disp, uint64_t * time_us, uint32_t * sequence)
+{
+    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
+
+    if(time_us) *time_us = drm_dev->vblank_time_us;
+    if(sequence) *sequence = drm_dev->vblank_sequence;
+
+    /*clock is in kHz*/
+    const drmModeModeInfo * mode = &drm_dev->mode;
+    if(mode->clock == 0) return 0;
+    return (uint32_t)((uint64_t)mode->htotal * mode->vtotal * 1000 / mode->clock);
+}
+
 /* Called by LVGL when there is something that needs redrawing
  * it sets the active buffer. if GBM buffers are used, it issues a DMA_BUF_SYNC
  * ioctl call to lock the buffer for CPU access, the buffer is unlocked just
@@ -169,7 +227,7 @@ static void drm_dmabuf_set_active_buf(lv_event_t * event)
     drm_dev_t * drm_dev;
     lv_display_t * disp;
     lv_draw_buf_t * act_buf;
-    int i;
+    uint32_t i;
 
     disp = (lv_display_t *) lv_event_get_current_target(event);
     drm_dev = (drm_dev_t *) lv_display_get_driver_data(disp);
@@ -177,26 +235,16 @@ static void drm_dmabuf_set_active_buf(lv_event_t * event)
 
     if(drm_dev->act_buf == NULL) {
 
-        for(i = 0; i < BUFFER_CNT; i++) {
+        for(i = 0; i < drm_dev->buf_cnt; i++) {
             if(act_buf->unaligned_data == drm_dev->drm_bufs[i].map) {
                 drm_dev->act_buf = &drm_dev->drm_bufs[i];
-                LV_LOG_TRACE("Set active buffer idx: %d", i);
+                LV_LOG_TRACE("Set active buffer idx: %" LV_PRIu32, i);
                 break;
             }
         }
 
-
-#if LV_LINUX_DRM_GBM_BUFFERS
-
-        struct dma_buf_sync sync_req;
-        sync_req.flags = DMA_BUF_SYNC_START | DMA_BUF_SYNC_RW;
-        int res;
-
-        if((res = ioctl(drm_dev->act_buf->handle, DMA_BUF_IOCTL_SYNC, &sync_req)) != 0) {
-            LV_LOG_ERROR("Failed to start DMA-BUF R/W SYNC res: %d", res);
-        }
-#endif
-
+        drm_dev->act_buf->damage_cnt = 0;
+        drm_buf_begin_cpu_access(drm_dev->act_buf);
     }
     else {
 
@@ -231,18 +279,34 @@ void lv_linux_drm_set_file(lv_display_t * disp, const char * file, int64_t conne
     int32_t ver_res = drm_dev->height;
     int32_t width = drm_dev->mmWidth;
 
-    size_t buf_size = LV_MIN(drm_dev->drm_bufs[1].size, drm_dev->drm_bufs[0].size);
     /* Resolution must be set first because if the screen is smaller than the size passed
      * to lv_display_create then the buffers aren't big enough for LV_DISPLAY_RENDER_MODE_DIRECT.
      */
     lv_display_set_resolution(disp, hor_res, ver_res);
-    lv_display_set_buffers(disp, drm_dev->drm_bufs[1].map, drm_dev->drm_bufs[0].map, buf_size,
-                           LV_DISPLAY_RENDER_MODE_DIRECT);
+
+    if(LV_LINUX_DRM_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        lv_draw_buf_t * draw_buf = lv_draw_buf_create(hor_res, LV_LINUX_DRM_BUFFER_SIZE,
+                                                      lv_display_get_color_format(disp), LV_STRIDE_AUTO);
+        if(draw_buf == NULL) {
+            LV_LOG_ERROR("Failed to allocate the draw buffer");
+            return;
+        }
+        lv_display_set_draw_buffers(disp, draw_buf, NULL);
+        lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    }
+    else {
+        size_t buf_size = LV_MIN(drm_dev->drm_bufs[1].size, drm_dev->drm_bufs[0].size);
+        lv_display_set_buffers_with_stride(disp, drm_dev->drm_bufs[1].map, drm_dev->drm_bufs[0].map, buf_size,
+                                           drm_dev->drm_bufs[0].pitch, LV_DISPLAY_RENDER_MODE_DIRECT);
+    }
 
 
     /* Set the handler that is called before a redraw occurs to set the active buffer/plane
-     * when GBM buffers are used the DMA_BUF_SYNC_START is issued there */
-    lv_display_add_event_cb(disp, drm_dmabuf_set_active_buf, LV_EVENT_REFR_START, drm_dev);
+     * when GBM buffers are used the DMA_BUF_SYNC_START is issued there.
+     * In partial mode the DRM buffer is acquired on the first flush of a frame. */
+    if(LV_LINUX_DRM_RENDER_MODE != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        lv_display_add_event_cb(disp, drm_dmabuf_set_active_buf, LV_EVENT_REFR_START, drm_dev);
+    }
 
     if(width) {
         lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 25400, width * 1000));
@@ -305,15 +369,28 @@ static void page_flip_handler(int fd, unsigned int sequence, unsigned int tv_sec
                               void * user_data)
 {
     LV_UNUSED(fd);
-    LV_UNUSED(sequence);
-    LV_UNUSED(tv_sec);
-    LV_UNUSED(tv_usec);
     LV_LOG_TRACE("flip");
     drm_dev_t * drm_dev = user_data;
     if(drm_dev->req) {
         drmModeAtomicFree(drm_dev->req);
         drm_dev->req = NULL;
     }
+
+    /*The timestamp is CLOCK_MONOTONIC, the same clock as the tick*/
+    drm_dev->vblank_time_us = (uint64_t)tv_sec * 1000000 + tv_usec;
+    drm_dev->vblank_sequence = sequence;
+
+    if(drm_dev->pending_buf) {
+        drm_dev->front_buf = drm_dev->pending_buf;
+        drm_dev->pending_buf = NULL;
+    }
+
+    /*A frame was finished while waiting for this flip, show it on the next vblank*/
+    if(drm_dev->queued_buf) {
+        drm_buffer_t * buf = drm_dev->queued_buf;
+        drm_dev->queued_buf = NULL;
+        drm_commit(drm_dev, buf);
+    }
 }
 
 static int drm_get_plane_props(drm_dev_t * drm_dev)
@@ -441,6 +518,7 @@ static int drm_dmabuf_set_plane(drm_dev_t * drm_dev, drm_buffer_t * buf)
     int ret;
     static int first = 1;
     uint32_t flags = DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_ATOMIC_NONBLOCK;
+    uint32_t damage_blob_id = 0;
 
 #if LV_LINUX_DRM_GBM_BUFFERS
 
@@ -478,10 +556,29 @@ static int drm_dmabuf_set_plane(drm_dev_t * drm_dev, drm_buffer_t * buf)
     drm_add_plane_property(drm_dev, "CRTC_W", drm_dev->width);
     drm_add_plane_property(drm_dev, "CRTC_H", drm_dev->height);
 
+    /* Tell the kernel which areas have changed, so drivers which upload the framebuffer
+     * (e.g. SPI panels, USB displays, virtual displays) can transfer only these areas.
+     * Without this property the whole buffer is considered to be damaged. */
+    if(drm_dev->damage_clips_supported && buf->damage_cnt > 0) {
+        if(drmModeCreatePropertyBlob(drm_dev->fd, buf->damage, sizeof(buf->damage[0]) * buf->damage_cnt,
+                                     &damage_blob_id) == 0) {
+            drm_add_plane_property(drm_dev, "FB_DAMAGE_CLIPS", damage_blob_id);
+        }
+        else {
+            LV_LOG_WARN("Failed to create FB_DAMAGE_CLIPS blob, the whole buffer will be updated");
+            damage_blob_id = 0;
+        }
+    }
+
     ret = drmModeAtomicCommit(drm_dev->fd, drm_dev->req, flags, drm_dev);
+
+    /* The atomic state holds a reference to the blob, it can be released right away */
+    if(damage_blob_id) drmModeDestroyPropertyBlob(drm_dev->fd, damage_blob_id);
+
     if(ret) {
         LV_LOG_ERROR("drmModeAtomicCommit failed: %s (%d)", strerror(errno), errno);
         drmModeAtomicFree(drm_dev->req);
+        drm_dev->req = NULL;
         return ret;
     }
 
@@ -795,6 +892,9 @@ static int drm_setup(drm_dev_t * drm_dev, const char * device_path, int64_t conn
         goto err;
     }
 
+    drm_dev->damage_clips_supported = get_plane_property_id(drm_dev, "FB_DAMAGE_CLIPS") != 0;
+    LV_LOG_INFO("drm: FB_DAMAGE_CLIPS is %ssupported", drm_dev->damage_clips_supported ? "" : "not ");
+
     drm_dev->drm_event_ctx.version = DRM_EVENT_CONTEXT_VERSION;
     drm_dev->drm_event_ctx.page_flip_handler = page_flip_handler;
     drm_dev->fourcc = fourcc;
@@ -981,76 +1081,272 @@ static int create_gbm_buffer(drm_dev_t * drm_dev, drm_buffer_t * buf)
 static int drm_setup_buffers(drm_dev_t * drm_dev)
 {
     int ret;
+    uint32_t i;
 
+    for(i = 0; i < drm_dev->buf_cnt; i++) {
 #if LV_LINUX_DRM_GBM_BUFFERS
 
-    ret = create_gbm_buffer(drm_dev, &drm_dev->drm_bufs[0]);
-    if(ret < 0) {
-        return ret;
-    }
-
-    ret = create_gbm_buffer(drm_dev, &drm_dev->drm_bufs[1]);
-    if(ret < 0) {
-        return ret;
-    }
+        ret = create_gbm_buffer(drm_dev, &drm_dev->drm_bufs[i]);
+        if(ret < 0) {
+            return ret;
+        }
 
 #else
 
-    /* Use dumb buffers */
-    ret = drm_allocate_dumb(drm_dev, &drm_dev->drm_bufs[0]);
-    if(ret)
-        return ret;
-
-    ret = drm_allocate_dumb(drm_dev, &drm_dev->drm_bufs[1]);
-    if(ret)
-        return ret;
+        /* Use dumb buffers */
+        ret = drm_allocate_dumb(drm_dev, &drm_dev->drm_bufs[i]);
+        if(ret)
+            return ret;
 
 #endif
+    }
 
     return 0;
 }
 
-static void drm_flush_wait(lv_display_t * disp)
+/* Wait at most `timeout` ms (-1: forever) for DRM events and dispatch them.
+ * Returns without waiting if there is nothing to wait for. */
+static void drm_wait_event(drm_dev_t * drm_dev, int timeout)
 {
-    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
-
     struct pollfd pfd;
     pfd.fd = drm_dev->fd;
     pfd.events = POLLIN;
 
+    if(drm_dev->req == NULL) return;
+
+    int ret;
+    do {
+        ret = poll(&pfd, 1, timeout);
+    } while(ret == -1 && errno == EINTR);
+
+    if(ret > 0) {
+        drmHandleEvent(drm_dev->fd, &drm_dev->drm_event_ctx);
+    }
+    else if(ret < 0) {
+        LV_LOG_ERROR("poll failed: %s", strerror(errno));
+        /*Don't wait forever for a flip that will never be reported*/
+        drmModeAtomicFree(drm_dev->req);
+        drm_dev->req = NULL;
+        drm_dev->pending_buf = NULL;
+    }
+}
+
+static void drm_flush_wait(lv_display_t * disp)
+{
+    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
+
     while(drm_dev->req) {
-        int ret;
-        do {
-            ret = poll(&pfd, 1, -1);
-        } while(ret == -1 && errno == EINTR);
+        drm_wait_event(drm_dev, -1);
+    }
+}
+
+/* Find a buffer which is neither scanned out, nor waiting to be shown.
+ * With two buffers it is available only after the pending page flip,
+ * with three buffers rendering can go on while a flip is pending. */
+static drm_buffer_t * drm_acquire_buf(drm_dev_t * drm_dev)
+{
+    while(1) {
+        uint32_t i;
+        for(i = 0; i < drm_dev->buf_cnt; i++) {
+            drm_buffer_t * buf = &drm_dev->drm_bufs[i];
+            if(buf != drm_dev->front_buf && buf != drm_dev->pending_buf && buf != drm_dev->queued_buf) {
+                return buf;
+            }
+        }
 
-        if(ret > 0)
-            drmHandleEvent(drm_dev->fd, &drm_dev->drm_event_ctx);
+        if(drm_dev->req == NULL) {
+            /*Nothing will free a buffer*/
+            LV_LOG_WARN("No free buffer");
+            drm_dev->queued_buf = NULL;
+        }
         else {
-            LV_LOG_ERROR("poll failed: %s", strerror(errno));
-            return;
+            drm_wait_event(drm_dev, -1);
         }
     }
 }
 
-static void drm_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+static void drm_buf_begin_cpu_access(drm_buffer_t * buf)
 {
+#if LV_LINUX_DRM_GBM_BUFFERS
 
-    if(!lv_display_flush_is_last(disp)) return;
+    struct dma_buf_sync sync_req;
+    sync_req.flags = DMA_BUF_SYNC_START | DMA_BUF_SYNC_RW;
+    int res;
 
-    LV_UNUSED(area);
-    LV_UNUSED(px_map);
-    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
+    if((res = ioctl(buf->handle, DMA_BUF_IOCTL_SYNC, &sync_req)) != 0) {
+        LV_LOG_ERROR("Failed to start DMA-BUF R/W SYNC res: %d", res);
+    }
 
-    LV_ASSERT(drm_dev->act_buf != NULL);
+#else
+    LV_UNUSED(buf);
+#endif
+}
 
-    if(drm_dmabuf_set_plane(drm_dev, drm_dev->act_buf)) {
+static void drm_commit(drm_dev_t * drm_dev, drm_buffer_t * buf)
+{
+    if(drm_dmabuf_set_plane(drm_dev, buf)) {
         LV_LOG_ERROR("Flush fail");
         return;
     }
 
+    drm_dev->pending_buf = buf;
+}
+
+static void drm_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
+
+    if(LV_LINUX_DRM_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        /* LVGL renders into its own buffer, so the DRM buffer is needed only now.
+         * Bring it up to date with the newest frame before copying the new areas. */
+        if(drm_dev->act_buf == NULL) {
+            drm_dev->act_buf = drm_acquire_buf(drm_dev);
+            drm_buf_begin_cpu_access(drm_dev->act_buf);
+            drm_copy_forward(disp, drm_dev);
+        }
+
+        drm_copy_area(disp, drm_dev, area, px_map);
+    }
+
+    LV_ASSERT(drm_dev->act_buf != NULL);
+
+    drm_add_damage(drm_dev, area);
+
+    /* The draw buffer can be reused right away in partial mode, and in direct mode
+     * `drm_flush_wait` will wait for the page flip */
+    if(LV_LINUX_DRM_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        lv_display_flush_ready(disp);
+    }
+
+    if(!lv_display_flush_is_last(disp)) return;
+
+    drm_buffer_t * buf = drm_dev->act_buf;
     drm_dev->act_buf = NULL;
 
+    /*The other buffers miss the areas changed in this frame (LVGL syncs them itself in direct mode)*/
+    if(LV_LINUX_DRM_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        uint32_t i, j;
+        for(i = 0; i < drm_dev->buf_cnt; i++) {
+            drm_buffer_t * other = &drm_dev->drm_bufs[i];
+            if(other == buf) continue;
+            for(j = 0; j < buf->damage_cnt; j++) {
+                const struct drm_mode_rect * rect = &buf->damage[j];
+                drm_add_rect(other->stale, &other->stale_cnt, rect->x1, rect->y1, rect->x2, rect->y2);
+            }
+        }
+    }
+    drm_dev->latest_buf = buf;
+
+    if(drm_dev->req == NULL) {
+        drm_commit(drm_dev, buf);
+    }
+    else {
+        /*Don't wait for the page flip, commit the frame from `page_flip_handler`*/
+        drm_dev->queued_buf = buf;
+    }
+}
+
+/* Add a rectangle to a list, joining it with the last one if possible.
+ * The x2 and y2 of drm_mode_rect are exclusive. */
+static void drm_add_rect(struct drm_mode_rect * rects, uint32_t * cnt, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    if(*cnt > 0) {
+        struct drm_mode_rect * last = &rects[*cnt - 1];
+
+        /* In partial mode an area is flushed in horizontal stripes, join them */
+        if(last->x1 == x1 && last->x2 == x2 && last->y2 == y1) {
+            last->y2 = y2;
+            return;
+        }
+
+        /* Out of rectangles: grow the last one to cover the new area too */
+        if(*cnt == DAMAGE_CNT) {
+            last->x1 = LV_MIN(last->x1, x1);
+            last->y1 = LV_MIN(last->y1, y1);
+            last->x2 = LV_MAX(last->x2, x2);
+            last->y2 = LV_MAX(last->y2, y2);
+            return;
+        }
+    }
+
+    struct drm_mode_rect * rect = &rects[*cnt];
+    rect->x1 = x1;
+    rect->y1 = y1;
+    rect->x2 = x2;
+    rect->y2 = y2;
+    (*cnt)++;
+}
+
+/* Collect the flushed areas of the active buffer for FB_DAMAGE_CLIPS */
+static void drm_add_damage(drm_dev_t * drm_dev, const lv_area_t * area)
+{
+    drm_buffer_t * buf = drm_dev->act_buf;
+    int32_t x1 = LV_MAX(area->x1, 0);
+    int32_t y1 = LV_MAX(area->y1, 0);
+    int32_t x2 = LV_MIN(area->x2 + 1, (int32_t)drm_dev->width);
+    int32_t y2 = LV_MIN(area->y2 + 1, (int32_t)drm_dev->height);
+    if(x1 >= x2 || y1 >= y2) return;
+
+    drm_add_rect(buf->damage, &buf->damage_cnt, x1, y1, x2, y2);
+}
+
+/* In partial mode only the changed areas are rendered into the active buffer, so bring the
+ * areas changed by the newer frames over from the buffer with the newest frame. Areas which
+ * will be fully redrawn anyway are skipped. */
+static void drm_copy_forward(lv_display_t * disp, drm_dev_t * drm_dev)
+{
+    drm_buffer_t * src = drm_dev->latest_buf;
+    drm_buffer_t * dest = drm_dev->act_buf;
+
+    dest->damage_cnt = 0;
+    if(src == NULL || src == dest || dest->stale_cnt == 0) {
+        dest->stale_cnt = 0;
+        return;
+    }
+
+    uint32_t px_size = LV_COLOR_DEPTH / 8;
+    uint32_t i;
+    for(i = 0; i < dest->stale_cnt; i++) {
+        const struct drm_mode_rect * rect = &dest->stale[i];
+        lv_area_t area = {rect->x1, rect->y1, rect->x2 - 1, rect->y2 - 1};
+
+        /* Moved content can come from anywhere, so keep everything in that case */
+        bool redrawn = false;
+        if(disp->move_p == 0) {
+            uint32_t j;
+            for(j = 0; j < disp->inv_p && !redrawn; j++) {
+                redrawn = lv_area_is_in(&area, &disp->inv_areas[j], 0);
+            }
+        }
+        if(redrawn) continue;
+
+        uint32_t offset = rect->y1 * src->pitch + rect->x1 * px_size;
+        uint32_t line_size = (rect->x2 - rect->x1) * px_size;
+        int32_t y;
+        for(y = rect->y1; y < rect->y2; y++) {
+            lv_memcpy(dest->map + offset, src->map + offset, line_size);
+            offset += src->pitch;
+        }
+    }
+
+    dest->stale_cnt = 0;
+}
+
+/* Copy a rendered area from the draw buffer into the active DRM buffer */
+static void drm_copy_area(lv_display_t * disp, drm_dev_t * drm_dev, const lv_area_t * area, const uint8_t * px_map)
+{
+    drm_buffer_t * dest = drm_dev->act_buf;
+    uint32_t px_size = LV_COLOR_DEPTH / 8;
+    int32_t w = lv_area_get_width(area);
+    uint32_t src_stride = lv_draw_buf_width_to_stride(w, lv_display_get_color_format(disp));
+    uint8_t * dest_p = dest->map + area->y1 * dest->pitch + area->x1 * px_size;
+    int32_t y;
+
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(dest_p, px_map, w * px_size);
+        dest_p += dest->pitch;
+        px_map += src_stride;
+    }
 }
 
 static uint32_t tick_get_cb(void)
@@ -33,6 +33,32 @@ lv_display_t * lv_linux_drm_create(void);
 
 void lv_linux_drm_set_file(lv_display_t * disp, const char * file, int64_t connector_id);
 
+/**
+ * Get the file descriptor of the DRM device.
+ * Poll it in the main loop to be woken up when a page flip completes.
+ * @param disp      a display created with `lv_linux_drm_create`
+ * @return          the file descriptor or -1 if the device is not opened
+ */
+int lv_linux_drm_get_fd(lv_display_t * disp);
+
+/**
+ * Process the page flip events without blocking.
+ * Call it when the file descriptor of the DRM device becomes readable.
+ * @param disp      a display created with `lv_linux_drm_create`
+ */
+void lv_linux_drm_handle_events(lv_display_t * disp);
+
+/**
+ * Get the time of the last vblank at which a new frame was shown.
+ * The timestamp is on the same CLOCK_MONOTONIC clock as LVGL's tick,
+ * so the next vblank can be predicted by adding the refresh period.
+ * @param disp      a display created with `lv_linux_drm_create`
+ * @param time_us   store the timestamp in microseconds here (can be NULL)
+ * @param sequence  store the vblank counter here (can be NULL)
+ * @return          the refresh period of the display mode in microseconds, 0 if unknown
+ */
+uint32_t lv_linux_drm_get_vblank(lv_display_t * disp, uint64_t * time_us, uint32_t * sequence);
+
 /**********************
  *      MACROS
  **********************/
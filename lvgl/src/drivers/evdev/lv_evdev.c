@@ -16,7 +16,12 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <sys/param.h> /*To detect BSD*/
+#if LV_EVDEV_USE_THREAD
+    #include <poll.h>
+    #include <pthread.h>
+#endif
 #ifdef BSD
     #include <dev/evdev/input.h>
 #else
@@ -28,10 +33,16 @@
 #include "../../misc/lv_assert.h"
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_async.h"
+#include "../../tick/lv_tick.h"
 #include "../../stdlib/lv_mem.h"
 #include "../../stdlib/lv_string.h"
 #include "../../display/lv_display.h"
 #include "../../widgets/image/lv_image.h"
+#include "../../osal/lv_os.h"
+
+#if LV_EVDEV_USE_THREAD && LV_USE_OS == LV_OS_NONE
+    #error "LV_EVDEV_USE_THREAD requires LV_USE_OS"
+#endif
 
 /*********************
  *      DEFINES
@@ -42,11 +53,26 @@
 #define EVDEV_DISCOVERY_PATH_BUF_SIZE 32
 #define REL_XY_MASK ((1 << REL_X) | (1 << REL_Y))
 #define ABS_XY_MASK ((1 << ABS_X) | (1 << ABS_Y))
+/*Older events are assumed to be from a clock other than the driver's*/
+#define EVENT_AGE_MAX_US (10 * 1000000LL)
+/*Number of samples the reader thread can queue between two reads of LVGL*/
+#define EVDEV_SAMPLE_QUEUE_SIZE 16
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_EVDEV_USE_THREAD
+/*The state of the device at an EV_SYN boundary*/
+typedef struct {
+    int root_x;
+    int root_y;
+    int key;
+    lv_indev_state_t state;
+    struct input_event first_in; /*The oldest event of the sample, for its timestamp*/
+} lv_evdev_sample_t;
+#endif
+
 typedef struct {
     /*Device*/
     int fd;
@@ -65,6 +91,22 @@ typedef struct {
     int key;
     lv_indev_state_t state;
     bool deleting;
+    clockid_t clock_id; /*The clock of the event timestamps*/
+#if LV_EVDEV_USE_THREAD
+    /*Reader thread*/
+    lv_indev_t * indev;
+    pthread_t thread;
+    bool first_in_valid;
+    struct input_event first_in; /*The oldest event since the last EV_SYN*/
+    pthread_mutex_t lock;  /*Protects the fields below*/
+    int stop_pipe[2];      /*Written to ask the thread to quit*/
+    bool stop;             /*The indev was deleted*/
+    bool in_lvgl;          /*The thread waits for or holds `lv_lock()`*/
+    lv_evdev_sample_t queue[EVDEV_SAMPLE_QUEUE_SIZE];
+    uint32_t queue_start;
+    uint32_t queue_cnt;
+    lv_evdev_sample_t last; /*The most recently reported sample*/
+#endif
 } lv_evdev_t;
 
 #ifndef BSD
@@ -146,6 +188,226 @@ static void _evdev_async_delete_cb(void * user_data)
     lv_indev_delete(indev);
 }
 
+/**
+ * Convert the kernel timestamp of an event to `lv_tick_get()` time
+ * @return the time of the event or 0 if it's unknown
+ */
+static uint32_t _evdev_event_to_tick(const lv_evdev_t * dsc, const struct input_event * in)
+{
+    struct timespec now;
+    if(clock_gettime(dsc->clock_id, &now) != 0) return 0;
+
+#ifdef input_event_sec
+    long long sec = in->input_event_sec;
+    long long usec = in->input_event_usec;
+#else
+    long long sec = in->time.tv_sec;
+    long long usec = in->time.tv_usec;
+#endif
+    long long age_us = (now.tv_sec - sec) * 1000000LL + now.tv_nsec / 1000 - usec;
+    if(age_us < 0) age_us = 0;
+    if(age_us > EVENT_AGE_MAX_US) return 0;
+
+    return lv_tick_get() - (uint32_t)(age_us / 1000);
+}
+
+/**
+ * Update the state of the device with an event
+ * @return true if a key of a keypad was pressed or released
+ */
+static bool _evdev_process_event(lv_evdev_t * dsc, const struct input_event * in)
+{
+    if(in->type == EV_REL) {
+        if(in->code == REL_X) dsc->root_x += in->value;
+        else if(in->code == REL_Y) dsc->root_y += in->value;
+    }
+    else if(in->type == EV_ABS) {
+        if(in->code == ABS_X || in->code == ABS_MT_POSITION_X) dsc->root_x = in->value;
+        else if(in->code == ABS_Y || in->code == ABS_MT_POSITION_Y) dsc->root_y = in->value;
+        else if(in->code == ABS_MT_TRACKING_ID) {
+            if(in->value == -1) dsc->state = LV_INDEV_STATE_RELEASED;
+            else if(in->value == 0) dsc->state = LV_INDEV_STATE_PRESSED;
+        }
+    }
+    else if(in->type == EV_KEY) {
+        if(in->code == BTN_MOUSE || in->code == BTN_TOUCH) {
+            if(in->value == 0) dsc->state = LV_INDEV_STATE_RELEASED;
+            else if(in->value == 1) dsc->state = LV_INDEV_STATE_PRESSED;
+        }
+        else {
+            dsc->key = _evdev_process_key(in->code);
+            if(dsc->key) {
+                dsc->state = in->value ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static void _evdev_set_data(lv_indev_t * indev, lv_indev_data_t * data, lv_indev_state_t state, int key,
+                            int root_x, int root_y)
+{
+    switch(lv_indev_get_type(indev)) {
+        case LV_INDEV_TYPE_KEYPAD:
+            data->state = state;
+            data->key = key;
+            break;
+        case LV_INDEV_TYPE_POINTER:
+            data->state = state;
+            data->point = _evdev_process_pointer(indev, root_x, root_y);
+            break;
+        default:
+            break;
+    }
+}
+
+#if LV_EVDEV_USE_THREAD
+
+/**
+ * Hand over the state at an EV_SYN boundary to LVGL. Motion is merged into the last
+ * queued sample if the button/key state didn't change so LVGL always gets the latest
+ * position, but never misses a press or release.
+ */
+static void _evdev_queue_sample(lv_evdev_t * dsc)
+{
+    lv_evdev_sample_t sample;
+    sample.root_x = dsc->root_x;
+    sample.root_y = dsc->root_y;
+    sample.key = dsc->key;
+    sample.state = dsc->state;
+    sample.first_in = dsc->first_in;
+    dsc->first_in_valid = false;
+
+    pthread_mutex_lock(&dsc->lock);
+    if(dsc->queue_cnt > 0) {
+        lv_evdev_sample_t * last = &dsc->queue[(dsc->queue_start + dsc->queue_cnt - 1) % EVDEV_SAMPLE_QUEUE_SIZE];
+        if(last->state == sample.state && last->key == sample.key) {
+            /*Keep the timestamp of the oldest event*/
+            last->root_x = sample.root_x;
+            last->root_y = sample.root_y;
+            pthread_mutex_unlock(&dsc->lock);
+            return;
+        }
+    }
+
+    if(dsc->queue_cnt == EVDEV_SAMPLE_QUEUE_SIZE) {
+        LV_LOG_INFO("sample queue is full, dropping the oldest sample");
+        dsc->queue_start = (dsc->queue_start + 1) % EVDEV_SAMPLE_QUEUE_SIZE;
+        dsc->queue_cnt--;
+    }
+    dsc->queue[(dsc->queue_start + dsc->queue_cnt) % EVDEV_SAMPLE_QUEUE_SIZE] = sample;
+    dsc->queue_cnt++;
+    pthread_mutex_unlock(&dsc->lock);
+}
+
+static void _evdev_free(lv_evdev_t * dsc)
+{
+    close(dsc->stop_pipe[0]);
+    close(dsc->stop_pipe[1]);
+    pthread_mutex_destroy(&dsc->lock);
+    close(dsc->fd);
+    lv_free(dsc);
+}
+
+static void * _evdev_thread(void * data)
+{
+    lv_evdev_t * dsc = data;
+    struct pollfd fds[2];
+    fds[0].fd = dsc->fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = dsc->stop_pipe[0];
+    fds[1].events = POLLIN;
+
+    while(1) {
+        if(poll(fds, 2, -1) < 0) {
+            if(errno == EINTR) continue;
+            LV_LOG_ERROR("poll failed: %s", strerror(errno));
+            break;
+        }
+        if(fds[1].revents) break;
+        if(fds[0].revents == 0) continue;
+
+        /*Read everything available, the device fd is non-blocking*/
+        struct input_event in;
+        ssize_t br;
+        while((br = read(dsc->fd, &in, sizeof(in))) > 0) {
+            if(!dsc->first_in_valid) {
+                dsc->first_in = in;
+                dsc->first_in_valid = true;
+            }
+
+            if(in.type == EV_SYN && in.code == SYN_REPORT) _evdev_queue_sample(dsc);
+            else _evdev_process_event(dsc, &in);
+        }
+        int read_errno = errno;
+        bool failed = (br == -1 && read_errno != EAGAIN) || (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL));
+
+        /*`lv_lock()` can't be waited for after the indev was deleted as the deleting thread
+         *might hold it while joining this thread*/
+        pthread_mutex_lock(&dsc->lock);
+        if(dsc->stop) {
+            pthread_mutex_unlock(&dsc->lock);
+            break;
+        }
+        dsc->in_lvgl = true;
+        uint32_t cnt = dsc->queue_cnt;
+        pthread_mutex_unlock(&dsc->lock);
+
+        lv_lock();
+        if(failed && !dsc->stop) {
+            if(br == -1 && read_errno != ENODEV) LV_LOG_ERROR("read failed: %s", strerror(read_errno));
+            else LV_LOG_INFO("evdev device was removed");
+            lv_async_call(_evdev_async_delete_cb, dsc->indev);
+            dsc->deleting = true;
+            fds[0].fd = -1; /*Wait only for the stop request*/
+        }
+        /*Process the new samples, it also wakes up the timer handler if something was invalidated*/
+        while(cnt > 0 && !dsc->stop) {
+            lv_indev_read(dsc->indev);
+            cnt--;
+        }
+        lv_unlock();
+
+        pthread_mutex_lock(&dsc->lock);
+        dsc->in_lvgl = false;
+        bool stop = dsc->stop;
+        pthread_mutex_unlock(&dsc->lock);
+
+        if(stop) {
+            /*The indev was deleted meanwhile and the thread was detached*/
+            _evdev_free(dsc);
+            return NULL;
+        }
+    }
+
+    return NULL;
+}
+
+static void _evdev_read(lv_indev_t * indev, lv_indev_data_t * data)
+{
+    lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
+    LV_ASSERT_NULL(dsc);
+
+    /*Report the oldest queued sample or the last state if there are none*/
+    pthread_mutex_lock(&dsc->lock);
+    bool new_sample = dsc->queue_cnt > 0;
+    if(new_sample) {
+        dsc->last = dsc->queue[dsc->queue_start];
+        dsc->queue_start = (dsc->queue_start + 1) % EVDEV_SAMPLE_QUEUE_SIZE;
+        dsc->queue_cnt--;
+    }
+    lv_evdev_sample_t sample = dsc->last;
+    pthread_mutex_unlock(&dsc->lock);
+
+    if(new_sample) data->timestamp = _evdev_event_to_tick(dsc, &sample.first_in);
+
+    _evdev_set_data(indev, data, sample.state, sample.key, sample.root_x, sample.root_y);
+}
+
+#else
+
 static void _evdev_read(lv_indev_t * indev, lv_indev_data_t * data)
 {
     lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
@@ -155,31 +417,12 @@ static void _evdev_read(lv_indev_t * indev, lv_indev_data_t * data)
     struct input_event in = { 0 };
     ssize_t br;
     while((br = read(dsc->fd, &in, sizeof(in))) > 0) {
-        if(in.type == EV_REL) {
-            if(in.code == REL_X) dsc->root_x += in.value;
-            else if(in.code == REL_Y) dsc->root_y += in.value;
-        }
-        else if(in.type == EV_ABS) {
-            if(in.code == ABS_X || in.code == ABS_MT_POSITION_X) dsc->root_x = in.value;
-            else if(in.code == ABS_Y || in.code == ABS_MT_POSITION_Y) dsc->root_y = in.value;
-            else if(in.code == ABS_MT_TRACKING_ID) {
-                if(in.value == -1) dsc->state = LV_INDEV_STATE_RELEASED;
-                else if(in.value == 0) dsc->state = LV_INDEV_STATE_PRESSED;
-            }
-        }
-        else if(in.type == EV_KEY) {
-            if(in.code == BTN_MOUSE || in.code == BTN_TOUCH) {
-                if(in.value == 0) dsc->state = LV_INDEV_STATE_RELEASED;
-                else if(in.value == 1) dsc->state = LV_INDEV_STATE_PRESSED;
-            }
-            else {
-                dsc->key = _evdev_process_key(in.code);
-                if(dsc->key) {
-                    dsc->state = in.value ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
-                    data->continue_reading = true; /*Keep following events in buffer for now*/
-                    break;
-                }
-            }
+        /*Measure the latency from the oldest event*/
+        if(data->timestamp == 0) data->timestamp = _evdev_event_to_tick(dsc, &in);
+
+        if(_evdev_process_event(dsc, &in)) {
+            data->continue_reading = true; /*Keep following events in buffer for now*/
+            break;
         }
     }
     if(!dsc->deleting && br == -1 && errno != EAGAIN) {
@@ -194,28 +437,40 @@ static void _evdev_read(lv_indev_t * indev, lv_indev_data_t * data)
     }
 
     /*Process and store in data*/
-    switch(lv_indev_get_type(indev)) {
-        case LV_INDEV_TYPE_KEYPAD:
-            data->state = dsc->state;
-            data->key = dsc->key;
-            break;
-        case LV_INDEV_TYPE_POINTER:
-            data->state = dsc->state;
-            data->point = _evdev_process_pointer(indev, dsc->root_x, dsc->root_y);
-            break;
-        default:
-            break;
-    }
+    _evdev_set_data(indev, data, dsc->state, dsc->key, dsc->root_x, dsc->root_y);
 }
 
+#endif /*LV_EVDEV_USE_THREAD*/
+
 static void _evdev_indev_delete_cb(lv_event_t * e)
 {
     lv_indev_t * indev = lv_event_get_target(e);
     lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
     LV_ASSERT_NULL(dsc);
     lv_async_call_cancel(_evdev_async_delete_cb, indev);
+
+#if LV_EVDEV_USE_THREAD
+    pthread_mutex_lock(&dsc->lock);
+    dsc->stop = true;
+    bool in_lvgl = dsc->in_lvgl;
+    pthread_mutex_unlock(&dsc->lock);
+
+    if(write(dsc->stop_pipe[1], "", 1) < 0) {
+        LV_LOG_WARN("write failed: %s", strerror(errno));
+    }
+
+    if(in_lvgl) {
+        /*The thread waits for `lv_lock()` or this is called from it, it frees `dsc` itself*/
+        pthread_detach(dsc->thread);
+        return;
+    }
+
+    pthread_join(dsc->thread, NULL);
+    _evdev_free(dsc);
+#else
     close(dsc->fd);
     lv_free(dsc);
+#endif
 }
 
 #ifndef BSD
@@ -411,6 +666,18 @@ lv_indev_t * lv_evdev_create(lv_indev_type_t indev_type, const char * dev_path)
         goto err_after_open;
     }
 
+    /*Timestamp the events with the monotonic clock as it doesn't jump. By default it's the real time.*/
+    dsc->clock_id = CLOCK_REALTIME;
+#ifdef EVIOCSCLOCKID
+    int clock_id = CLOCK_MONOTONIC;
+    if(ioctl(dsc->fd, EVIOCSCLOCKID, &clock_id) == 0) {
+        dsc->clock_id = CLOCK_MONOTONIC;
+    }
+    else {
+        LV_LOG_INFO("ioctl EVIOCSCLOCKID failed: %s", strerror(errno));
+    }
+#endif
+
     /* Detect the minimum and maximum values of the input device for calibration. */
 
     if(indev_type == LV_INDEV_TYPE_POINTER) {
@@ -436,6 +703,27 @@ lv_indev_t * lv_evdev_create(lv_indev_type_t indev_type, const char * dev_path)
     lv_indev_set_type(indev, indev_type);
     lv_indev_set_read_cb(indev, _evdev_read);
     lv_indev_set_driver_data(indev, dsc);
+
+#if LV_EVDEV_USE_THREAD
+    /*The indev is read by the thread when new samples arrive*/
+    dsc->indev = indev;
+    lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+    if(pipe(dsc->stop_pipe) < 0) {
+        LV_LOG_ERROR("pipe failed: %s", strerror(errno));
+        lv_indev_delete(indev);
+        goto err_after_open;
+    }
+    pthread_mutex_init(&dsc->lock, NULL);
+    if(pthread_create(&dsc->thread, NULL, _evdev_thread, dsc) != 0) {
+        LV_LOG_ERROR("pthread_create failed");
+        lv_indev_delete(indev);
+        close(dsc->stop_pipe[0]);
+        close(dsc->stop_pipe[1]);
+        pthread_mutex_destroy(&dsc->lock);
+        goto err_after_open;
+    }
+#endif
+
     lv_indev_add_event_cb(indev, _evdev_indev_delete_cb, LV_EVENT_DELETE, NULL);
 
     return indev;
@@ -17,6 +17,7 @@
 #include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
 #include "../../display/lv_display_private.h"
+#include "../../misc/lv_area_private.h"
 #include "../../lv_init.h"
 #include "../../draw/lv_draw_buf.h"
 
@@ -57,6 +58,9 @@ typedef struct {
     uint8_t * buf2;
     uint8_t * rotated_buf;
     size_t rotated_buf_size;
+    lv_area_t dirty_areas[LV_INV_BUF_SIZE]; /*Areas of `fb_act` flushed since the last texture upload*/
+    uint32_t dirty_cnt;
+    bool texture_invalid;                   /*The whole texture has to be uploaded*/
 #endif
     float zoom;
     uint8_t ignore_size_chg;
@@ -71,6 +75,8 @@ static void window_create(lv_display_t * disp);
 static void window_update(lv_display_t * disp);
 #if LV_USE_DRAW_SDL == 0
     static void texture_resize(lv_display_t * disp);
+    static void texture_add_dirty_area(lv_sdl_window_t * dsc, const lv_area_t * area);
+    static void texture_upload(lv_display_t * disp);
     static void * sdl_draw_buf_realloc_aligned(void * ptr, size_t new_size);
     static void sdl_draw_buf_free(void * ptr);
 #endif
@@ -283,12 +289,20 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_m
         }
     }
 
+    /*Only the flushed areas of the texture are uploaded*/
+    lv_area_t dirty_area = *area;
+    lv_display_rotate_area(disp, &dirty_area);
+    texture_add_dirty_area(dsc, &dirty_area);
+
     if(lv_display_flush_is_last(disp)) {
         if(sdl_render_mode() != LV_DISPLAY_RENDER_MODE_PARTIAL) {
             dsc->fb_act = px_map;
         }
 
-        window_update(disp);
+        /*Present only if something has changed*/
+        if(dsc->dirty_cnt > 0 || dsc->texture_invalid) {
+            window_update(disp);
+        }
     }
     free(argb_px_map);
 #else
@@ -394,13 +408,7 @@ static void window_update(lv_display_t * disp)
 {
     lv_sdl_window_t * dsc = lv_display_get_driver_data(disp);
 #if LV_USE_DRAW_SDL == 0
-    int32_t hor_res = disp->hor_res;
-    lv_color_format_t cf = lv_display_get_color_format(disp);
-    if(cf == LV_COLOR_FORMAT_I1) {
-        cf = LV_COLOR_FORMAT_ARGB8888;
-    }
-    uint32_t stride = lv_draw_buf_width_to_stride(hor_res, cf);
-    SDL_UpdateTexture(dsc->texture, NULL, dsc->fb_act, stride);
+    texture_upload(disp);
 
     SDL_RenderClear(dsc->renderer);
 
@@ -452,6 +460,64 @@ static void texture_resize(lv_display_t * disp)
     dsc->texture = SDL_CreateTexture(dsc->renderer, px_format,
                                      SDL_TEXTUREACCESS_STATIC, disp->hor_res, disp->ver_res);
     SDL_SetTextureBlendMode(dsc->texture, SDL_BLENDMODE_BLEND);
+
+    /*The new texture has no content yet*/
+    dsc->dirty_cnt = 0;
+    dsc->texture_invalid = true;
+}
+
+static void texture_add_dirty_area(lv_sdl_window_t * dsc, const lv_area_t * area)
+{
+    if(dsc->texture_invalid) return;
+
+    if(dsc->dirty_cnt > 0) {
+        lv_area_t * last = &dsc->dirty_areas[dsc->dirty_cnt - 1];
+        /*Join the stripes of a tall area rendered in multiple chunks*/
+        if(last->x1 == area->x1 && last->x2 == area->x2 && last->y2 + 1 == area->y1) {
+            last->y2 = area->y2;
+            return;
+        }
+
+        /*Out of slots: merge into the last area*/
+        if(dsc->dirty_cnt == LV_INV_BUF_SIZE) {
+            lv_area_join(last, last, area);
+            return;
+        }
+    }
+
+    dsc->dirty_areas[dsc->dirty_cnt] = *area;
+    dsc->dirty_cnt++;
+}
+
+static void texture_upload(lv_display_t * disp)
+{
+    lv_sdl_window_t * dsc = lv_display_get_driver_data(disp);
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    if(cf == LV_COLOR_FORMAT_I1) {
+        cf = LV_COLOR_FORMAT_ARGB8888;
+    }
+    uint32_t stride = lv_draw_buf_width_to_stride(disp->hor_res, cf);
+    uint32_t px_size = lv_color_format_get_size(cf);
+
+    if(dsc->texture_invalid) {
+        SDL_UpdateTexture(dsc->texture, NULL, dsc->fb_act, stride);
+    }
+    else {
+        lv_area_t fb_area;
+        lv_area_set(&fb_area, 0, 0, disp->hor_res - 1, disp->ver_res - 1);
+
+        uint32_t i;
+        for(i = 0; i < dsc->dirty_cnt; i++) {
+            lv_area_t a;
+            if(!lv_area_intersect(&a, &dsc->dirty_areas[i], &fb_area)) continue;
+
+            SDL_Rect rect = {a.x1, a.y1, lv_area_get_width(&a), lv_area_get_height(&a)};
+            SDL_UpdateTexture(dsc->texture, &rect, dsc->fb_act + a.y1 * stride + a.x1 * px_size, stride);
+        }
+    }
+
+    dsc->dirty_cnt = 0;
+    dsc->texture_invalid = false;
 }
 
 static void * sdl_draw_buf_realloc_aligned(void * ptr, size_t new_size)
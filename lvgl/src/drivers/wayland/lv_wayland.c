@@ -32,7 +32,6 @@ typedef int dummy_t;    /* Make GCC on windows happy, avoid empty translation un
 #include <errno.h>
 #include <string.h>
 #include <time.h>
-#include <poll.h>
 #include <sys/mman.h>
 #include <linux/input.h>
 #include <linux/input-event-codes.h>
@@ -41,6 +40,7 @@ typedef int dummy_t;    /* Make GCC on windows happy, avoid empty translation un
 #include <xkbcommon/xkbcommon.h>
 
 #include "lvgl.h"
+#include "../../display/lv_display_private.h"
 
 #if !LV_WAYLAND_WL_SHELL
     #include "wayland_xdg_shell.h"
@@ -56,6 +56,8 @@ typedef int dummy_t;    /* Make GCC on windows happy, avoid empty translation un
 
 #define LVGL_DRAW_BUFFER_DIV (8)
 #define DMG_CACHE_CAPACITY (32)
+/* wl_surface.damage_buffer was introduced in wl_compositor version 4 */
+#define WL_COMPOSITOR_DAMAGE_BUFFER_VERSION (4)
 #define TAG_LOCAL         (0)
 #define TAG_BUFFER_DAMAGE (1)
 
@@ -154,6 +156,7 @@ struct application {
     struct wl_display * display;
     struct wl_registry * registry;
     struct wl_compositor * compositor;
+    uint32_t compositor_version;
     struct wl_subcompositor * subcompositor;
     struct wl_shm * shm;
     struct wl_seat * wl_seat;
@@ -189,7 +192,6 @@ struct application {
     lv_timer_t * cycle_timer;
 
     bool cursor_flush_pending;
-    struct pollfd wayland_pfd;
 };
 
 struct window {
@@ -223,6 +225,11 @@ struct window {
         unsigned size;
     } dmg_cache;
 
+    /* Surface damage of the frame being flushed, consecutive stripes
+     * are joined before being sent to the compositor */
+    lv_area_t flush_dmg;
+    bool flush_dmg_valid;
+
 #if LV_WAYLAND_WINDOW_DECORATIONS
     struct graphic_object * decoration[NUM_DECORATIONS];
 #endif
@@ -241,6 +248,7 @@ struct window {
     bool fullscreen;
     uint32_t frame_counter;
     bool frame_done;
+    struct wl_callback * frame_cb;
 };
 
 /*********************************
@@ -290,12 +298,22 @@ static void graphic_obj_frame_done(void * data, struct wl_callback * cb, uint32_
     obj = (struct graphic_object *)data;
     window = obj->window;
     window->frame_counter++;
+    window->frame_cb = NULL;
 
     LV_LOG_TRACE("frame: %d done, new frame: %d",
                  window->frame_counter - 1, window->frame_counter);
 
     window->frame_done = true;
 
+    /* The compositor is ready for a new frame, resume rendering if
+     * anything was invalidated while waiting */
+    if(window->lv_disp != NULL) {
+        lv_timer_t * refr_timer = lv_display_get_refr_timer(window->lv_disp);
+        if(refr_timer != NULL && window->lv_disp->inv_p > 0) {
+            lv_timer_resume(refr_timer);
+            lv_timer_ready(refr_timer);
+        }
+    }
 }
 
 static const struct wl_callback_listener wl_surface_frame_listener = {
@@ -1266,11 +1284,12 @@ static void handle_global(void * data, struct wl_registry * registry,
 {
     struct application * app = data;
 
-    LV_UNUSED(version);
     LV_UNUSED(data);
 
     if(strcmp(interface, wl_compositor_interface.name) == 0) {
-        app->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 1);
+        app->compositor_version = LV_MIN(version, WL_COMPOSITOR_DAMAGE_BUFFER_VERSION);
+        app->compositor = wl_registry_bind(registry, name, &wl_compositor_interface,
+                                           app->compositor_version);
     }
     else if(strcmp(interface, wl_subcompositor_interface.name) == 0) {
         app->subcompositor = wl_registry_bind(registry, name, &wl_subcompositor_interface, 1);
@@ -1376,6 +1395,17 @@ static void cache_add_area(struct window * window, smm_buffer_t * buf, const lv_
         goto done;
     }
 
+    /* Join consecutive stripes of the same column into a single area */
+    if(window->dmg_cache.size &&
+       (window->dmg_cache.cache + window->dmg_cache.end) != SMM_BUFFER_PROPERTIES(buf)->tag[TAG_BUFFER_DAMAGE]) {
+        lv_area_t * last = window->dmg_cache.cache +
+                           ((window->dmg_cache.end + DMG_CACHE_CAPACITY - 1) % DMG_CACHE_CAPACITY);
+        if(last->x1 == area->x1 && last->x2 == area->x2 && last->y2 + 1 == area->y1) {
+            last->y2 = area->y2;
+            goto done;
+        }
+    }
+
     /* Add damage area to cache */
     memcpy(window->dmg_cache.cache + window->dmg_cache.end,
            area,
@@ -2131,6 +2161,11 @@ static void destroy_window(struct window * window)
         return;
     }
 
+    if(window->frame_cb) {
+        wl_callback_destroy(window->frame_cb);
+        window->frame_cb = NULL;
+    }
+
 #if LV_WAYLAND_WL_SHELL
     if(window->wl_shell_surface) {
         wl_shell_surface_destroy(window->wl_shell_surface);
@@ -2156,6 +2191,32 @@ static void destroy_window(struct window * window)
     destroy_graphic_obj(window->body);
 }
 
+/* Report a damaged area of the surface, in buffer coordinates when the
+ * compositor supports it so no scale/transform conversion is involved */
+static void surface_damage(struct application * app, struct wl_surface * surface, const lv_area_t * area)
+{
+    if(app->compositor_version >= WL_COMPOSITOR_DAMAGE_BUFFER_VERSION) {
+        wl_surface_damage_buffer(surface, area->x1, area->y1,
+                                 lv_area_get_width(area), lv_area_get_height(area));
+    }
+    else {
+        wl_surface_damage(surface, area->x1, area->y1,
+                          lv_area_get_width(area), lv_area_get_height(area));
+    }
+}
+
+/* Keep the refresh timer paused while a frame callback is pending,
+ * it's resumed from graphic_obj_frame_done */
+static void _lv_wayland_refr_request_cb(lv_event_t * e)
+{
+    lv_display_t * disp = lv_event_get_target(e);
+    struct window * window = lv_display_get_user_data(disp);
+
+    if(window != NULL && window->frame_cb != NULL) {
+        lv_timer_pause(lv_display_get_refr_timer(disp));
+    }
+}
+
 static void _lv_wayland_flush(lv_display_t * disp, const lv_area_t * area, unsigned char * color_p)
 {
     void * buf_base;
@@ -2231,26 +2292,42 @@ static void _lv_wayland_flush(lv_display_t * disp, const lv_area_t * area, unsig
         color_p += src_width * bpp;
     }
 
-    /* Mark surface damage */
-    wl_surface_damage(window->body->surface,
-                      area->x1,
-                      area->y1,
-                      src_width,
-                      src_height);
+    /* Mark surface damage, LVGL flushes tall areas as stripes of the same
+     * width so join them before reporting them to the compositor */
+    if(window->flush_dmg_valid &&
+       window->flush_dmg.x1 == area->x1 && window->flush_dmg.x2 == area->x2 &&
+       window->flush_dmg.y2 + 1 == area->y1) {
+        window->flush_dmg.y2 = area->y2;
+    }
+    else {
+        if(window->flush_dmg_valid) {
+            surface_damage(app, window->body->surface, &window->flush_dmg);
+        }
+        lv_area_copy(&window->flush_dmg, area);
+        window->flush_dmg_valid = true;
+    }
 
     cache_add_area(window, buf, area);
 
 
     if(lv_display_flush_is_last(disp)) {
+        surface_damage(app, window->body->surface, &window->flush_dmg);
+        window->flush_dmg_valid = false;
+
+        /* Request a frame callback before committing, rendering of the
+         * next frame is paused until the compositor consumed this one */
+        cb = wl_surface_frame(window->body->surface);
+        wl_callback_add_listener(cb, &wl_surface_frame_listener, window->body);
+        window->frame_cb = cb;
+        window->frame_done = false;
+        lv_timer_pause(lv_display_get_refr_timer(disp));
+
         /* Finally, attach buffer and commit to surface */
         wl_buf = SMM_BUFFER_PROPERTIES(buf)->tag[TAG_LOCAL];
         wl_surface_attach(window->body->surface, wl_buf, 0, 0);
         wl_surface_commit(window->body->surface);
         window->body->pending_buffer = NULL;
-        window->frame_done = false;
 
-        cb = wl_surface_frame(window->body->surface);
-        wl_callback_add_listener(cb, &wl_surface_frame_listener, window->body);
         LV_LOG_TRACE("last flush frame: %d", window->frame_counter);
 
         window->flush_pending = true;
@@ -2268,13 +2345,12 @@ skip:
         smm_release(buf);
         window->body->pending_buffer = NULL;
     }
+    window->flush_dmg_valid = false;
 }
 
 static void _lv_wayland_handle_input(void)
 {
-    int prepare_read = wl_display_prepare_read(application.display);
-
-    while(prepare_read != 0) {
+    while(wl_display_prepare_read(application.display) != 0) {
         wl_display_dispatch_pending(application.display);
     }
 
@@ -2473,10 +2549,6 @@ static void wayland_init(void)
 
     lv_tick_set_cb(tick_get_cb);
 
-    /* Used to wait for events when the window is minimized or hidden */
-    application.wayland_pfd.fd = wl_display_get_fd(application.display);
-    application.wayland_pfd.events = POLLIN;
-
 }
 
 /**
@@ -2610,6 +2682,7 @@ lv_display_t * lv_wayland_window_create(uint32_t hor_res, uint32_t ver_res, char
     lv_display_set_render_mode(window->lv_disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
     lv_display_set_flush_cb(window->lv_disp, _lv_wayland_flush);
     lv_display_set_user_data(window->lv_disp, window);
+    lv_display_add_event_cb(window->lv_disp, _lv_wayland_refr_request_cb, LV_EVENT_REFR_REQUEST, NULL);
 
     /* Register input */
     window->lv_indev_pointer = lv_indev_create();
@@ -2860,17 +2933,18 @@ bool lv_wayland_timer_handler(void)
     LV_LL_READ(&application.window_ll, window) {
         LV_LOG_TRACE("handle timer frame: %d", window->frame_counter);
 
-        if(window != NULL && window->frame_done == false
-           && window->frame_counter > 0) {
-            /* The last frame was not rendered */
-            LV_LOG_TRACE("The window is hidden or minimized");
-
-            /* Simply blocks until a frame done message arrives */
-            poll(&application.wayland_pfd, 1, -1);
+        if(window->shall_close == true) {
 
-            /* Resume lvgl on the next cycle */
+            /* Destroy graphical context and execute close_cb */
+            _lv_wayland_handle_output();
+            wayland_deinit();
             return false;
-
+        }
+        else if(window->frame_cb != NULL) {
+            /* The last frame was not consumed yet (or the window is hidden
+             * or minimized), the refresh timer stays paused until the frame
+             * done event arrives, other timers keep running */
+            LV_LOG_TRACE("waiting for frame: %d", window->frame_counter);
         }
         else if(window != NULL && window->body->surface_configured == false) {
             /* Initial commit to trigger the configure event */
@@ -2892,13 +2966,6 @@ bool lv_wayland_timer_handler(void)
                              window->frame_counter);
             }
         }
-        else if(window->shall_close == true) {
-
-            /* Destroy graphical context and execute close_cb */
-            _lv_wayland_handle_output();
-            wayland_deinit();
-            return false;
-        }
     }
 
     /* LVGL handling */
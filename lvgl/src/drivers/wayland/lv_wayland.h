@@ -124,8 +124,11 @@ lv_indev_t * lv_wayland_get_touchscreen(lv_display_t * disp);
  * Wrapper around lv_timer_handler
  * @note Must be called in the application run loop instead of the
  * regular lv_timer_handler provided by LVGL
- * @return true: if the cycle was completed, false if the application
- * went to sleep because the last frame wasn't completed
+ * @note Rendering is paced by the compositor's frame callbacks, this
+ * function never blocks. Wait on `lv_wayland_get_fd()` for at most
+ * `lv_timer_get_time_until_next()` ms between calls.
+ * @return true: if the cycle was completed, false if a window was
+ * closed and the driver was de-initialized
  */
 bool lv_wayland_timer_handler(void);
 
@@ -16,6 +16,11 @@
 #include <pthread.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#if LV_X11_USE_SHM
+    #include <sys/ipc.h>
+    #include <sys/shm.h>
+    #include <X11/extensions/XShm.h>
+#endif
 #include "../../core/lv_obj_pos.h"
 
 /*********************
@@ -24,6 +29,8 @@
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #define MAX(A, B) ((A) > (B) ? (A) : (B))
 
+#define FLUSH_AREA_CNT 16  /**< number of separately updated areas per frame, more are merged */
+
 #if LV_X11_RENDER_MODE_PARTIAL
     #define LV_X11_RENDER_MODE LV_DISPLAY_RENDER_MODE_PARTIAL
 #elif defined LV_X11_RENDER_MODE_DIRECT
@@ -47,10 +54,17 @@ typedef struct {
     XImage     *    ximage;          /**< X11 XImage cache object for updating window content */
     Atom            wmDeleteMessage; /**< X11 atom to window object */
     void      *     xdata;           /**< allocated data for XImage */
+#if LV_X11_USE_SHM
+    XShmSegmentInfo shm_info;        /**< shared memory segment of the XImage if @ref use_shm */
+    bool            use_shm;         /**< XImage is in shared memory with the X server */
+    bool            shm_pending;     /**< the X server may still read the XImage */
+    int             shm_completion;  /**< event type of ShmCompletion */
+#endif
     /* LVGL related information */
     lv_timer_t   *  timer;           /**< timer object for @ref x11_event_handler */
     uint8_t    *    buffer[2];       /**< (double) lv display buffers, depending on @ref LV_X11_RENDER_MODE */
-    lv_area_t       flush_area;      /**< integrated area for a display update */
+    lv_area_t       flush_areas[FLUSH_AREA_CNT]; /**< areas updated in the current frame */
+    uint32_t        flush_area_cnt;  /**< number of areas in @ref flush_areas */
     /* systemtick by thread related information */
     pthread_t       thr_tick;        /**< pthread for SysTick simulation */
     bool            terminated;      /**< flag to germinate SysTick simulation thread */
@@ -62,6 +76,9 @@ typedef struct {
 #if LV_X11_DIRECT_EXIT
     static unsigned int count_windows = 0;
 #endif
+#if LV_X11_USE_SHM
+    static bool shm_attach_failed;
+#endif
 
 /**********************
  *      MACROS
@@ -103,6 +120,148 @@ static inline lv_color32_t get_px(color_t p)
 #error ("Unsupported LV_COLOR_DEPTH")
 #endif
 
+#if LV_X11_USE_SHM
+/**
+ * catch the error of XShmAttach, e.g. if the X server is on an other machine
+ */
+static int x11_shm_error_handler(Display * disp, XErrorEvent * error)
+{
+    LV_UNUSED(disp);
+    LV_UNUSED(error);
+    shm_attach_failed = true;
+    return 0;
+}
+
+static Bool is_shm_completion(Display * disp, XEvent * event, XPointer arg)
+{
+    LV_UNUSED(disp);
+    x11_disp_data_t * xd = (x11_disp_data_t *)arg;
+    return event->type == xd->shm_completion;
+}
+
+/**
+ * wait until the X server has read the shared XImage, so it can be written again
+ */
+static void x11_shm_wait(x11_disp_data_t * xd)
+{
+    if(!xd->shm_pending) return;
+
+    XEvent event;
+    XIfEvent(xd->hdr.display, &event, is_shm_completion, (XPointer)xd);
+    xd->shm_pending = false;
+}
+
+/**
+ * create the XImage in a shared memory segment, so XShmPutImage only has to tell the X server
+ * which area to copy instead of sending the pixels over the socket
+ * @return  true on success, false if MIT-SHM can't be used
+ */
+static bool x11_shm_image_create(x11_disp_data_t * xd, int32_t hor_res, int32_t ver_res)
+{
+    if(!XShmQueryExtension(xd->hdr.display)) return false;
+
+    xd->ximage = XShmCreateImage(xd->hdr.display, xd->visual, xd->dplanes, ZPixmap, NULL, &xd->shm_info,
+                                 hor_res, ver_res);
+    if(xd->ximage == NULL) return false;
+
+    xd->shm_info.shmid = shmget(IPC_PRIVATE, xd->ximage->bytes_per_line * xd->ximage->height, IPC_CREAT | 0600);
+    if(xd->shm_info.shmid < 0) {
+        XDestroyImage(xd->ximage);
+        return false;
+    }
+
+    xd->shm_info.shmaddr = shmat(xd->shm_info.shmid, NULL, 0);
+    if(xd->shm_info.shmaddr == (char *) -1) {
+        shmctl(xd->shm_info.shmid, IPC_RMID, NULL);
+        XDestroyImage(xd->ximage);
+        return false;
+    }
+    xd->shm_info.readOnly = False;
+
+    /* the attach fails asynchronously (BadAccess) if the X server can't access the segment */
+    shm_attach_failed = false;
+    XErrorHandler handler_old = XSetErrorHandler(x11_shm_error_handler);
+    XShmAttach(xd->hdr.display, &xd->shm_info);
+    XSync(xd->hdr.display, False);
+    XSetErrorHandler(handler_old);
+
+    /* the segment is freed automatically when both sides have detached */
+    shmctl(xd->shm_info.shmid, IPC_RMID, NULL);
+
+    if(shm_attach_failed) {
+        shmdt(xd->shm_info.shmaddr);
+        XDestroyImage(xd->ximage);
+        return false;
+    }
+
+    xd->ximage->data = xd->shm_info.shmaddr;
+    xd->xdata = xd->shm_info.shmaddr;
+    xd->shm_completion = XShmGetEventBase(xd->hdr.display) + ShmCompletion;
+    return true;
+}
+#endif
+
+/**
+ * create the cache XImage, in shared memory if possible
+ */
+static void x11_image_create(x11_disp_data_t * xd, int32_t hor_res, int32_t ver_res)
+{
+#if LV_X11_USE_SHM
+    xd->use_shm = x11_shm_image_create(xd, hor_res, ver_res);
+    if(xd->use_shm) return;
+    LV_LOG_WARN("MIT-SHM is not available, falling back to XPutImage");
+#endif
+
+    size_t sz_buffers = hor_res * ver_res * sizeof(lv_color32_t);
+    xd->xdata = malloc(sz_buffers); /* use clib method here, x11 memory not part of device footprint */
+    xd->ximage = XCreateImage(xd->hdr.display, xd->visual, xd->dplanes, ZPixmap, 0, xd->xdata,
+                              hor_res, ver_res, lv_color_format_get_bpp(LV_COLOR_FORMAT_ARGB8888), 0);
+}
+
+static void x11_image_destroy(x11_disp_data_t * xd)
+{
+#if LV_X11_USE_SHM
+    if(xd->use_shm) {
+        x11_shm_wait(xd);
+        XShmDetach(xd->hdr.display, &xd->shm_info);
+        XDestroyImage(xd->ximage);
+        shmdt(xd->shm_info.shmaddr);
+        xd->ximage = NULL;
+        xd->xdata = NULL;
+        return;
+    }
+#endif
+
+    XDestroyImage(xd->ximage); /* frees xdata too */
+    xd->ximage = NULL;
+    xd->xdata = NULL;
+}
+
+/**
+ * copy an area of the cache XImage to the window
+ * @param[in] xd      display data
+ * @param[in] area    area to be updated
+ * @param[in] notify  with MIT-SHM request a completion event to know when the XImage can be written again
+ */
+static void x11_put_image(x11_disp_data_t * xd, const lv_area_t * area, bool notify)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+
+#if LV_X11_USE_SHM
+    if(xd->use_shm) {
+        XShmPutImage(xd->hdr.display, xd->window, xd->gc, xd->ximage, area->x1, area->y1, area->x1, area->y1, w, h,
+                     notify ? True : False);
+        if(notify) xd->shm_pending = true;
+        return;
+    }
+#else
+    LV_UNUSED(notify);
+#endif
+
+    XPutImage(xd->hdr.display, xd->window, xd->gc, xd->ximage, area->x1, area->y1, area->x1, area->y1, w, h);
+}
+
 /**
  * Flush the content of the internal buffer the specific area on the display.
  * @param[in] disp    the created X11 display object from @lv_x11_window_create
@@ -115,26 +274,41 @@ static void x11_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
     x11_disp_data_t * xd = lv_display_get_driver_data(disp);
     LV_ASSERT_NULL(xd);
 
-    static const lv_area_t inv_area = { .x1 = 0xFFFF,
-                                        .x2 = 0,
-                                        .y1 = 0xFFFF,
-                                        .y2 = 0
-                                      };
+#if LV_X11_USE_SHM
+    /* the X server might still read the previous frame from the shared XImage */
+    x11_shm_wait(xd);
+#endif
 
-    /* build display update area until lv_display_flush_is_last */
-    xd->flush_area.x1 = MIN(xd->flush_area.x1, area->x1);
-    xd->flush_area.x2 = MAX(xd->flush_area.x2, area->x2);
-    xd->flush_area.y1 = MIN(xd->flush_area.y1, area->y1);
-    xd->flush_area.y2 = MAX(xd->flush_area.y2, area->y2);
+    /* collect the display update areas until lv_display_flush_is_last */
+    if(xd->flush_area_cnt > 0) {
+        lv_area_t * last = &xd->flush_areas[xd->flush_area_cnt - 1];
+        if(last->x1 == area->x1 && last->x2 == area->x2 && last->y2 + 1 == area->y1) {
+            /* next stripe of the same area in partial mode */
+            last->y2 = area->y2;
+        }
+        else if(xd->flush_area_cnt == FLUSH_AREA_CNT) {
+            last->x1 = MIN(last->x1, area->x1);
+            last->x2 = MAX(last->x2, area->x2);
+            last->y1 = MIN(last->y1, area->y1);
+            last->y2 = MAX(last->y2, area->y2);
+        }
+        else {
+            xd->flush_areas[xd->flush_area_cnt++] = *area;
+        }
+    }
+    else {
+        xd->flush_areas[xd->flush_area_cnt++] = *area;
+    }
 
     int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t dst_stride = xd->ximage->bytes_per_line / sizeof(lv_color32_t);
 
     uint32_t      dst_offs;
     lv_color32_t * dst_data;
     color_t   *   src_data = (color_t *)px_map + (LV_X11_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL ? 0 : hor_res *
                                                   area->y1 + area->x1);
     for(int16_t y = area->y1; y <= area->y2; y++) {
-        dst_offs = area->x1 + y * hor_res;
+        dst_offs = area->x1 + y * dst_stride;
         dst_data = &((lv_color32_t *)(xd->xdata))[dst_offs];
         for(int16_t x = area->x1; x <= area->x2; x++, src_data++, dst_data++) {
             *dst_data = get_px(*src_data);
@@ -143,17 +317,15 @@ static void x11_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
     }
 
     if(lv_display_flush_is_last(disp)) {
-        LV_LOG_TRACE("(%d/%d), %dx%d)", xd->flush_area.x1, xd->flush_area.y1, xd->flush_area.x2 + 1 - xd->flush_area.x1,
-                     xd->flush_area.y2 + 1 - xd->flush_area.y1);
-
-        /* refresh collected display update area only */
-        int16_t upd_w = xd->flush_area.x2 - xd->flush_area.x1 + 1;
-        int16_t upd_h = xd->flush_area.y2 - xd->flush_area.y1 + 1;
-        XPutImage(xd->hdr.display, xd->window, xd->gc, xd->ximage, xd->flush_area.x1, xd->flush_area.y1, xd->flush_area.x1,
-                  xd->flush_area.y1, upd_w, upd_h);
+        /* refresh collected display update areas only */
+        for(uint32_t i = 0; i < xd->flush_area_cnt; i++) {
+            const lv_area_t * upd = &xd->flush_areas[i];
+            LV_LOG_TRACE("(%d/%d), %dx%d)", upd->x1, upd->y1, lv_area_get_width(upd), lv_area_get_height(upd));
+            x11_put_image(xd, upd, i == xd->flush_area_cnt - 1);
+        }
+        XFlush(xd->hdr.display);
 
-        /* invalidate collected area */
-        xd->flush_area = inv_area;
+        xd->flush_area_cnt = 0;
     }
     /* Inform the graphics library that you are ready with the flushing */
     lv_display_flush_ready(disp);
@@ -181,11 +353,8 @@ static void x11_resolution_evt_cb(lv_event_t * e)
     }
 
     /* re-create cache image with new size */
-    XDestroyImage(xd->ximage);
-    size_t sz_buffers = hor_res * ver_res * sizeof(lv_color32_t);
-    xd->xdata = malloc(sz_buffers); /* use clib method here, x11 memory not part of device footprint */
-    xd->ximage = XCreateImage(xd->hdr.display, xd->visual, xd->dplanes, ZPixmap, 0, xd->xdata,
-                              hor_res, ver_res, lv_color_format_get_bpp(LV_COLOR_FORMAT_ARGB8888), 0);
+    x11_image_destroy(xd);
+    x11_image_create(xd, hor_res, ver_res);
 }
 
 /**
@@ -204,7 +373,7 @@ static void x11_disp_delete_evt_cb(lv_event_t * e)
         free(xd->buffer[1]);
     }
 
-    XDestroyImage(xd->ximage);
+    x11_image_destroy(xd);
     XFreeGC(xd->hdr.display, xd->gc);
     XUnmapWindow(xd->hdr.display, xd->window);
     XDestroyWindow(xd->hdr.display, xd->window);
@@ -259,7 +428,11 @@ static void x11_event_handler(lv_timer_t * t)
         switch(event.type) {
             case Expose:
                 if(event.xexpose.count == 0) {
-                    XPutImage(xd->hdr.display, xd->window, xd->gc, xd->ximage, 0, 0, 0, 0, event.xexpose.width, event.xexpose.height);
+                    lv_area_t expose_area = { 0, 0, event.xexpose.width - 1, event.xexpose.height - 1 };
+#if LV_X11_USE_SHM
+                    x11_shm_wait(xd);
+#endif
+                    x11_put_image(xd, &expose_area, true);
                 }
                 break;
             case ConfigureNotify:
@@ -339,11 +512,8 @@ static void x11_window_create(lv_display_t * disp, char const * title)
     x11_hide_cursor(disp);
 
     /* create cache XImage */
-    size_t sz_buffers = hor_res * ver_res * sizeof(lv_color32_t);
     xd->dplanes = XDisplayPlanes(xd->hdr.display, screen);
-    xd->xdata = malloc(sz_buffers); /* use clib method here, x11 memory not part of device footprint */
-    xd->ximage = XCreateImage(xd->hdr.display, xd->visual, xd->dplanes, ZPixmap, 0, xd->xdata,
-                              hor_res, ver_res, lv_color_format_get_bpp(LV_COLOR_FORMAT_ARGB8888), 0);
+    x11_image_create(xd, hor_res, ver_res);
 
     /* finally bring window on top of the other windows */
     XMapRaised(xd->hdr.display, xd->window);
@@ -13,6 +13,12 @@
 #include "../stdlib/lv_string.h"
 #include "lv_binfont_loader.h"
 
+/*********************
+ *      DEFINES
+ *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_FONT
+
 /**********************
  *      TYPEDEFS
  **********************/
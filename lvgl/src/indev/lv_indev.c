@@ -16,6 +16,7 @@
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
 #include "../core/lv_obj_private.h"
+#include "../core/lv_obj_spatial_index_private.h"
 #include "../core/lv_group.h"
 #include "../core/lv_refr.h"
 
@@ -80,6 +81,9 @@ static void indev_click_focus(lv_indev_t * indev);
 static void indev_gesture(lv_indev_t * indev);
 static bool indev_reset_check(lv_indev_t * indev);
 static void indev_read_core(lv_indev_t * indev, lv_indev_data_t * data);
+#if LV_USE_PERF_MONITOR
+    static void indev_report_input(lv_indev_t * indev, const lv_indev_data_t * data);
+#endif
 static void indev_reset_core(lv_indev_t * indev, lv_obj_t * obj);
 static void indev_init_gesture_recognizers(lv_indev_t * indev);
 static lv_result_t send_event(lv_event_code_t code, void * param);
@@ -242,6 +246,10 @@ void lv_indev_read(lv_indev_t * indev)
         indev_proc_reset_query_handler(indev);
         indev_obj_act = NULL;
 
+#if LV_USE_PERF_MONITOR
+        indev_report_input(indev, &data);
+#endif
+
         indev->state = data.state;
 
         /*Save the last activity time*/
@@ -604,6 +612,23 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
         int32_t i;
         uint32_t child_cnt = lv_obj_get_child_count(obj);
 
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+        /*Check only the children around the point if they are indexed*/
+        const uint32_t * ids;
+        uint32_t id_cnt;
+        lv_area_t point_area;
+        lv_area_set(&point_area, p_trans.x, p_trans.y, p_trans.x, p_trans.y);
+        if(child_cnt >= LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN &&
+           lv_obj_spatial_index_query(obj, &point_area, &ids, &id_cnt)) {
+            for(i = id_cnt - 1; i >= 0; i--) {
+                lv_obj_t * child = obj->spec_attr->children[ids[i]];
+                found_p = lv_indev_search_obj(child, &p_trans);
+                if(found_p) return found_p;
+            }
+            child_cnt = 0;
+        }
+#endif
+
         /*If a child matches use it*/
         for(i = child_cnt - 1; i >= 0; i--) {
             lv_obj_t * child = obj->spec_attr->children[i];
@@ -687,6 +712,31 @@ lv_result_t lv_indev_send_event(lv_indev_t * indev, lv_event_code_t code, void *
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_USE_PERF_MONITOR
+/**
+ * Report the read data to the system monitor to measure the input latency if it can change the display.
+ * Must be called before the new data is processed.
+ * @param indev pointer to an input device
+ * @param data pointer to the data read from the input device
+ */
+static void indev_report_input(lv_indev_t * indev, const lv_indev_data_t * data)
+{
+    bool changed = data->state != indev->state;
+    if(data->state == LV_INDEV_STATE_PRESSED) {
+        if(indev->type == LV_INDEV_TYPE_POINTER) {
+            changed |= data->point.x != indev->pointer.last_raw_point.x ||
+                       data->point.y != indev->pointer.last_raw_point.y;
+        }
+        else if(indev->type == LV_INDEV_TYPE_KEYPAD) {
+            changed |= data->key != indev->keypad.last_key;
+        }
+    }
+    if(indev->type == LV_INDEV_TYPE_ENCODER) changed |= data->enc_diff != 0;
+
+    if(changed) lv_sysmon_report_input(indev->disp, data->timestamp ? data->timestamp : lv_tick_get());
+}
+#endif
+
 /**
  * Process a new point from LV_INDEV_TYPE_POINTER input device
  * @param i pointer to an input device
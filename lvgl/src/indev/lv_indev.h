@@ -68,6 +68,8 @@ typedef struct {
 
     lv_indev_state_t state; /**< LV_INDEV_STATE_RELEASED or LV_INDEV_STATE_PRESSED*/
     bool continue_reading;  /**< If set to true, the read callback is invoked again, unless the device is in event-driven mode*/
+    uint32_t timestamp;     /**< When the input happened in `lv_tick_get()` time, e.g. from the driver's event.
+                                 0: at the time of reading. Used to measure the input latency.*/
 
     lv_indev_gesture_type_t gesture_type[LV_INDEV_GESTURE_CNT]; /* Current gesture types, per gesture */
     void * gesture_data[LV_INDEV_GESTURE_CNT]; /* Used to store data per gesture */
@@ -9,6 +9,7 @@
 #include "lv_flex.h"
 #include "../lv_layout.h"
 #include "../../core/lv_obj_private.h"
+#include "../../core/lv_obj_spatial_index_private.h"
 
 #if LV_USE_FLEX
 
@@ -470,6 +471,9 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
             item->coords.y2 += diff_y;
             lv_obj_invalidate(item);
             lv_obj_move_children_by(item, diff_x, diff_y, false);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+            lv_obj_spatial_index_mark_dirty(cont);
+#endif
         }
 
         if(!(f->row && rtl)) main_pos += area_get_main_size(&item->coords) + item_gap + place_gap
@@ -13,6 +13,7 @@
 #include "../../stdlib/lv_string.h"
 #include "../lv_layout.h"
 #include "../../core/lv_obj_private.h"
+#include "../../core/lv_obj_spatial_index_private.h"
 #include "../../core/lv_global.h"
 /*********************
  *      DEFINES
@@ -302,26 +303,30 @@ static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
     c->x = lv_malloc(sizeof(int32_t) * c->col_num);
     c->w = lv_malloc(sizeof(int32_t) * c->col_num);
 
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells.
+     *Visit the children only once and let each of them grow its own track*/
     uint32_t i;
+    bool has_content = false;
     for(i = 0; i < c->col_num; i++) {
-        int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(col_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t col_span = get_col_span(item);
-                if(col_span != 1) continue;
-
-                uint32_t col_pos = get_col_pos(item);
-                if(col_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_width(item));
-            }
-            if(size >= 0) c->w[i] = size;
-            else c->w[i] = 0;
+            c->w[i] = 0;
+            has_content = true;
+        }
+    }
+
+    if(has_content) {
+        uint32_t ci;
+        uint32_t child_cnt = lv_obj_get_child_count(cont);
+        for(ci = 0; ci < child_cnt; ci++) {
+            lv_obj_t * item = cont->spec_attr->children[ci];
+            if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+            uint32_t col_span = get_col_span(item);
+            if(col_span != 1) continue;
+
+            uint32_t col_pos = get_col_pos(item);
+            if(col_pos >= c->col_num || !IS_CONTENT(col_templ[col_pos])) continue;
+
+            c->w[col_pos] = LV_MAX(c->w[col_pos], lv_obj_get_width(item));
         }
     }
 
@@ -391,26 +396,30 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
     c->row_num = count_tracks(row_templ);
     c->y = lv_malloc(sizeof(int32_t) * c->row_num);
     c->h = lv_malloc(sizeof(int32_t) * c->row_num);
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells.
+     *Visit the children only once and let each of them grow its own track*/
     uint32_t i;
+    bool has_content = false;
     for(i = 0; i < c->row_num; i++) {
-        int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(row_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t row_span = get_row_span(item);
-                if(row_span != 1) continue;
-
-                uint32_t row_pos = get_row_pos(item);
-                if(row_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_height(item));
-            }
-            if(size >= 0) c->h[i] = size;
-            else c->h[i] = 0;
+            c->h[i] = 0;
+            has_content = true;
+        }
+    }
+
+    if(has_content) {
+        uint32_t ci;
+        uint32_t child_cnt = lv_obj_get_child_count(cont);
+        for(ci = 0; ci < child_cnt; ci++) {
+            lv_obj_t * item = cont->spec_attr->children[ci];
+            if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+            uint32_t row_span = get_row_span(item);
+            if(row_span != 1) continue;
+
+            uint32_t row_pos = get_row_pos(item);
+            if(row_pos >= c->row_num || !IS_CONTENT(row_templ[row_pos])) continue;
+
+            c->h[row_pos] = LV_MAX(c->h[row_pos], lv_obj_get_height(item));
         }
     }
 
@@ -570,6 +579,9 @@ static void item_repos(lv_obj_t * item, lv_grid_calc_t * c, item_repos_hint_t *
         item->coords.y2 += diff_y;
         lv_obj_invalidate(item);
         lv_obj_move_children_by(item, diff_x, diff_y, false);
+#if LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN > 0
+        lv_obj_spatial_index_mark_dirty(lv_obj_get_parent(item));
+#endif
     }
 }
 
@@ -187,6 +187,9 @@ static bool freetype_image_create_cb(lv_freetype_image_cache_data_t * data, void
     uint32_t pitch = glyph_bitmap->bitmap.pitch;
     uint32_t stride = lv_draw_buf_width_to_stride(box_w, col_format);
     data->draw_buf = lv_draw_buf_create_ex(font_draw_buf_handlers, box_w, box_h, col_format, stride);
+#if LV_USE_MEM_TAGS
+    lv_draw_buf_set_mem_tag(data->draw_buf, LV_MEM_TAG_FONT);
+#endif
     lv_draw_buf_clear(data->draw_buf, NULL);
 
     for(int y = 0; y < box_h; ++y) {
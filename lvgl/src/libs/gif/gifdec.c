@@ -8,6 +8,9 @@
 #include <string.h>
 #include <stdbool.h>
 
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_IMAGE
+
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #define MAX(A, B) ((A) > (B) ? (A) : (B))
 
@@ -34,6 +34,9 @@ Rename this file to lodepng.cpp to use it for C++, or to lodepng.c to use it for
 
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_IMAGE
+
 #ifdef LODEPNG_COMPILE_DISK
     #include <limits.h> /* LONG_MAX */
     #include <stdio.h> /* file handling */
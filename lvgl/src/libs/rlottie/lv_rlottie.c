@@ -17,6 +17,9 @@
 /*********************
 *      DEFINES
 *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_LOTTIE
+
 #define MY_CLASS (&lv_rlottie_class)
 #define LV_ARGB32   32
 
@@ -18,6 +18,9 @@
 /*********************
 *      DEFINES
 *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_IMAGE
+
 #ifndef M_PI
     #define M_PI 3.1415926f
 #endif
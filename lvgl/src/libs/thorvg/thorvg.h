@@ -21,6 +21,10 @@
 #include "../../stdlib/lv_string.h"
 #include "../../misc/lv_assert.h"
 
+/* Attribute the allocations of ThorVG to it */
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_THORVG
+
 #ifdef TVG_API
     #undef TVG_API
 #endif
@@ -32,6 +32,9 @@
 #include "tvgLottieBuilder.h"
 #include "tvgLottieExpressions.h"
 
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_LOTTIE
+
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -29,6 +29,9 @@
 #include "tvgLottieBuilder.h"
 #include "tvgStr.h"
 
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_LOTTIE
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -29,6 +29,9 @@
 #include "tvgLottieParser.h"
 #include "tvgLottieExpressions.h"
 
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_LOTTIE
+
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
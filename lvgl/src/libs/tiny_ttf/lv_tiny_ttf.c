@@ -16,6 +16,8 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_FONT
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #define STBRP_STATIC
@@ -538,6 +540,10 @@ static bool tiny_ttf_draw_data_cache_create_cb(tiny_ttf_cache_data_t * node, voi
         return false;
     }
 
+#if LV_USE_MEM_TAGS
+    lv_draw_buf_set_mem_tag(draw_buf, LV_MEM_TAG_FONT);
+#endif
+
     lv_draw_buf_clear(draw_buf, NULL);
 
     uint32_t stride = draw_buf->header.stride;
@@ -230,6 +230,67 @@
     #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+/** Serve small `lv_malloc()` requests from per-size-class slabs placed on top of the selected allocator.
+ *  Widgets, styles and event descriptors are made of many small short-lived allocations which are
+ *  much cheaper to take from a free list than from the general purpose heap. */
+#ifndef LV_USE_MEM_SLAB
+    #ifdef CONFIG_LV_USE_MEM_SLAB
+        #define LV_USE_MEM_SLAB CONFIG_LV_USE_MEM_SLAB
+    #else
+        #define LV_USE_MEM_SLAB 0
+    #endif
+#endif
+#if LV_USE_MEM_SLAB
+    /** Memory reserved for the slabs at `lv_init()`. Requests fall back to the allocator when it's used up. */
+    #ifndef LV_MEM_SLAB_SIZE
+        #ifdef CONFIG_LV_MEM_SLAB_SIZE
+            #define LV_MEM_SLAB_SIZE CONFIG_LV_MEM_SLAB_SIZE
+        #else
+            #define LV_MEM_SLAB_SIZE (256 * 1024U)          /**< [bytes] */
+        #endif
+    #endif
+
+    /** Size of one slab. A slab holds blocks of only one size class and can be reused by another class
+     *  once all of its blocks are freed. Must be larger than `LV_MEM_SLAB_MAX_SIZE`. */
+    #ifndef LV_MEM_SLAB_CHUNK_SIZE
+        #ifdef CONFIG_LV_MEM_SLAB_CHUNK_SIZE
+            #define LV_MEM_SLAB_CHUNK_SIZE CONFIG_LV_MEM_SLAB_CHUNK_SIZE
+        #else
+            #define LV_MEM_SLAB_CHUNK_SIZE (4 * 1024U)      /**< [bytes] */
+        #endif
+    #endif
+
+    /** Largest request served from the slabs. Larger requests go to the allocator directly. */
+    #ifndef LV_MEM_SLAB_MAX_SIZE
+        #ifdef CONFIG_LV_MEM_SLAB_MAX_SIZE
+            #define LV_MEM_SLAB_MAX_SIZE CONFIG_LV_MEM_SLAB_MAX_SIZE
+        #else
+            #define LV_MEM_SLAB_MAX_SIZE 256                /**< [bytes] */
+        #endif
+    #endif
+
+    /** Number of free blocks per size class each thread can keep for itself, so that e.g. the
+     *  draw threads don't contend on the slab lock. 0: disable. Requires `LV_OS_PTHREAD`. */
+    #ifndef LV_MEM_SLAB_THREAD_CACHE_CNT
+        #ifdef CONFIG_LV_MEM_SLAB_THREAD_CACHE_CNT
+            #define LV_MEM_SLAB_THREAD_CACHE_CNT CONFIG_LV_MEM_SLAB_THREAD_CACHE_CNT
+        #else
+            #define LV_MEM_SLAB_THREAD_CACHE_CNT 0
+        #endif
+    #endif
+#endif
+
+/** Attribute each `lv_malloc()` to a subsystem (Widgets, styles, layers, images, fonts, ...) and
+ *  keep the current and peak size allocated by each. Works with every `LV_USE_STDLIB_MALLOC`.
+ *  Adds a header of two `size_t`s to every allocation. See `lv_mem_tag_get_info()`. */
+#ifndef LV_USE_MEM_TAGS
+    #ifdef CONFIG_LV_USE_MEM_TAGS
+        #define LV_USE_MEM_TAGS CONFIG_LV_USE_MEM_TAGS
+    #else
+        #define LV_USE_MEM_TAGS 0
+    #endif
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -366,6 +427,18 @@
     #endif
 #endif
 
+/** Allocate the draw tasks and their descriptors from per-layer arenas made of chunks of this size
+ *  instead of calling `lv_malloc()` for each draw task. When all the draw tasks of a layer are finished
+ *  its chunks are given back to a pool and reused for the next tasks, so steady frames don't allocate.
+ *  Set it to 0 to allocate each draw task separately. */
+#ifndef LV_DRAW_TASK_ARENA_SIZE
+    #ifdef CONFIG_LV_DRAW_TASK_ARENA_SIZE
+        #define LV_DRAW_TASK_ARENA_SIZE CONFIG_LV_DRAW_TASK_ARENA_SIZE
+    #else
+        #define LV_DRAW_TASK_ARENA_SIZE 0   /**< [bytes]*/
+    #endif
+#endif
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -567,7 +640,9 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /** Allow buffering some shadow calculation.
          *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
+         *  `shadow_width + radius`.  The blurred corners are kept in an LRU cache with
+         *  `2 * LV_DRAW_SW_SHADOW_CACHE_SIZE^2` bytes budget, so one shadow of this size or several
+         *  smaller ones fit. */
         #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -578,7 +653,7 @@
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6` bytes are used per circle (the least recently used radiuses are dropped).
          *  - 0: disables caching */
         #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
@@ -587,6 +662,19 @@
                 #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
             #endif
         #endif
+
+        /** Size of the cache of arcs' ring coverage in bytes.
+         *  With the cached ring only the angle needs to be applied when an arc is drawn again
+         *  with the same radius and width, e.g. for rotating or animated arcs.
+         *  A quarter of the ring is cached, using `radius^2` bytes (+ `arc_width^2` for rounded arcs).
+         *  - 0: disables caching */
+        #ifndef LV_DRAW_SW_ARC_CACHE_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_ARC_CACHE_SIZE
+                #define LV_DRAW_SW_ARC_CACHE_SIZE CONFIG_LV_DRAW_SW_ARC_CACHE_SIZE
+            #else
+                #define LV_DRAW_SW_ARC_CACHE_SIZE 0
+            #endif
+        #endif
     #endif
 
     #ifndef LV_USE_DRAW_SW_ASM
@@ -1226,6 +1314,25 @@
     #endif
 #endif
 
+/** 1: Draw a green border around the Widgets drawn from their render cache and a red one if the cache was (re)rendered*/
+#ifndef LV_USE_RENDER_CACHE_DEBUG
+    #ifdef CONFIG_LV_USE_RENDER_CACHE_DEBUG
+        #define LV_USE_RENDER_CACHE_DEBUG CONFIG_LV_USE_RENDER_CACHE_DEBUG
+    #else
+        #define LV_USE_RENDER_CACHE_DEBUG 0
+    #endif
+#endif
+
+/** 1: Count the pixel writes of each frame to measure the overdraw and optionally draw a heatmap over the
+ *  redrawn areas. Works with the software renderer. Enable it with `lv_refr_overdraw_enable()`. */
+#ifndef LV_USE_OVERDRAW_DEBUG
+    #ifdef CONFIG_LV_USE_OVERDRAW_DEBUG
+        #define LV_USE_OVERDRAW_DEBUG CONFIG_LV_USE_OVERDRAW_DEBUG
+    #else
+        #define LV_USE_OVERDRAW_DEBUG 0
+    #endif
+#endif
+
 /** 1: Adds the following behaviors for debugging:
  *  - Draw overlays with different colors for each draw_unit's tasks.
  *  - Draw index number of draw unit on white background.
@@ -1307,6 +1414,17 @@
     #endif
 #endif
 
+/** Precompute the built-in ease-in, ease-out, ease-in-out and overshoot animation paths
+ *  into lookup tables on their first use. Each used path allocates about 2 kB and its
+ *  evaluation becomes a table read instead of solving the cubic bezier curve. */
+#ifndef LV_ANIM_PATH_LUT
+    #ifdef CONFIG_LV_ANIM_PATH_LUT
+        #define LV_ANIM_PATH_LUT CONFIG_LV_ANIM_PATH_LUT
+    #else
+        #define LV_ANIM_PATH_LUT        0
+    #endif
+#endif
+
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #ifndef LV_OBJ_STYLE_CACHE
     #ifdef CONFIG_LV_OBJ_STYLE_CACHE
@@ -1316,6 +1434,51 @@
     #endif
 #endif
 
+/** Number of resolved style properties cached per object (0: disable).
+ *  Must be a power of 2. Each object allocates `LV_OBJ_STYLE_RESOLVED_CACHE_SIZE * 12` bytes
+ *  (8 bytes on 32-bit systems) on the first style property read. 64 is enough for most widgets.
+ *  Repeated property reads of unchanged objects (e.g. while redrawing) become a single lookup. */
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE    0
+    #endif
+#endif
+
+/** Memory budget for the rendered content of Widgets with `lv_obj_set_render_cache(obj, true)` (0: disable).
+ *  These Widgets and their children are rendered once into an ARGB8888 buffer which is drawn as an image
+ *  until one of them changes. The least recently drawn buffers are freed when the budget is exceeded. */
+#ifndef LV_OBJ_RENDER_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_RENDER_CACHE_SIZE
+        #define LV_OBJ_RENDER_CACHE_SIZE CONFIG_LV_OBJ_RENDER_CACHE_SIZE
+    #else
+        #define LV_OBJ_RENDER_CACHE_SIZE    0   /**< [bytes]*/
+    #endif
+#endif
+
+/** 1: Skip drawing Widgets which are fully covered by opaque Widgets above them in the refreshed area.
+ *  The opaque areas are collected once per refresh and checked before drawing each Widget.
+ *  See `lv_refr_get_occlusion_stats()` for the number of pixels saved. */
+#ifndef LV_USE_OCCLUSION_CULLING
+    #ifdef CONFIG_LV_USE_OCCLUSION_CULLING
+        #define LV_USE_OCCLUSION_CULLING CONFIG_LV_USE_OCCLUSION_CULLING
+    #else
+        #define LV_USE_OCCLUSION_CULLING    0
+    #endif
+#endif
+
+/** Keep a spatial index (a uniform grid) of the children of Widgets having at least this many children (0: disable).
+ *  Hit-testing and redrawing an area check only the children around the point or area
+ *  instead of all of them. It pays off for screens or containers with hundreds of children. */
+#ifndef LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN
+    #ifdef CONFIG_LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN
+        #define LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN CONFIG_LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN
+    #else
+        #define LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN    0
+    #endif
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -3225,6 +3388,23 @@
                 #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /**< [bytes] */
             #endif
         #endif
+        /** Max. number of threads with their own lock-free trace buffer of `LV_PROFILER_BUILTIN_BUF_SIZE`.
+         *  Used if `tid_get_cb` is set in the profiler's config. */
+        #ifndef LV_PROFILER_BUILTIN_THREAD_MAX
+            #ifdef CONFIG_LV_PROFILER_BUILTIN_THREAD_MAX
+                #define LV_PROFILER_BUILTIN_THREAD_MAX CONFIG_LV_PROFILER_BUILTIN_THREAD_MAX
+            #else
+                #define LV_PROFILER_BUILTIN_THREAD_MAX 8
+            #endif
+        #endif
+        /** Default output format. 0: Android systrace text; 1: Chrome trace event JSON */
+        #ifndef LV_PROFILER_BUILTIN_DEFAULT_FORMAT
+            #ifdef CONFIG_LV_PROFILER_BUILTIN_DEFAULT_FORMAT
+                #define LV_PROFILER_BUILTIN_DEFAULT_FORMAT CONFIG_LV_PROFILER_BUILTIN_DEFAULT_FORMAT
+            #else
+                #define LV_PROFILER_BUILTIN_DEFAULT_FORMAT 0
+            #endif
+        #endif
     #endif
 
     /** Header to include for profiler */
@@ -3272,6 +3452,15 @@
         #endif
     #endif
 
+    /** Profiler function to record the value of a counter, e.g. memory usage */
+    #ifndef LV_PROFILER_COUNTER
+        #ifdef CONFIG_LV_PROFILER_COUNTER
+            #define LV_PROFILER_COUNTER CONFIG_LV_PROFILER_COUNTER
+        #else
+            #define LV_PROFILER_COUNTER   LV_PROFILER_BUILTIN_COUNTER
+        #endif
+    #endif
+
     /*Enable layout profiler*/
     #ifndef LV_PROFILER_LAYOUT
         #ifdef LV_KCONFIG_PRESENT
@@ -3742,6 +3931,15 @@
             #define LV_X11_RENDER_MODE_FULL    0  /**< Full render mode */
         #endif
     #endif
+    /** Share the window image with the X server via MIT-SHM (XShmPutImage), requires linking libXext.
+     *  Falls back to XPutImage if the extension is not available (e.g. remote X server). */
+    #ifndef LV_X11_USE_SHM
+        #ifdef CONFIG_LV_X11_USE_SHM
+            #define LV_X11_USE_SHM CONFIG_LV_X11_USE_SHM
+        #else
+            #define LV_X11_USE_SHM             0
+        #endif
+    #endif
 #endif
 
 /** Use Wayland to open a window and handle input on Linux or BSD desktops */
@@ -3929,6 +4127,36 @@
             #define LV_LINUX_DRM_GBM_BUFFERS 0
         #endif
     #endif
+
+    /** LV_DISPLAY_RENDER_MODE_DIRECT: LVGL renders into the two screen sized DRM buffers directly.
+     *  LV_DISPLAY_RENDER_MODE_PARTIAL: LVGL renders into a smaller buffer that is copied into the DRM buffers.
+     *  In both modes only the changed areas are sent to the kernel in the FB_DAMAGE_CLIPS plane property. */
+    #ifndef LV_LINUX_DRM_RENDER_MODE
+        #ifdef CONFIG_LV_LINUX_DRM_RENDER_MODE
+            #define LV_LINUX_DRM_RENDER_MODE CONFIG_LV_LINUX_DRM_RENDER_MODE
+        #else
+            #define LV_LINUX_DRM_RENDER_MODE LV_DISPLAY_RENDER_MODE_DIRECT
+        #endif
+    #endif
+
+    /** Size of the draw buffer in partial render mode (in number of rows) */
+    #ifndef LV_LINUX_DRM_BUFFER_SIZE
+        #ifdef CONFIG_LV_LINUX_DRM_BUFFER_SIZE
+            #define LV_LINUX_DRM_BUFFER_SIZE CONFIG_LV_LINUX_DRM_BUFFER_SIZE
+        #else
+            #define LV_LINUX_DRM_BUFFER_SIZE 60
+        #endif
+    #endif
+
+    /** Use three DRM buffers in partial render mode, so rendering can start while a page flip is pending.
+     *  Call `lv_linux_drm_handle_events()` when the fd returned by `lv_linux_drm_get_fd()` is readable. */
+    #ifndef LV_LINUX_DRM_TRIPLE_BUFFER
+        #ifdef CONFIG_LV_LINUX_DRM_TRIPLE_BUFFER
+            #define LV_LINUX_DRM_TRIPLE_BUFFER CONFIG_LV_LINUX_DRM_TRIPLE_BUFFER
+        #else
+            #define LV_LINUX_DRM_TRIPLE_BUFFER 0
+        #endif
+    #endif
 #endif
 
 /** Interface for TFT_eSPI */
@@ -3948,6 +4176,18 @@
         #define LV_USE_EVDEV    0
     #endif
 #endif
+#if LV_USE_EVDEV
+    /** Read the devices in a thread blocking on their file descriptor instead of polling them
+     *  from the indev timer. Pointer motion is coalesced between reads, the indevs are switched
+     *  to event mode and read with `lv_lock()` held. Requires `LV_USE_OS`. */
+    #ifndef LV_EVDEV_USE_THREAD
+        #ifdef CONFIG_LV_EVDEV_USE_THREAD
+            #define LV_EVDEV_USE_THREAD CONFIG_LV_EVDEV_USE_THREAD
+        #else
+            #define LV_EVDEV_USE_THREAD    0
+        #endif
+    #endif
+#endif
 
 /** Driver for libinput input devices */
 #ifndef LV_USE_LIBINPUT
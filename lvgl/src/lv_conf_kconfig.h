@@ -283,6 +283,16 @@ extern "C" {
 #  define CONFIG_LV_LINUX_FBDEV_RENDER_MODE LV_DISPLAY_RENDER_MODE_FULL
 #endif
 
+/*------------------
+ * LINUX DRM
+ *-----------------*/
+
+#ifdef CONFIG_LV_LINUX_DRM_RENDER_MODE_PARTIAL
+#  define CONFIG_LV_LINUX_DRM_RENDER_MODE LV_DISPLAY_RENDER_MODE_PARTIAL
+#elif defined(CONFIG_LV_LINUX_DRM_RENDER_MODE_DIRECT)
+#  define CONFIG_LV_LINUX_DRM_RENDER_MODE LV_DISPLAY_RENDER_MODE_DIRECT
+#endif
+
 
 #ifdef CONFIG_LV_USE_CALENDAR
 #  ifdef CONFIG_LV_CALENDAR_WEEK_STARTS_MONDAY
@@ -141,11 +141,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -189,6 +184,10 @@ void lv_init(void)
 
     lv_mem_init();
 
+#if LV_USE_MEM_SLAB
+    lv_mem_slab_init();
+#endif
+
     lv_draw_buf_init_handlers();
 
 #if LV_USE_SPAN != 0
@@ -500,6 +499,10 @@ void lv_deinit(void)
     lv_objid_builtin_destroy();
 #endif
 
+#if LV_USE_MEM_SLAB
+    lv_mem_slab_deinit();
+#endif
+
     lv_mem_deinit();
 
     lv_initialized = false;
@@ -55,6 +55,8 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -97,6 +99,7 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->hit_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -138,6 +141,7 @@ lv_cache_entry_t * lv_cache_add(lv_cache_t * cache, const void * key, void * use
     lv_cache_entry_t * entry = cache_add_internal_no_lock(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->miss_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -158,6 +162,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            cache->hit_cnt++;
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_CACHE_END;
@@ -187,6 +192,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
     }
     else {
         lv_cache_entry_acquire_data(entry);
+        cache->miss_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -202,7 +208,10 @@ void lv_cache_reserve(lv_cache_t * cache, uint32_t reserved_size, void * user_da
     for(lv_cache_reserve_cond_res_t reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data);
         reserve_cond_res == LV_CACHE_RESERVE_COND_NEED_VICTIM;
         reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data))
-        cache_evict_one_internal_no_lock(cache, user_data);
+        if(cache_evict_one_internal_no_lock(cache, user_data) == false) {
+            LV_LOG_ERROR("No victim found");
+            break;
+        }
 
     LV_PROFILER_CACHE_END;
 }
@@ -229,6 +238,10 @@ bool lv_cache_evict_one(lv_cache_t * cache, void * user_data)
     bool res = cache_evict_one_internal_no_lock(cache, user_data);
     lv_mutex_unlock(&cache->lock);
 
+    if(res == false) {
+        LV_LOG_ERROR("No victim found");
+    }
+
     LV_PROFILER_CACHE_END;
     return res;
 }
@@ -294,6 +307,28 @@ const char * lv_cache_get_name(lv_cache_t * cache)
     return cache->name;
 }
 
+uint32_t lv_cache_get_hit_count(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+    return cache->hit_cnt;
+}
+
+uint32_t lv_cache_get_miss_count(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+    return cache->miss_cnt;
+}
+
+void lv_cache_reset_stats(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+
+    lv_mutex_lock(&cache->lock);
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+    lv_mutex_unlock(&cache->lock);
+}
+
 lv_iter_t * lv_cache_iter_create(lv_cache_t * cache)
 {
     LV_ASSERT_NULL(cache);
@@ -328,7 +363,6 @@ static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_dat
     lv_cache_entry_t * victim = cache->clz->get_victim_cb(cache, user_data);
 
     if(victim == NULL) {
-        LV_LOG_ERROR("No victim found");
         return false;
     }
 
@@ -348,8 +382,11 @@ static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const v
 
     for(; reserve_cond_res == LV_CACHE_RESERVE_COND_NEED_VICTIM;
         reserve_cond_res = cache->clz->reserve_cond_cb(cache, key, 0, user_data))
-        if(cache_evict_one_internal_no_lock(cache, user_data) == false)
+        if(cache_evict_one_internal_no_lock(cache, user_data) == false) {
+            /*All entries are in use. The caller can still work without caching the data.*/
+            LV_LOG_INFO("No victim found in the %s cache", cache->name ? cache->name : "unnamed");
             return NULL;
+        }
 
     lv_cache_entry_t * entry = cache->clz->add_cb(cache, key, user_data);
 
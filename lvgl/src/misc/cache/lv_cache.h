@@ -215,6 +215,28 @@ void lv_cache_set_name(lv_cache_t * cache, const char * name);
  */
 const char * lv_cache_get_name(lv_cache_t * cache);
 
+/**
+ * Get how many times the requested data was found in the cache by
+ * `lv_cache_acquire()` or `lv_cache_acquire_or_create()`.
+ * @param cache         The cache object pointer.
+ * @return              Returns the number of cache hits since the creation or the last `lv_cache_reset_stats()`.
+ */
+uint32_t lv_cache_get_hit_count(lv_cache_t * cache);
+
+/**
+ * Get how many times the requested data was not in the cache and a new entry had to be added
+ * by `lv_cache_add()` or `lv_cache_acquire_or_create()`.
+ * @param cache         The cache object pointer.
+ * @return              Returns the number of cache misses since the creation or the last `lv_cache_reset_stats()`.
+ */
+uint32_t lv_cache_get_miss_count(lv_cache_t * cache);
+
+/**
+ * Reset the hit and miss counters of a cache.
+ * @param cache         The cache object pointer.
+ */
+void lv_cache_reset_stats(lv_cache_t * cache);
+
 /**
  * Create an iterator for the cache object. The iterator is used to iterate over all cache entries.
  * @param cache         The cache object pointer to create the iterator.
@@ -138,6 +138,9 @@ struct _lv_cache_t {
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< Name of the cache */
+
+    uint32_t hit_cnt;                 /**< Number of lookups which found the data in the cache */
+    uint32_t miss_cnt;                /**< Number of times the data had to be created and added to the cache */
 };
 
 /**
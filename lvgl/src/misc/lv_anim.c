@@ -36,14 +36,23 @@
  *      TYPEDEFS
  **********************/
 
+typedef enum {
+    PATH_LUT_EASE_IN,
+    PATH_LUT_EASE_OUT,
+    PATH_LUT_EASE_IN_OUT,
+    PATH_LUT_OVERSHOOT,
+} path_lut_id_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_timer(lv_timer_t * param);
 static void anim_mark_list_change(void);
-static void anim_completed_handler(lv_anim_t * a);
+static bool anim_completed_handler(lv_anim_t * a);
 static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1,
                                          int32_t y1, int32_t x2, int32_t y2);
+static int32_t lv_anim_path_cubic_bezier_lut(const lv_anim_t * a, path_lut_id_t lut_id, int32_t x1,
+                                             int32_t y1, int32_t x2, int32_t y2);
 static void lv_anim_pause_for_internal(lv_anim_t * a, uint32_t ms);
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(const lv_anim_t * a_current);
@@ -78,6 +87,14 @@ void lv_anim_core_init(void)
 void lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+
+#if LV_ANIM_PATH_LUT
+    uint32_t i;
+    for(i = 0; i < LV_ANIM_PATH_LUT_CNT; i++) {
+        lv_free(state.path_lut[i]);
+        state.path_lut[i] = NULL;
+    }
+#endif
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -271,25 +288,25 @@ int32_t lv_anim_path_linear(const lv_anim_t * a)
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(1), LV_BEZIER_VAL_FLOAT(1));
+    return lv_anim_path_cubic_bezier_lut(a, PATH_LUT_EASE_IN, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
+                                         LV_BEZIER_VAL_FLOAT(1), LV_BEZIER_VAL_FLOAT(1));
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
+    return lv_anim_path_cubic_bezier_lut(a, PATH_LUT_EASE_OUT, LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0),
+                                         LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
+    return lv_anim_path_cubic_bezier_lut(a, PATH_LUT_EASE_IN_OUT, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
+                                         LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, 341, 0, 683, 1300);
+    return lv_anim_path_cubic_bezier_lut(a, PATH_LUT_OVERSHOOT, 341, 0, 683, 1300);
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
@@ -570,6 +587,8 @@ static void anim_timer(lv_timer_t * param)
          * because the list is changed meanwhile
          */
         state.anim_list_changed = false;
+        lv_anim_t * a_next = NULL;
+        bool deleted = false;
 
         if(!a->is_paused && a->run_round != state.anim_run_round) {
             a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
@@ -613,16 +632,21 @@ static void anim_timer(lv_timer_t * param)
 
                     /*If the time is elapsed the animation is ready*/
                     if(a->act_time >= a->duration) {
-                        anim_completed_handler(a);
+                        a_next = lv_ll_get_next(anim_ll_p, a);
+                        deleted = anim_completed_handler(a);
                     }
                 }
             }
         }
 
         /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
+         *the reading of the list from here -> start from the head.
+         *Deleting only the completed animation itself doesn't count as a change,
+         *so many animations ending in the same round don't restart the list each time.*/
         if(state.anim_list_changed)
             a = lv_ll_get_head(anim_ll_p);
+        else if(deleted)
+            a = a_next;
         else
             a = lv_ll_get_next(anim_ll_p, a);
     }
@@ -633,8 +657,9 @@ static void anim_timer(lv_timer_t * param)
  * Called when an animation is completed to do the necessary things
  * e.g. repeat, play in reverse, delete etc.
  * @param a pointer to an animation descriptor
+ * @return  true: the animation was deleted
  */
-static void anim_completed_handler(lv_anim_t * a)
+static bool anim_completed_handler(lv_anim_t * a)
 {
     /*In the end of a forward anim decrement repeat cnt.*/
     if(a->reverse_play_in_progress == 0 && a->repeat_cnt > 0 && a->repeat_cnt != LV_ANIM_REPEAT_INFINITE) {
@@ -649,13 +674,16 @@ static void anim_completed_handler(lv_anim_t * a)
         /*Delete the animation from the list.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
         lv_ll_remove(anim_ll_p, a);
-        /*Flag that the list has changed*/
+        /*Flag that the list has changed to pause the timer if needed,
+         *but `anim_timer` is only interested in the changes made by the callbacks*/
         anim_mark_list_change();
+        state.anim_list_changed = false;
 
         /*Call the callback function at the end*/
         if(a->completed_cb != NULL) a->completed_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
         lv_free(a);
+        return true;
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -680,6 +708,8 @@ static void anim_completed_handler(lv_anim_t * a)
             a->reverse_duration = tmp;
         }
     }
+
+    return false;
 }
 
 static void anim_mark_list_change(void)
@@ -705,6 +735,45 @@ static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1, int32_
     return new_value;
 }
 
+/**
+ * Same as `lv_anim_path_cubic_bezier` but the bezier steps of the curve are taken
+ * from a lookup table which is calculated on the first use.
+ * The steps are calculated for every `t`, so the result is exactly the same.
+ */
+static int32_t lv_anim_path_cubic_bezier_lut(const lv_anim_t * a, path_lut_id_t lut_id, int32_t x1,
+                                             int32_t y1, int32_t x2, int32_t y2)
+{
+#if LV_ANIM_PATH_LUT
+    int16_t * lut = state.path_lut[lut_id];
+    if(lut == NULL) {
+        lut = lv_malloc((LV_BEZIER_VAL_MAX + 1) * sizeof(int16_t));
+        if(lut) {
+            int32_t t;
+            for(t = 0; t <= LV_BEZIER_VAL_MAX; t++) {
+                lut[t] = (int16_t)lv_cubic_bezier(t, x1, y1, x2, y2);
+            }
+            state.path_lut[lut_id] = lut;
+        }
+    }
+
+    if(lut) {
+        uint32_t t = lv_map(a->act_time, 0, a->duration, 0, LV_BEZIER_VAL_MAX);
+        int32_t step = lut[LV_MIN(t, LV_BEZIER_VAL_MAX)];
+
+        int32_t new_value;
+        new_value = step * (a->end_value - a->start_value);
+        new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+        new_value += a->start_value;
+
+        return new_value;
+    }
+#else
+    LV_UNUSED(lut_id);
+#endif
+
+    return lv_anim_path_cubic_bezier(a, x1, y1, x2, y2);
+}
+
 static void lv_anim_pause_for_internal(lv_anim_t * a, uint32_t ms)
 {
 
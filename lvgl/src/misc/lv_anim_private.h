@@ -20,6 +20,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Number of built-in animation paths which can use a lookup table*/
+#define LV_ANIM_PATH_LUT_CNT 4
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -29,6 +32,9 @@ typedef struct {
     bool anim_run_round;
     lv_timer_t * timer;
     lv_ll_t anim_ll;
+#if LV_ANIM_PATH_LUT
+    int16_t * path_lut[LV_ANIM_PATH_LUT_CNT];   /**< Precomputed bezier steps of the built-in paths*/
+#endif
 } lv_anim_state_t;
 
 /**********************
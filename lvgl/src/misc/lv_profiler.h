@@ -42,6 +42,7 @@ extern "C" {
 #define LV_PROFILER_END
 #define LV_PROFILER_BEGIN_TAG(tag) LV_UNUSED(tag)
 #define LV_PROFILER_END_TAG(tag)   LV_UNUSED(tag)
+#define LV_PROFILER_COUNTER(name, value) do { LV_UNUSED(name); LV_UNUSED(value); } while(0)
 
 #endif /*LV_USE_PROFILER*/
 
@@ -21,17 +21,30 @@
 
 #define LV_PROFILER_STR_MAX_LEN 128
 #define LV_PROFILER_TICK_PER_SEC_MAX 1000000000 /* Maximum accuracy: 1 nanosecond */
+#define LV_PROFILER_THREAD_NAME_MAX_LEN 16
+#define LV_PROFILER_FLUSH_THREAD_STACK_SIZE (8 * 1024)
 
 #if LV_USE_OS
     #define LV_PROFILER_MULTEX_INIT   lv_mutex_init(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_DEINIT lv_mutex_delete(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_LOCK   lv_mutex_lock(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_UNLOCK lv_mutex_unlock(&profiler_ctx->mutex)
+    #define LV_PROFILER_RING_MAX      LV_PROFILER_BUILTIN_THREAD_MAX
 #else
     #define LV_PROFILER_MULTEX_INIT
     #define LV_PROFILER_MULTEX_DEINIT
     #define LV_PROFILER_MULTEX_LOCK
     #define LV_PROFILER_MULTEX_UNLOCK
+    #define LV_PROFILER_RING_MAX      1
+#endif
+
+/* The owner thread of a ring only writes `head`, the flushing thread only writes `tail` */
+#if defined(__GNUC__) || defined(__clang__)
+    #define LV_PROFILER_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define LV_PROFILER_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+    #define LV_PROFILER_LOAD_ACQUIRE(p)     (*(volatile uint32_t *)(p))
+    #define LV_PROFILER_STORE_RELEASE(p, v) (*(volatile uint32_t *)(p) = (v))
 #endif
 
 /**********************
@@ -43,24 +56,41 @@
  */
 typedef struct {
     uint64_t tick;     /**< The tick value of the profiler item */
-    char tag;          /**< The tag of the profiler item */
     const char * func; /**< A pointer to the function associated with the profiler item */
+    char tag;          /**< The tag of the profiler item */
+    uint32_t value;    /**< The value of a counter item */
 #if LV_USE_OS
-    int tid;           /**< The thread ID of the profiler item */
-    int cpu;         /**< The CPU ID of the profiler item */
+    uint8_t cpu;       /**< The CPU ID of the profiler item */
 #endif
 } lv_profiler_builtin_item_t;
 
+/**
+ * @brief Ring buffer of the items written by one thread
+ */
+typedef struct {
+    lv_profiler_builtin_item_t * item_arr;       /**< Pointer to an array of profiler items */
+    uint32_t head;                               /**< Number of written items, changed only by the owner thread */
+    uint32_t tail;                               /**< Number of flushed items, changed only under the mutex */
+    int tid;                                     /**< The thread ID of the owner thread */
+    char name[LV_PROFILER_THREAD_NAME_MAX_LEN];  /**< The name of the owner thread */
+    bool name_pending;                           /**< The name is not flushed yet */
+} lv_profiler_builtin_ring_t;
+
 /**
  * @brief Structure representing a context for the LVGL built-in profiler
  */
 typedef struct _lv_profiler_builtin_ctx_t {
-    lv_profiler_builtin_item_t * item_arr; /**< Pointer to an array of profiler items */
-    uint32_t item_num;                     /**< Number of profiler items in the array */
-    uint32_t cur_index;                    /**< Index of the current profiler item */
+    lv_profiler_builtin_ring_t ring_arr[LV_PROFILER_RING_MAX]; /**< Per thread ring buffers */
+    uint32_t ring_num;                     /**< Number of ring buffers in use */
+    uint32_t item_num;                     /**< Number of profiler items in a ring buffer */
+    uint32_t flushed_num;                  /**< Number of flushed items (to separate the JSON events) */
     lv_profiler_builtin_config_t config;   /**< Configuration for the built-in profiler */
     bool enable;                           /**< Whether the built-in profiler is enabled */
 #if LV_USE_OS
+    bool shared;                           /**< The threads can't be told apart, they share the first ring buffer */
+    bool flush_thread_exit;                /**< Request the flush thread to exit */
+    lv_thread_t flush_thread;              /**< Thread to flush the ring buffers */
+    lv_thread_sync_t flush_sync;           /**< Wake up the flush thread */
     lv_mutex_t mutex;                      /**< Mutex to protect the built-in profiler */
 #endif
 } lv_profiler_builtin_ctx_t;
@@ -73,7 +103,16 @@ static uint64_t default_tick_get_cb(void);
 static void default_flush_cb(const char * buf);
 static int default_tid_get_cb(void);
 static int default_cpu_get_cb(void);
+static lv_profiler_builtin_ring_t * ring_add_no_lock(int tid);
+static void write_item(const char * func, char tag, uint32_t value);
+static void ring_push(lv_profiler_builtin_ring_t * ring, const char * func, char tag, uint32_t value);
+static bool ring_is_full(lv_profiler_builtin_ring_t * ring);
 static void flush_no_lock(void);
+static void flush_ring_no_lock(lv_profiler_builtin_ring_t * ring);
+#if LV_USE_OS
+    static lv_profiler_builtin_ring_t * ring_get(int tid);
+    static void flush_thread_cb(void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -97,6 +136,7 @@ void lv_profiler_builtin_config_init(lv_profiler_builtin_config_t * config)
     config->flush_cb = default_flush_cb;
     config->tid_get_cb = default_tid_get_cb;
     config->cpu_get_cb = default_cpu_get_cb;
+    config->format = LV_PROFILER_BUILTIN_DEFAULT_FORMAT;
 }
 
 void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
@@ -122,10 +162,16 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
 
     profiler_ctx = lv_malloc_zeroed(sizeof(lv_profiler_builtin_ctx_t));
     LV_ASSERT_MALLOC(profiler_ctx);
+    if(profiler_ctx == NULL) {
+        LV_LOG_ERROR("malloc failed for profiler_ctx");
+        return;
+    }
 
-    profiler_ctx->item_arr = lv_malloc(num * sizeof(lv_profiler_builtin_item_t));
-    LV_ASSERT_MALLOC(profiler_ctx->item_arr);
-    if(profiler_ctx->item_arr == NULL) {
+    profiler_ctx->item_num = num;
+    profiler_ctx->config = *config;
+
+    /*The first ring buffer belongs to the initializing thread*/
+    if(ring_add_no_lock(config->tid_get_cb ? config->tid_get_cb() : 1) == NULL) {
         lv_free(profiler_ctx);
         profiler_ctx = NULL;
         LV_LOG_ERROR("malloc failed for item_arr");
@@ -133,13 +179,30 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
     }
 
     LV_PROFILER_MULTEX_INIT;
-    profiler_ctx->item_num = num;
-    profiler_ctx->config = *config;
+
+#if LV_USE_OS
+    /*All threads would have the same ID, so they have to write the same buffer under the mutex*/
+    profiler_ctx->shared = config->tid_get_cb == NULL || config->tid_get_cb == default_tid_get_cb;
+
+    if(config->flush_thread) {
+        lv_thread_sync_init(&profiler_ctx->flush_sync);
+        lv_thread_init(&profiler_ctx->flush_thread, "lv_profiler", LV_THREAD_PRIO_LOWEST, flush_thread_cb,
+                       LV_PROFILER_FLUSH_THREAD_STACK_SIZE, profiler_ctx);
+    }
+#else
+    profiler_ctx->config.flush_thread = false;
+#endif
 
     if(profiler_ctx->config.flush_cb) {
-        /* add profiler header for perfetto */
-        profiler_ctx->config.flush_cb("# tracer: nop\n");
-        profiler_ctx->config.flush_cb("#\n");
+        if(profiler_ctx->config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON) {
+            /* JSON array format, the closing bracket is optional */
+            profiler_ctx->config.flush_cb("[\n");
+        }
+        else {
+            /* add profiler header for perfetto */
+            profiler_ctx->config.flush_cb("# tracer: nop\n");
+            profiler_ctx->config.flush_cb("#\n");
+        }
     }
 
     lv_profiler_builtin_set_enable(true);
@@ -150,8 +213,21 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
 void lv_profiler_builtin_uninit(void)
 {
     LV_ASSERT_NULL(profiler_ctx);
+
+#if LV_USE_OS
+    if(profiler_ctx->config.flush_thread) {
+        profiler_ctx->flush_thread_exit = true;
+        lv_thread_sync_signal(&profiler_ctx->flush_sync);
+        lv_thread_delete(&profiler_ctx->flush_thread);
+        lv_thread_sync_delete(&profiler_ctx->flush_sync);
+    }
+#endif
+
     LV_PROFILER_MULTEX_DEINIT;
-    lv_free(profiler_ctx->item_arr);
+    uint32_t i;
+    for(i = 0; i < profiler_ctx->ring_num; i++) {
+        lv_free(profiler_ctx->ring_arr[i].item_arr);
+    }
     lv_free(profiler_ctx);
     profiler_ctx = NULL;
 }
@@ -174,41 +250,86 @@ void lv_profiler_builtin_flush(void)
     LV_PROFILER_MULTEX_UNLOCK;
 }
 
-void lv_profiler_builtin_write(const char * func, char tag)
+void lv_profiler_builtin_set_thread_name(const char * name)
 {
-    LV_ASSERT_NULL(profiler_ctx);
-    LV_ASSERT_NULL(func);
+    LV_ASSERT_NULL(name);
 
-    if(!profiler_ctx->enable) {
+    if(!profiler_ctx) {
         return;
     }
 
-    LV_PROFILER_MULTEX_LOCK;
-
-    if(profiler_ctx->cur_index >= profiler_ctx->item_num) {
-        flush_no_lock();
-        profiler_ctx->cur_index = 0;
-    }
-
-    lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[profiler_ctx->cur_index];
-    item->func = func;
-    item->tag = tag;
-    item->tick = profiler_ctx->config.tick_get_cb();
-
 #if LV_USE_OS
-    item->tid = profiler_ctx->config.tid_get_cb();
-    item->cpu = profiler_ctx->config.cpu_get_cb();
+    lv_profiler_builtin_ring_t * ring = profiler_ctx->shared ? NULL : ring_get(profiler_ctx->config.tid_get_cb());
+    if(ring == NULL) {
+        return;
+    }
+#else
+    lv_profiler_builtin_ring_t * ring = &profiler_ctx->ring_arr[0];
 #endif
 
-    profiler_ctx->cur_index++;
-
+    LV_PROFILER_MULTEX_LOCK;
+    lv_strlcpy(ring->name, name, sizeof(ring->name));
+    ring->name_pending = true;
     LV_PROFILER_MULTEX_UNLOCK;
 }
 
+void lv_profiler_builtin_write(const char * func, char tag)
+{
+    LV_ASSERT_NULL(func);
+    write_item(func, tag, 0);
+}
+
+void lv_profiler_builtin_write_counter(const char * name, uint32_t value)
+{
+    LV_ASSERT_NULL(name);
+    write_item(name, 'C', value);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+static void write_item(const char * func, char tag, uint32_t value)
+{
+    LV_ASSERT_NULL(profiler_ctx);
+
+    if(!profiler_ctx->enable) {
+        return;
+    }
+
+#if LV_USE_OS
+    if(profiler_ctx->shared) {
+        lv_profiler_builtin_ring_t * ring = &profiler_ctx->ring_arr[0];
+        LV_PROFILER_MULTEX_LOCK;
+        if(ring_is_full(ring)) {
+            flush_no_lock();
+        }
+        ring_push(ring, func, tag, value);
+        LV_PROFILER_MULTEX_UNLOCK;
+        return;
+    }
+
+    /*Lock-free unless the ring buffer of this thread is full or it's the first event of the thread*/
+    lv_profiler_builtin_ring_t * ring = ring_get(profiler_ctx->config.tid_get_cb());
+    if(ring == NULL) {
+        return;
+    }
+
+    if(ring_is_full(ring)) {
+        LV_PROFILER_MULTEX_LOCK;
+        flush_no_lock();
+        LV_PROFILER_MULTEX_UNLOCK;
+    }
+#else
+    lv_profiler_builtin_ring_t * ring = &profiler_ctx->ring_arr[0];
+    if(ring_is_full(ring)) {
+        flush_no_lock();
+    }
+#endif
+
+    ring_push(ring, func, tag, value);
+}
+
 static uint64_t default_tick_get_cb(void)
 {
     return lv_tick_get();
@@ -229,6 +350,67 @@ static int default_cpu_get_cb(void)
     return 0;
 }
 
+/**
+ * Add a ring buffer for a thread. The mutex must be held if there are other threads already.
+ */
+static lv_profiler_builtin_ring_t * ring_add_no_lock(int tid)
+{
+    uint32_t ring_num = profiler_ctx->ring_num;
+    if(ring_num >= LV_PROFILER_RING_MAX) {
+        LV_LOG_WARN("too many threads, increase LV_PROFILER_BUILTIN_THREAD_MAX");
+        return NULL;
+    }
+
+    lv_profiler_builtin_ring_t * ring = &profiler_ctx->ring_arr[ring_num];
+    ring->item_arr = lv_malloc(profiler_ctx->item_num * sizeof(lv_profiler_builtin_item_t));
+    LV_ASSERT_MALLOC(ring->item_arr);
+    if(ring->item_arr == NULL) {
+        return NULL;
+    }
+
+    ring->head = 0;
+    ring->tail = 0;
+    ring->tid = tid;
+    lv_strlcpy(ring->name, "LVGL", sizeof(ring->name));
+    ring->name_pending = true;
+
+    /*Publish the ring only when it's ready*/
+    LV_PROFILER_STORE_RELEASE(&profiler_ctx->ring_num, ring_num + 1);
+    return ring;
+}
+
+static bool ring_is_full(lv_profiler_builtin_ring_t * ring)
+{
+    return ring->head - LV_PROFILER_LOAD_ACQUIRE(&ring->tail) >= profiler_ctx->item_num;
+}
+
+/**
+ * Add an item to a ring buffer which is not full. Only the owner thread of the ring can call it.
+ */
+static void ring_push(lv_profiler_builtin_ring_t * ring, const char * func, char tag, uint32_t value)
+{
+    uint32_t head = ring->head;
+    lv_profiler_builtin_item_t * item = &ring->item_arr[head % profiler_ctx->item_num];
+    item->func = func;
+    item->tag = tag;
+    item->value = value;
+    item->tick = profiler_ctx->config.tick_get_cb();
+
+#if LV_USE_OS
+    item->cpu = (uint8_t)profiler_ctx->config.cpu_get_cb();
+#endif
+
+    LV_PROFILER_STORE_RELEASE(&ring->head, head + 1);
+
+#if LV_USE_OS
+    /*Wake up the flush thread once when the ring gets half full*/
+    if(profiler_ctx->config.flush_thread &&
+       head + 1 - LV_PROFILER_LOAD_ACQUIRE(&ring->tail) == profiler_ctx->item_num / 2) {
+        lv_thread_sync_signal(&profiler_ctx->flush_sync);
+    }
+#endif
+}
+
 static void flush_no_lock(void)
 {
     if(!profiler_ctx->config.flush_cb) {
@@ -236,33 +418,140 @@ static void flush_no_lock(void)
         return;
     }
 
-    uint32_t cur = 0;
+    uint32_t ring_num = LV_PROFILER_LOAD_ACQUIRE(&profiler_ctx->ring_num);
+    uint32_t i;
+    for(i = 0; i < ring_num; i++) {
+        flush_ring_no_lock(&profiler_ctx->ring_arr[i]);
+    }
+}
+
+static void flush_ring_no_lock(lv_profiler_builtin_ring_t * ring)
+{
     char buf[LV_PROFILER_STR_MAX_LEN];
+    bool json = profiler_ctx->config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON;
     uint32_t tick_per_sec = profiler_ctx->config.tick_per_sec;
-    while(cur < profiler_ctx->cur_index) {
-        lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[cur++];
+    uint32_t head = LV_PROFILER_LOAD_ACQUIRE(&ring->head);
+    uint32_t cur = ring->tail;
+
+    if(cur == head) {
+        return;
+    }
+
+    if(json && ring->name_pending) {
+        /* name the track of the thread */
+        lv_snprintf(buf, sizeof(buf),
+                    "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}\n",
+                    profiler_ctx->flushed_num ? "," : "",
+                    ring->tid,
+                    ring->name);
+        profiler_ctx->config.flush_cb(buf);
+        profiler_ctx->flushed_num++;
+    }
+    ring->name_pending = false;
+
+    while(cur != head) {
+        lv_profiler_builtin_item_t * item = &ring->item_arr[cur % profiler_ctx->item_num];
         uint64_t sec = item->tick / tick_per_sec;
         uint64_t nsec = (item->tick % tick_per_sec) * (LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
+        cur++;
 
 #if LV_USE_OS
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-%d [%d] %" LV_PRIu64 ".%09" LV_PRIu64 ": tracing_mark_write: %c|1|%s\n",
-                    item->tid,
-                    item->cpu,
-                    sec,
-                    nsec,
-                    item->tag,
-                    item->func);
+        int cpu = item->cpu;
 #else
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-1 [0] %" LV_PRIu64 ".%09" LV_PRIu64 ": tracing_mark_write: %c|1|%s\n",
-                    sec,
-                    nsec,
-                    item->tag,
-                    item->func);
+        int cpu = 0;
 #endif
+
+        if(item->tag == 'C') {
+            if(json) {
+                lv_snprintf(buf, sizeof(buf),
+                            "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%" LV_PRIu64 ".%03d,\"pid\":1,\"tid\":%d,"
+                            "\"args\":{\"value\":%" LV_PRIu32 "}}\n",
+                            profiler_ctx->flushed_num ? "," : "",
+                            item->func,
+                            sec * 1000000 + nsec / 1000,
+                            (int)(nsec % 1000),
+                            ring->tid,
+                            item->value);
+            }
+            else {
+                lv_snprintf(buf, sizeof(buf),
+                            "   %s-%d [%d] %" LV_PRIu64 ".%09" LV_PRIu64 ": tracing_mark_write: C|1|%s|%" LV_PRIu32 "\n",
+                            ring->name,
+                            ring->tid,
+                            cpu,
+                            sec,
+                            nsec,
+                            item->func,
+                            item->value);
+            }
+        }
+        else if(json) {
+            lv_snprintf(buf, sizeof(buf),
+                        "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%" LV_PRIu64 ".%03d,\"pid\":1,\"tid\":%d}\n",
+                        profiler_ctx->flushed_num ? "," : "",
+                        item->func,
+                        item->tag,
+                        sec * 1000000 + nsec / 1000,
+                        (int)(nsec % 1000),
+                        ring->tid);
+        }
+        else {
+            lv_snprintf(buf, sizeof(buf),
+                        "   %s-%d [%d] %" LV_PRIu64 ".%09" LV_PRIu64 ": tracing_mark_write: %c|1|%s\n",
+                        ring->name,
+                        ring->tid,
+                        cpu,
+                        sec,
+                        nsec,
+                        item->tag,
+                        item->func);
+        }
         profiler_ctx->config.flush_cb(buf);
+        profiler_ctx->flushed_num++;
+    }
+
+    /*Free the flushed items for the owner thread*/
+    LV_PROFILER_STORE_RELEASE(&ring->tail, cur);
+}
+
+#if LV_USE_OS
+
+/**
+ * Find the ring buffer of a thread or add one on its first event
+ */
+static lv_profiler_builtin_ring_t * ring_get(int tid)
+{
+    uint32_t ring_num = LV_PROFILER_LOAD_ACQUIRE(&profiler_ctx->ring_num);
+    uint32_t i;
+    for(i = 0; i < ring_num; i++) {
+        if(profiler_ctx->ring_arr[i].tid == tid) {
+            return &profiler_ctx->ring_arr[i];
+        }
+    }
+
+    /*Only this thread can add a ring with its ID so no need to check the rings again*/
+    LV_PROFILER_MULTEX_LOCK;
+    lv_profiler_builtin_ring_t * ring = ring_add_no_lock(tid);
+    LV_PROFILER_MULTEX_UNLOCK;
+    return ring;
+}
+
+static void flush_thread_cb(void * user_data)
+{
+    lv_profiler_builtin_ctx_t * ctx = user_data;
+
+    while(1) {
+        lv_thread_sync_wait(&ctx->flush_sync);
+        if(ctx->flush_thread_exit) {
+            break;
+        }
+
+        lv_mutex_lock(&ctx->mutex);
+        flush_no_lock();
+        lv_mutex_unlock(&ctx->mutex);
     }
 }
 
+#endif /*LV_USE_OS*/
+
 #endif /*LV_USE_PROFILER_BUILTIN*/
@@ -28,11 +28,20 @@ extern "C" {
 #define LV_PROFILER_BUILTIN_END_TAG(tag)    lv_profiler_builtin_write((tag), 'E')
 #define LV_PROFILER_BUILTIN_BEGIN           LV_PROFILER_BUILTIN_BEGIN_TAG(__func__)
 #define LV_PROFILER_BUILTIN_END             LV_PROFILER_BUILTIN_END_TAG(__func__)
+#define LV_PROFILER_BUILTIN_COUNTER(name, value) lv_profiler_builtin_write_counter((name), (value))
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * @brief Output formats of the built-in profiler
+ */
+typedef enum {
+    LV_PROFILER_BUILTIN_FORMAT_SYSTRACE = 0,    /**< Text lines in Android systrace (ftrace) format */
+    LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON = 1, /**< Chrome trace event JSON array, one track per thread */
+} lv_profiler_builtin_format_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -65,6 +74,13 @@ void lv_profiler_builtin_set_enable(bool enable);
  */
 void lv_profiler_builtin_flush(void);
 
+/**
+ * @brief Name the track of the calling thread in the output (e.g. "LVGL" or "swdraw-0").
+ *        The thread gets its own buffer if `tid_get_cb` can tell the threads apart.
+ * @param name Name of the thread. It's copied and truncated to 15 characters.
+ */
+void lv_profiler_builtin_set_thread_name(const char * name);
+
 /**
  * @brief Write the profiling data for a function with the given tag
  * @param func Name of the function being profiled
@@ -72,6 +88,13 @@ void lv_profiler_builtin_flush(void);
  */
 void lv_profiler_builtin_write(const char * func, char tag);
 
+/**
+ * @brief Write the current value of a counter. It's shown as a graph in the trace viewers.
+ * @param name  Name of the counter. Only the pointer is stored so it must be a static string.
+ * @param value Value of the counter
+ */
+void lv_profiler_builtin_write_counter(const char * name, uint32_t value);
+
 /**********************
  *      MACROS
  **********************/
@@ -30,12 +30,15 @@ extern "C" {
  * @brief LVGL profiler built-in configuration structure
  */
 struct _lv_profiler_builtin_config_t {
-    size_t buf_size;                    /**< The size of the buffer used for profiling data */
+    size_t buf_size;                    /**< The size of the buffer used for profiling data (per thread) */
     uint32_t tick_per_sec;              /**< The number of ticks per second */
     uint64_t (*tick_get_cb)(void);      /**< Callback function to get the current tick count */
     void (*flush_cb)(const char * buf); /**< Callback function to flush the profiling data */
     int (*tid_get_cb)(void);            /**< Callback function to get the current thread ID */
     int (*cpu_get_cb)(void);            /**< Callback function to get the current CPU */
+    lv_profiler_builtin_format_t format; /**< The format of the flushed profiling data */
+    bool flush_thread;                  /**< Flush the buffers from a separate thread when one of them is
+                                         *   half full, instead of from the thread which filled it (needs `LV_USE_OS`) */
 };
 
 
@@ -16,10 +16,21 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_STYLE
+
 #define lv_style_custom_prop_flag_lookup_table_size LV_GLOBAL_DEFAULT()->style_custom_table_size
 #define lv_style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define last_custom_prop_id LV_GLOBAL_DEFAULT()->style_last_custom_prop_id
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+    /*The objects might have cached the old values of the changed style*/
+    #define invalidate_resolved_style_props() \
+        do { if(++LV_GLOBAL_DEFAULT()->style_resolved_cache_gen == 0) LV_GLOBAL_DEFAULT()->style_resolved_cache_gen = 1; } while(0)
+#else
+    #define invalidate_resolved_style_props() do {} while(0)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -198,6 +209,7 @@ void lv_style_reset(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    invalidate_resolved_style_props();
 }
 
 
@@ -315,6 +327,7 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
 
             lv_free(old_values);
+            invalidate_resolved_style_props();
             LV_PROFILER_STYLE_END;
             return true;
         }
@@ -325,6 +338,12 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 }
 
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
+{
+    lv_style_set_prop_no_invalidate(style, prop, value);
+    invalidate_resolved_style_props();
+}
+
+void lv_style_set_prop_no_invalidate(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
 {
     LV_ASSERT_STYLE(style);
 
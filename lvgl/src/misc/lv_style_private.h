@@ -28,6 +28,16 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Set the value of property in a style without marking the resolved style properties
+ * of the objects outdated. Used for the local and transition styles of an object
+ * as the object is refreshed anyway by `lv_obj_refresh_style()`.
+ * @param style     pointer to a style
+ * @param prop      the ID of a property (e.g. `LV_STYLE_BG_COLOR`)
+ * @param value     `lv_style_value_t` variable in which a field is set according to the type of `prop`
+ */
+void lv_style_set_prop_no_invalidate(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value);
+
 /**********************
  *      MACROS
  **********************/
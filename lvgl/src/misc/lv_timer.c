@@ -21,6 +21,9 @@
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
 
+/*Limit the heap keys to this far in the future to keep them comparable when the tick overflows*/
+#define DEADLINE_MAX_DIST 0x3FFFFFFF
+
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
 
@@ -34,6 +37,14 @@
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static bool collect_ready_timers(uint32_t run_id);
+static bool reserve_timer_slots(uint32_t cnt);
+static uint32_t get_deadline(const lv_timer_t * timer);
+static void update_deadline(lv_timer_t * timer);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_sift_up(uint32_t index);
+static void heap_sift_down(uint32_t index);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,43 +101,30 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
+    /*Run the ready timers in rounds. The timers are taken from a min-heap ordered by deadline
+     *so only the ready ones are visited. A timer runs at most once per call, however
+     *the timers created or made ready by the callbacks are still run in a following round.*/
+    uint32_t run_id = ++state_p->handler_run_id;
+    while(collect_ready_timers(run_id)) {
+        uint32_t i;
+        for(i = 0; i < state_p->ready_cnt; i++) {
+            lv_timer_t * timer = state_p->ready[i];
+            if(timer == NULL) continue; /*Deleted by an other timer*/
+
+            if(timer->run_id != run_id) {
+                timer->run_id = run_id;
+                lv_timer_exec(timer);
+                if(state_p->ready[i] == NULL) continue; /*Deleted by itself*/
             }
 
-            timer_active = next; /*Load the next timer*/
+            timer->in_ready = 0;
+            if(!timer->paused) heap_insert(timer);
         }
-    } while(timer_active);
+        state_p->ready_cnt = 0;
+    }
 
     uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
-
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
-    }
+    if(state_p->heap_cnt) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -166,6 +164,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Be sure there is room for every timer in the heap to not fail later*/
+    if(!reserve_timer_slots(state.timer_cnt + 1)) return NULL;
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -177,8 +178,13 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->seq = state.timer_seq++;
+    new_timer->run_id = state.handler_run_id - 1;
+    new_timer->in_heap = 0;
+    new_timer->in_ready = 0;
+    state.timer_cnt++;
 
-    state.timer_created = true;
+    heap_insert(new_timer);
 
     lv_timer_handler_resume();
 
@@ -193,8 +199,10 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    if(timer->in_heap) heap_remove(timer);
+    if(timer->in_ready) state.ready[timer->index] = NULL;
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    state.timer_cnt--;
 
     lv_free(timer);
 }
@@ -203,12 +211,14 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    if(timer->in_heap) heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    if(!timer->in_heap && !timer->in_ready) heap_insert(timer);
     lv_timer_handler_resume();
 }
 
@@ -216,18 +226,21 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    update_deadline(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    update_deadline(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+    update_deadline(timer);
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -246,6 +259,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    update_deadline(timer);
     lv_timer_handler_resume();
 }
 
@@ -260,6 +274,15 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.heap);
+    lv_free(state.ready);
+    state.heap = NULL;
+    state.ready = NULL;
+    state.heap_cnt = 0;
+    state.ready_cnt = 0;
+    state.capacity = 0;
+    state.timer_cnt = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -312,6 +335,9 @@ static bool lv_timer_exec(lv_timer_t * timer)
 {
     if(timer->paused) return false;
 
+    /*The timer is in the ready list while it runs. Its slot is cleared if it's deleted.*/
+    uint32_t ready_index = timer->index;
+
     bool exec = false;
     if(lv_timer_time_remaining(timer) == 0) {
         /* Decrement the repeat count before executing the timer_cb.
@@ -328,7 +354,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
             LV_PROFILER_TIMER_END_TAG("timer_cb");
         }
 
-        if(!state.timer_deleted) {
+        if(state.ready[ready_index]) {
             LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
         }
         else {
@@ -339,7 +365,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         exec = true;
     }
 
-    if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(state.ready[ready_index]) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             if(timer->auto_delete) {
                 LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
@@ -381,6 +407,165 @@ static void lv_timer_handler_resume(void)
     }
 }
 
+/**
+ * Move the timers which are ready to run from the heap to the ready list.
+ * The ready list is ordered like the timer list, i.e. the newer timers first.
+ * @param run_id    ID of the current `lv_timer_handler()` call
+ * @return          true: there is at least one timer which hasn't run in this call yet
+ */
+static bool collect_ready_timers(uint32_t run_id)
+{
+    bool has_new = false;
+    state.ready_cnt = 0;
+
+    while(state.heap_cnt) {
+        lv_timer_t * timer = state.heap[0];
+        if((int32_t)(lv_tick_get() - timer->deadline) < 0) break;
+
+        /*The key was limited for very long periods. Just check it again later.*/
+        uint32_t remaining = lv_timer_time_remaining(timer);
+        if(remaining && timer->repeat_count != 0) {
+            timer->deadline = lv_tick_get() + LV_MIN(remaining, DEADLINE_MAX_DIST);
+            heap_sift_down(0);
+            continue;
+        }
+
+        heap_remove(timer);
+        if(timer->run_id != run_id) has_new = true;
+
+        uint32_t i = state.ready_cnt;
+        while(i > 0 && (int32_t)(state.ready[i - 1]->seq - timer->seq) < 0) {
+            state.ready[i] = state.ready[i - 1];
+            state.ready[i]->index = i;
+            i--;
+        }
+        state.ready[i] = timer;
+        timer->index = i;
+        timer->in_ready = 1;
+        state.ready_cnt++;
+    }
+
+    /*Only timers which already ran, put them back*/
+    if(!has_new) {
+        uint32_t i;
+        for(i = 0; i < state.ready_cnt; i++) {
+            state.ready[i]->in_ready = 0;
+            heap_insert(state.ready[i]);
+        }
+        state.ready_cnt = 0;
+    }
+
+    return has_new;
+}
+
+/**
+ * Make sure `heap` and `ready` can store the given number of timers
+ * @param cnt       number of timers to store
+ * @return          true: success; false: out of memory
+ */
+static bool reserve_timer_slots(uint32_t cnt)
+{
+    if(cnt <= state.capacity) return true;
+
+    uint32_t new_capacity = state.capacity ? state.capacity * 2 : 16;
+    lv_timer_t ** new_heap = lv_realloc(state.heap, new_capacity * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+    state.heap = new_heap;
+
+    lv_timer_t ** new_ready = lv_realloc(state.ready, new_capacity * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_ready);
+    if(new_ready == NULL) return false;
+    state.ready = new_ready;
+
+    state.capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Get the heap key of a timer
+ * @param timer     pointer to a timer
+ * @return          the tick when the timer needs to be checked
+ */
+static uint32_t get_deadline(const lv_timer_t * timer)
+{
+    /*The timers without remaining repeats are deleted or paused as soon as possible*/
+    if(timer->repeat_count == 0) return timer->last_run;
+
+    return timer->last_run + LV_MIN(timer->period, DEADLINE_MAX_DIST);
+}
+
+/**
+ * Recalculate the heap key of a timer after its period or last run has changed
+ * @param timer     pointer to a timer
+ */
+static void update_deadline(lv_timer_t * timer)
+{
+    timer->deadline = get_deadline(timer);
+    if(!timer->in_heap) return;
+
+    heap_sift_up(timer->index);
+    heap_sift_down(timer->index);
+}
+
+static inline bool heap_less(const lv_timer_t * a, const lv_timer_t * b)
+{
+    return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+static inline void heap_set(uint32_t index, lv_timer_t * timer)
+{
+    state.heap[index] = timer;
+    timer->index = index;
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    timer->deadline = get_deadline(timer);
+    timer->in_heap = 1;
+    heap_set(state.heap_cnt, timer);
+    state.heap_cnt++;
+    heap_sift_up(timer->index);
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t index = timer->index;
+    timer->in_heap = 0;
+    state.heap_cnt--;
+    if(index == state.heap_cnt) return;
+
+    heap_set(index, state.heap[state.heap_cnt]);
+    heap_sift_up(index);
+    heap_sift_down(index);
+}
+
+static void heap_sift_up(uint32_t index)
+{
+    lv_timer_t * timer = state.heap[index];
+    while(index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if(!heap_less(timer, state.heap[parent])) break;
+        heap_set(index, state.heap[parent]);
+        index = parent;
+    }
+    heap_set(index, timer);
+}
+
+static void heap_sift_down(uint32_t index)
+{
+    lv_timer_t * timer = state.heap[index];
+    while(true) {
+        uint32_t child = index * 2 + 1;
+        if(child >= state.heap_cnt) break;
+        if(child + 1 < state.heap_cnt && heap_less(state.heap[child + 1], state.heap[child])) child++;
+        if(!heap_less(state.heap[child], timer)) break;
+        heap_set(index, state.heap[child]);
+        index = child;
+    }
+    heap_set(index, timer);
+}
+
 void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data)
 {
     state.resume_cb = cb;
@@ -33,17 +33,29 @@ struct _lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    uint32_t deadline;         /**< Key in the heap: tick when the timer needs to be checked again */
+    uint32_t seq;              /**< Creation order, among the ready timers the newer ones run first */
+    uint32_t run_id;           /**< ID of the last `lv_timer_handler()` call which has run the timer */
+    uint32_t index;            /**< Index in `heap` or `ready` of `lv_timer_state_t` */
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+    uint32_t in_heap : 1;      /**< Waiting in the deadline heap*/
+    uint32_t in_ready : 1;     /**< Collected to run in the current round of `lv_timer_handler()`*/
 };
 
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
+    lv_timer_t ** heap;        /**< Min-heap of the not paused timers ordered by their deadline */
+    lv_timer_t ** ready;       /**< The timers to run in the current round of `lv_timer_handler()` */
+    uint32_t heap_cnt;
+    uint32_t ready_cnt;
+    uint32_t capacity;         /**< Size of `heap` and `ready` in timers, at least the number of timers */
+    uint32_t timer_cnt;
+    uint32_t timer_seq;
+    uint32_t handler_run_id;
 
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
     uint32_t timer_time_until_next;
 
     bool already_running;
@@ -18,6 +18,8 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_FONT
 
 #define IS_FONT_FAMILY_NAME(name) (lv_strchr((name), ',') != NULL)
 #define IS_FONT_HAS_FALLBACK(font) ((font)->fallback != NULL)
@@ -17,6 +17,8 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_FONT
 
 /**********************
  *      TYPEDEFS
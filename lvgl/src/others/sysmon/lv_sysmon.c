@@ -41,6 +41,9 @@
     static void perf_update_timer_cb(lv_timer_t * t);
     static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
     static void perf_monitor_disp_event_cb(lv_event_t * e);
+    static void input_latency_calc(const lv_sysmon_input_latency_data_t * data, lv_sysmon_input_latency_t * latency);
+    static uint32_t input_latency_to_bucket(uint32_t latency);
+    static uint32_t input_latency_from_bucket(uint32_t bucket);
 #endif
 
 #if LV_USE_MEM_MONITOR
@@ -137,6 +140,80 @@ void lv_sysmon_hide_performance(lv_display_t * disp)
     lv_obj_add_flag(disp->perf_label, LV_OBJ_FLAG_HIDDEN);
 }
 
+void lv_sysmon_report_input(lv_display_t * disp, uint32_t timestamp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_sysmon_input_latency_data_t * data = &disp->perf_sysmon_info.input_latency;
+
+    /*A timestamp in the future is probably from a clock which is not in sync with the tick*/
+    if(lv_tick_elaps(timestamp) > UINT32_MAX / 2) timestamp = lv_tick_get();
+
+    /*Measure from the first input to show the worst case*/
+    if(data->pending == 0 || lv_tick_elaps(timestamp) > lv_tick_elaps(data->pending_timestamp)) {
+        data->pending_timestamp = timestamp;
+        data->pending = 1;
+    }
+}
+
+void lv_sysmon_get_input_latency(lv_display_t * disp, lv_sysmon_input_latency_t * latency)
+{
+    lv_memzero(latency, sizeof(lv_sysmon_input_latency_t));
+
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    input_latency_calc(&disp->perf_sysmon_info.input_latency, latency);
+}
+
+void lv_sysmon_reset_input_latency(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_memzero(&disp->perf_sysmon_info.input_latency, sizeof(lv_sysmon_input_latency_data_t));
+}
+
+void lv_sysmon_input_latency_frame_start(lv_display_t * disp, bool redraw)
+{
+    lv_sysmon_input_latency_data_t * data = &disp->perf_sysmon_info.input_latency;
+    if(data->pending == 0) return;
+
+    /*If nothing is redrawn the input had no visible effect so there is nothing to measure*/
+    if(redraw && data->rendering == 0) {
+        data->rendering_timestamp = data->pending_timestamp;
+        data->rendering = 1;
+    }
+    data->pending = 0;
+}
+
+void lv_sysmon_input_latency_flush_start(lv_display_t * disp)
+{
+    lv_sysmon_input_latency_data_t * data = &disp->perf_sysmon_info.input_latency;
+    if(data->rendering == 0) return;
+
+    if(data->flushing == 0) {
+        data->flushing_timestamp = data->rendering_timestamp;
+        data->flushing = 1;
+    }
+    data->rendering = 0;
+}
+
+void lv_sysmon_input_latency_flush_ready(lv_display_t * disp)
+{
+    lv_sysmon_input_latency_data_t * data = &disp->perf_sysmon_info.input_latency;
+    if(data->flushing == 0) return;
+
+    uint32_t latency = lv_tick_elaps(data->flushing_timestamp);
+    data->flushing = 0;
+
+    if(data->cnt == 0 || latency < data->min) data->min = latency;
+    if(data->cnt == 0 || latency > data->max) data->max = latency;
+    data->cnt++;
+    data->buckets[input_latency_to_bucket(latency)]++;
+}
+
 #endif
 
 #if LV_USE_MEM_MONITOR
@@ -267,6 +344,8 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.fps_avg_total = ((info->calculated.fps_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.fps) / info->calculated.run_cnt;
 
+    input_latency_calc(&info->input_latency, &info->calculated.input_latency);
+
     lv_subject_set_pointer(&disp->perf_sysmon_backend.subject, info);
 
     lv_sysmon_perf_info_t prev_info = *info;
@@ -275,6 +354,7 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.cpu_avg_total = prev_info.calculated.cpu_avg_total;
     info->calculated.fps_avg_total = prev_info.calculated.fps_avg_total;
     info->calculated.run_cnt = prev_info.calculated.run_cnt;
+    info->input_latency = prev_info.input_latency;
 
     info->measured.last_report_timestamp = lv_tick_get();
 }
@@ -288,23 +368,85 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32"), "
            "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
-           "CPU %" LV_PRIu32 "%%\n",
+           "CPU %" LV_PRIu32 "%%, "
+           "input latency %" LV_PRIu32 "ms (p95 %" LV_PRIu32 "ms | p99 %" LV_PRIu32 "ms | cnt: %" LV_PRIu32 ")\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
-           perf->calculated.cpu);
+           perf->calculated.cpu,
+           perf->calculated.input_latency.p50, perf->calculated.input_latency.p95, perf->calculated.input_latency.p99,
+           perf->calculated.input_latency.cnt);
 #else
     lv_obj_t * label = lv_observer_get_target(observer);
-    lv_label_set_text_fmt(
-        label,
-        "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
-        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
-        perf->calculated.fps, perf->calculated.cpu,
-        perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
-        perf->calculated.render_avg_time, perf->calculated.flush_avg_time
-    );
+    if(perf->calculated.input_latency.cnt == 0) {
+        lv_label_set_text_fmt(
+            label,
+            "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
+            "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
+            perf->calculated.fps, perf->calculated.cpu,
+            perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
+            perf->calculated.render_avg_time, perf->calculated.flush_avg_time
+        );
+    }
+    else {
+        lv_label_set_text_fmt(
+            label,
+            "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
+            "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")\n"
+            "%" LV_PRIu32" ms input (p99 %" LV_PRIu32")",
+            perf->calculated.fps, perf->calculated.cpu,
+            perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
+            perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
+            perf->calculated.input_latency.p50, perf->calculated.input_latency.p99
+        );
+    }
 #endif /*LV_USE_PERF_MONITOR_LOG_MODE*/
 }
 
+static void input_latency_calc(const lv_sysmon_input_latency_data_t * data, lv_sysmon_input_latency_t * latency)
+{
+    latency->cnt = data->cnt;
+    latency->min = data->min;
+    latency->max = data->max;
+    latency->p50 = 0;
+    latency->p95 = 0;
+    latency->p99 = 0;
+    if(data->cnt == 0) return;
+
+    static const uint32_t pcts[3] = {50, 95, 99};
+    uint32_t * res[3] = {&latency->p50, &latency->p95, &latency->p99};
+    uint32_t p = 0;
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < LV_SYSMON_LATENCY_BUCKET_CNT && p < 3; i++) {
+        sum += data->buckets[i];
+        /*The lower bound of the first bucket where at least p% of the samples are*/
+        while(p < 3 && (uint64_t)sum * 100 >= (uint64_t)data->cnt * pcts[p]) {
+            *res[p] = LV_CLAMP(data->min, input_latency_from_bucket(i), data->max);
+            p++;
+        }
+    }
+}
+
+static uint32_t input_latency_to_bucket(uint32_t latency)
+{
+    if(latency < 16) return latency;
+
+    /*8 buckets between each power of 2*/
+    uint32_t e = 4;
+    while((latency >> (e + 1)) != 0) e++;
+
+    uint32_t bucket = 16 + (e - 4) * 8 + ((latency >> (e - 3)) & 0x7);
+    return LV_MIN(bucket, LV_SYSMON_LATENCY_BUCKET_CNT - 1);
+}
+
+static uint32_t input_latency_from_bucket(uint32_t bucket)
+{
+    if(bucket < 16) return bucket;
+
+    uint32_t e = 4 + (bucket - 16) / 8;
+    return (8 + (bucket - 16) % 8) << (e - 3);
+}
+
 #endif
 
 #if LV_USE_MEM_MONITOR
@@ -322,16 +464,57 @@ static void mem_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     const lv_mem_monitor_t * mon = lv_subject_get_pointer(subject);
 
     size_t used_size = mon->total_size - mon->free_size;;
+
+#if LV_USE_MEM_TAGS
+    lv_mem_tag_snapshot_t snapshot;
+    lv_mem_tag_take_snapshot(&snapshot);
+    /*The allocator can't tell its state (e.g. LV_STDLIB_CLIB) but the tags know what LVGL allocated*/
+    if(mon->total_size == 0) used_size = snapshot.total.size;
+#endif
+
     size_t used_kb = used_size / 1024;
     size_t used_kb_tenth = (used_size - (used_kb * 1024)) / 102;
     size_t max_used_kb = mon->max_used / 1024;
     size_t max_used_kb_tenth = (mon->max_used - (max_used_kb * 1024)) / 102;
+
+#if LV_USE_MEM_TAGS
+    /*Add the 3 biggest tags*/
+    char tags_txt[64];
+    uint32_t tags_len = 0;
+    uint32_t shown = 0;
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        uint32_t max_i = LV_MEM_TAG_CNT;
+        uint32_t t;
+        for(t = 0; t < LV_MEM_TAG_CNT; t++) {
+            if(shown & (1 << t) || snapshot.tags[t].size == 0) continue;
+            if(max_i == LV_MEM_TAG_CNT || snapshot.tags[t].size > snapshot.tags[max_i].size) max_i = t;
+        }
+        if(max_i == LV_MEM_TAG_CNT) break;
+
+        shown |= 1 << max_i;
+        tags_len += lv_snprintf(tags_txt + tags_len, sizeof(tags_txt) - tags_len, "%s%s %zu kB",
+                                i ? ", " : "", lv_mem_tag_get_name(max_i), snapshot.tags[max_i].size / 1024);
+        if(tags_len >= sizeof(tags_txt)) break;
+    }
+    if(tags_len == 0) tags_txt[0] = '\0';
+
+    lv_label_set_text_fmt(label,
+                          "%zu.%zu kB (%d%%)\n"
+                          "%zu.%zu kB max, %d%% frag.\n"
+                          "%s",
+                          used_kb, used_kb_tenth, mon->used_pct,
+                          max_used_kb, max_used_kb_tenth,
+                          mon->frag_pct,
+                          tags_txt);
+#else
     lv_label_set_text_fmt(label,
                           "%zu.%zu kB (%d%%)\n"
                           "%zu.%zu kB max, %d%% frag.",
                           used_kb, used_kb_tenth, mon->used_pct,
                           max_used_kb, max_used_kb_tenth,
                           mon->frag_pct);
+#endif
 }
 
 #endif
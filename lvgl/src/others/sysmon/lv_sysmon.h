@@ -35,6 +35,18 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Input-to-photon latency: time from an input event until the first frame showing its effect is flushed [ms]
+ */
+typedef struct {
+    uint32_t cnt;   /**< Number of measured inputs */
+    uint32_t min;
+    uint32_t max;
+    uint32_t p50;   /**< Median */
+    uint32_t p95;
+    uint32_t p99;
+} lv_sysmon_input_latency_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -60,6 +72,29 @@ void lv_sysmon_show_performance(lv_display_t * disp);
  */
 void lv_sysmon_hide_performance(lv_display_t * disp);
 
+/**
+ * Report an input event which can change the display (e.g. a button press) to measure its latency.
+ * The latency lasts until the next frame redrawing anything is completely flushed.
+ * Inputs read by `lv_indev`s are reported automatically.
+ * @param disp      the display showing the effect of the input, NULL: use the default
+ * @param timestamp when the input happened in `lv_tick_get()` time, e.g. `lv_tick_get() - age_of_the_event`
+ */
+void lv_sysmon_report_input(lv_display_t * disp, uint32_t timestamp);
+
+/**
+ * Get the input-to-photon latency statistics of a display since the last reset.
+ * The percentiles are accurate to 1 ms below 16 ms and to 12.5% above it.
+ * @param disp      target display, NULL: use the default
+ * @param latency   store the statistics here
+ */
+void lv_sysmon_get_input_latency(lv_display_t * disp, lv_sysmon_input_latency_t * latency);
+
+/**
+ * Clear the input-to-photon latency statistics of a display
+ * @param disp      target display, NULL: use the default
+ */
+void lv_sysmon_reset_input_latency(lv_display_t * disp);
+
 #endif /*LV_USE_PERF_MONITOR*/
 
 #if LV_USE_MEM_MONITOR
@@ -22,6 +22,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Latencies below 16 ms have their own bucket, above it 8 buckets per doubling up to 8 s */
+#define LV_SYSMON_LATENCY_BUCKET_CNT    88
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -32,6 +35,19 @@ struct _lv_sysmon_backend_data_t {
 };
 
 #if LV_USE_PERF_MONITOR
+typedef struct {
+    uint32_t pending_timestamp;     /**< Time of the first input which is not rendered yet */
+    uint32_t rendering_timestamp;   /**< Time of the first input shown by the frame being rendered */
+    uint32_t flushing_timestamp;    /**< Time of the first input shown by the frame being flushed */
+    uint32_t pending : 1;
+    uint32_t rendering : 1;
+    uint32_t flushing : 1;
+    uint32_t cnt;
+    uint32_t min;
+    uint32_t max;
+    uint32_t buckets[LV_SYSMON_LATENCY_BUCKET_CNT];
+} lv_sysmon_input_latency_data_t;
+
 struct _lv_sysmon_perf_info_t {
     struct {
         bool inited;
@@ -59,8 +75,10 @@ struct _lv_sysmon_perf_info_t {
         uint32_t cpu_avg_total;
         uint32_t fps_avg_total;
         uint32_t run_cnt;
+        lv_sysmon_input_latency_t input_latency;
     } calculated;
 
+    lv_sysmon_input_latency_data_t input_latency;   /**< Kept until `lv_sysmon_reset_input_latency()` */
 };
 #endif
 
@@ -78,6 +96,30 @@ void lv_sysmon_builtin_init(void);
  */
 void lv_sysmon_builtin_deinit(void);
 
+#if LV_USE_PERF_MONITOR
+
+/**
+ * Called by the refresh before rendering a frame. The pending input is shown by this frame
+ * if it redraws anything, else the input had no visible effect and it's dropped.
+ * @param disp      pointer to a display
+ * @param redraw    true: there are invalid areas to redraw
+ */
+void lv_sysmon_input_latency_frame_start(lv_display_t * disp, bool redraw);
+
+/**
+ * Called when the last area of a frame is passed to `flush_cb`
+ * @param disp      pointer to a display
+ */
+void lv_sysmon_input_latency_flush_start(lv_display_t * disp);
+
+/**
+ * Called when the last area of a frame is flushed. Adds the latency of the input shown by the frame.
+ * @param disp      pointer to a display
+ */
+void lv_sysmon_input_latency_flush_ready(lv_display_t * disp);
+
+#endif /*LV_USE_PERF_MONITOR*/
+
 /**********************
  *      MACROS
  **********************/
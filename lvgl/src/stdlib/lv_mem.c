@@ -6,10 +6,12 @@
  *      INCLUDES
  *********************/
 #include "lv_mem_private.h"
+#include "lv_mem_slab_private.h"
 #include "lv_string.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_log.h"
 #include "../core/lv_global.h"
+#include "../misc/lv_profiler.h"
 
 #if LV_USE_OS == LV_OS_PTHREAD
     #include <pthread.h>
@@ -25,6 +27,24 @@
 
 #define zero_mem LV_GLOBAL_DEFAULT()->memory_zero
 
+#if LV_USE_MEM_TAGS
+    /*The functions are defined here, don't replace them with the tagged versions*/
+    #undef lv_malloc
+    #undef lv_malloc_zeroed
+    #undef lv_zalloc
+    #undef lv_calloc
+    #undef lv_realloc
+
+    #define tag_state LV_GLOBAL_DEFAULT()->mem_tag_state
+
+    /*The allocations can come from the draw threads too*/
+    #if LV_USE_OS && (defined(__GNUC__) || defined(__clang__))
+        #define TAG_ATOMIC 1
+    #else
+        #define TAG_ATOMIC 0
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -32,6 +52,14 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * malloc_tagged(size_t size, uint32_t tag);
+static void * malloc_zeroed_tagged(size_t size, uint32_t tag);
+static void * realloc_tagged(void * data_p, size_t new_size, uint32_t tag);
+static inline void * alloc_core(size_t size, uint32_t tag);
+#if LV_USE_MEM_TAGS
+    static void tag_add(uint32_t tag, size_t size);
+    static void tag_sub(uint32_t tag, size_t size);
+#endif
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -45,6 +73,17 @@ lv_result_t lv_mem_test_core(void);
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_MEM_TAGS
+static const char * const tag_names[LV_MEM_TAG_CNT] = {
+    "other", "obj", "style", "draw", "layer", "image", "font", "lottie", "thorvg", "user"
+};
+
+/*Separate strings as the profiler stores only the pointers*/
+static const char * const tag_counter_names[LV_MEM_TAG_CNT] = {
+    "mem:other", "mem:obj", "mem:style", "mem:draw", "mem:layer", "mem:image", "mem:font", "mem:lottie",
+    "mem:thorvg", "mem:user"
+};
+#endif
 
 /**********************
  *      MACROS
@@ -60,6 +99,210 @@ lv_result_t lv_mem_test_core(void);
  **********************/
 
 void * lv_malloc(size_t size)
+{
+    return malloc_tagged(size, 0);
+}
+
+void * lv_malloc_zeroed(size_t size)
+{
+    return malloc_zeroed_tagged(size, 0);
+}
+
+void * lv_calloc(size_t num, size_t size)
+{
+    LV_TRACE_MEM("allocating number of %zu each %zu bytes", num, size);
+    return malloc_zeroed_tagged(num * size, 0);
+}
+
+void * lv_zalloc(size_t size)
+{
+    return malloc_zeroed_tagged(size, 0);
+}
+
+void lv_free(void * data)
+{
+    LV_TRACE_MEM("freeing %p", data);
+    if(data == &zero_mem) return;
+    if(data == NULL) return;
+
+#if LV_USE_MEM_TAGS
+    lv_mem_tag_header_t * header = (lv_mem_tag_header_t *)data - 1;
+    tag_sub((uint32_t)header->tag, header->size);
+    data = header;
+#endif
+
+#if LV_USE_MEM_SLAB
+    if(lv_mem_slab_free(data)) return;
+#endif
+
+    lv_free_core(data);
+}
+
+void * lv_reallocf(void * data_p, size_t new_size)
+{
+    void * new = lv_realloc(data_p, new_size);
+    if(!new) {
+        lv_free(data_p);
+    }
+    return new;
+}
+
+void * lv_realloc(void * data_p, size_t new_size)
+{
+    return realloc_tagged(data_p, new_size, 0);
+}
+
+lv_result_t lv_mem_test(void)
+{
+    if(zero_mem != ZERO_MEM_SENTINEL) {
+        LV_LOG_WARN("zero_mem is written");
+        return LV_RESULT_INVALID;
+    }
+
+    return lv_mem_test_core();
+}
+
+void lv_mem_monitor(lv_mem_monitor_t * mon_p)
+{
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    lv_mem_monitor_core(mon_p);
+#if LV_USE_MEM_SLAB
+    lv_mem_slab_monitor(mon_p);
+#endif
+
+#if LV_USE_MEM_TAGS
+    /*The allocator can't tell its state (e.g. LV_STDLIB_CLIB) but the tags know what LVGL allocated*/
+    if(mon_p->total_size == 0) {
+        mon_p->used_cnt = tag_state.total.cnt;
+        mon_p->max_used = tag_state.total.peak_size;
+    }
+#endif
+}
+
+#if LV_USE_MEM_TAGS
+
+void * lv_malloc_tagged(size_t size, lv_mem_tag_t tag)
+{
+    LV_ASSERT(tag < LV_MEM_TAG_CNT);
+    return malloc_tagged(size, tag);
+}
+
+void * lv_malloc_zeroed_tagged(size_t size, lv_mem_tag_t tag)
+{
+    LV_ASSERT(tag < LV_MEM_TAG_CNT);
+    return malloc_zeroed_tagged(size, tag);
+}
+
+void * lv_realloc_tagged(void * data_p, size_t new_size, lv_mem_tag_t tag)
+{
+    LV_ASSERT(tag < LV_MEM_TAG_CNT);
+    return realloc_tagged(data_p, new_size, tag);
+}
+
+void lv_mem_tag_set(void * data, lv_mem_tag_t tag)
+{
+    LV_ASSERT(tag < LV_MEM_TAG_CNT);
+    if(data == NULL || data == &zero_mem) return;
+
+    lv_mem_tag_header_t * header = (lv_mem_tag_header_t *)data - 1;
+    if(header->tag == (size_t)tag) return;
+
+    tag_sub((uint32_t)header->tag, header->size);
+    header->tag = tag;
+    tag_add(tag, header->size);
+}
+
+lv_mem_tag_t lv_mem_tag_get(const void * data)
+{
+    if(data == NULL || data == &zero_mem) return LV_MEM_TAG_OTHER;
+
+    const lv_mem_tag_header_t * header = (const lv_mem_tag_header_t *)data - 1;
+    return (lv_mem_tag_t)header->tag;
+}
+
+const char * lv_mem_tag_get_name(lv_mem_tag_t tag)
+{
+    if(tag >= LV_MEM_TAG_CNT) return "invalid";
+    return tag_names[tag];
+}
+
+void lv_mem_tag_get_info(lv_mem_tag_t tag, lv_mem_tag_info_t * info)
+{
+    LV_ASSERT_NULL(info);
+    LV_ASSERT(tag < LV_MEM_TAG_CNT);
+    *info = tag_state.tags[tag];
+}
+
+void lv_mem_tag_take_snapshot(lv_mem_tag_snapshot_t * snapshot)
+{
+    LV_ASSERT_NULL(snapshot);
+    lv_memcpy(snapshot->tags, tag_state.tags, sizeof(snapshot->tags));
+    snapshot->total = tag_state.total;
+}
+
+void lv_mem_tag_snapshot_diff(const lv_mem_tag_snapshot_t * before, const lv_mem_tag_snapshot_t * after,
+                              lv_mem_tag_diff_t * diff)
+{
+    LV_ASSERT_NULL(before);
+    LV_ASSERT_NULL(after);
+    LV_ASSERT_NULL(diff);
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_CNT; i++) {
+        diff->size[i] = (intptr_t)(after->tags[i].size - before->tags[i].size);
+        diff->cnt[i] = (int32_t)(after->tags[i].cnt - before->tags[i].cnt);
+    }
+    diff->total_size = (intptr_t)(after->total.size - before->total.size);
+    diff->total_cnt = (int32_t)(after->total.cnt - before->total.cnt);
+}
+
+void lv_mem_tag_log_diff(const lv_mem_tag_snapshot_t * before, const lv_mem_tag_snapshot_t * after)
+{
+#if LV_USE_LOG
+    lv_mem_tag_diff_t diff;
+    lv_mem_tag_snapshot_diff(before, after, &diff);
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_CNT; i++) {
+        if(diff.size[i] == 0 && diff.cnt[i] == 0) continue;
+        LV_LOG_USER("%s: %+ld bytes, %+" LV_PRId32 " allocations (now %zu bytes, peak %zu bytes)",
+                    tag_names[i], (long)diff.size[i], diff.cnt[i], after->tags[i].size, after->tags[i].peak_size);
+    }
+    LV_LOG_USER("total: %+ld bytes, %+" LV_PRId32 " allocations", (long)diff.total_size, diff.total_cnt);
+#else
+    LV_UNUSED(before);
+    LV_UNUSED(after);
+#endif
+}
+
+void lv_mem_tag_reset_peak(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_CNT; i++) {
+        tag_state.tags[i].peak_size = tag_state.tags[i].size;
+    }
+    tag_state.total.peak_size = tag_state.total.size;
+}
+
+void lv_mem_tag_trace(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_CNT; i++) {
+        size_t size = tag_state.tags[i].size;
+        if(size == tag_state.traced_size[i]) continue;
+
+        tag_state.traced_size[i] = size;
+        LV_PROFILER_COUNTER(tag_counter_names[i], (uint32_t)size);
+    }
+}
+
+#endif /*LV_USE_MEM_TAGS*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * malloc_tagged(size_t size, uint32_t tag)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
     if(size == 0) {
@@ -67,7 +310,7 @@ void * lv_malloc(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = alloc_core(size, tag);
 
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
@@ -89,7 +332,7 @@ void * lv_malloc(size_t size)
     return alloc;
 }
 
-void * lv_malloc_zeroed(size_t size)
+static void * malloc_zeroed_tagged(size_t size, uint32_t tag)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
     if(size == 0) {
@@ -97,7 +340,7 @@ void * lv_malloc_zeroed(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = alloc_core(size, tag);
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
@@ -116,36 +359,7 @@ void * lv_malloc_zeroed(size_t size)
     return alloc;
 }
 
-void * lv_calloc(size_t num, size_t size)
-{
-    LV_TRACE_MEM("allocating number of %zu each %zu bytes", num, size);
-    return lv_malloc_zeroed(num * size);
-}
-
-void * lv_zalloc(size_t size)
-{
-    return lv_malloc_zeroed(size);
-}
-
-void lv_free(void * data)
-{
-    LV_TRACE_MEM("freeing %p", data);
-    if(data == &zero_mem) return;
-    if(data == NULL) return;
-
-    lv_free_core(data);
-}
-
-void * lv_reallocf(void * data_p, size_t new_size)
-{
-    void * new = lv_realloc(data_p, new_size);
-    if(!new) {
-        lv_free(data_p);
-    }
-    return new;
-}
-
-void * lv_realloc(void * data_p, size_t new_size)
+static void * realloc_tagged(void * data_p, size_t new_size, uint32_t tag)
 {
     LV_TRACE_MEM("reallocating %p with %lu size", data_p, (unsigned long)new_size);
     if(new_size == 0) {
@@ -154,35 +368,110 @@ void * lv_realloc(void * data_p, size_t new_size)
         return &zero_mem;
     }
 
-    if(data_p == &zero_mem) return lv_malloc(new_size);
+    if(data_p == &zero_mem || data_p == NULL) return malloc_tagged(new_size, tag);
 
+#if LV_USE_MEM_TAGS
+    /*Reallocate with the header and keep the original tag*/
+    lv_mem_tag_header_t * header = (lv_mem_tag_header_t *)data_p - 1;
+    size_t old_size = header->size;
+    tag = (uint32_t)header->tag;
+    data_p = header;
+    new_size += sizeof(lv_mem_tag_header_t);
+#endif
+
+#if LV_USE_MEM_SLAB
+    void * new_p = lv_mem_slab_is_owned(data_p) ? lv_mem_slab_realloc(data_p, new_size) :
+                   lv_realloc_core(data_p, new_size);
+#else
     void * new_p = lv_realloc_core(data_p, new_size);
+#endif
 
     if(new_p == NULL) {
         LV_LOG_ERROR("couldn't reallocate memory");
         return NULL;
     }
 
+#if LV_USE_MEM_TAGS
+    header = new_p;
+    tag_sub(tag, old_size);
+    header->size = new_size - sizeof(lv_mem_tag_header_t);
+    tag_add(tag, header->size);
+    new_p = header + 1;
+#else
+    LV_UNUSED(tag);
+#endif
+
     LV_TRACE_MEM("reallocated at %p", new_p);
     return new_p;
 }
 
-lv_result_t lv_mem_test(void)
+static inline void * alloc_core(size_t size, uint32_t tag)
 {
-    if(zero_mem != ZERO_MEM_SENTINEL) {
-        LV_LOG_WARN("zero_mem is written");
-        return LV_RESULT_INVALID;
+#if LV_USE_MEM_TAGS
+    size_t raw_size = size + sizeof(lv_mem_tag_header_t);
+#else
+    size_t raw_size = size;
+    LV_UNUSED(tag);
+#endif
+
+    void * alloc = NULL;
+#if LV_USE_MEM_SLAB
+    alloc = lv_mem_slab_alloc(raw_size);
+#endif
+    if(alloc == NULL) alloc = lv_malloc_core(raw_size);
+
+#if LV_USE_MEM_TAGS
+    if(alloc == NULL) return NULL;
+
+    lv_mem_tag_header_t * header = alloc;
+    header->size = size;
+    header->tag = tag;
+    tag_add(tag, size);
+    alloc = header + 1;
+#endif
+
+    return alloc;
+}
+
+#if LV_USE_MEM_TAGS
+
+static void info_add(lv_mem_tag_info_t * info, size_t size)
+{
+#if TAG_ATOMIC
+    size_t cur = __atomic_add_fetch(&info->size, size, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&info->cnt, 1, __ATOMIC_RELAXED);
+    size_t peak = __atomic_load_n(&info->peak_size, __ATOMIC_RELAXED);
+    while(cur > peak &&
+          !__atomic_compare_exchange_n(&info->peak_size, &peak, cur, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
     }
+#else
+    info->size += size;
+    info->cnt++;
+    if(info->size > info->peak_size) info->peak_size = info->size;
+#endif
+}
 
-    return lv_mem_test_core();
+static void info_sub(lv_mem_tag_info_t * info, size_t size)
+{
+#if TAG_ATOMIC
+    __atomic_sub_fetch(&info->size, size, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&info->cnt, 1, __ATOMIC_RELAXED);
+#else
+    info->size -= size;
+    info->cnt--;
+#endif
 }
 
-void lv_mem_monitor(lv_mem_monitor_t * mon_p)
+static void tag_add(uint32_t tag, size_t size)
 {
-    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
-    lv_mem_monitor_core(mon_p);
+    info_add(&tag_state.tags[tag], size);
+    info_add(&tag_state.total, size);
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+static void tag_sub(uint32_t tag, size_t size)
+{
+    info_sub(&tag_state.tags[tag], size);
+    info_sub(&tag_state.total, size);
+}
+
+#endif /*LV_USE_MEM_TAGS*/
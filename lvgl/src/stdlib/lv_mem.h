@@ -41,8 +41,75 @@ typedef struct {
     size_t max_used;    /**< Max size of Heap memory used */
     uint8_t used_pct;   /**< Percentage used */
     uint8_t frag_pct;   /**< Amount of fragmentation */
+#if LV_USE_MEM_SLAB
+    size_t slab_total_size;     /**< Size of the slab arena */
+    size_t slab_assigned_size;  /**< Size of the slabs assigned to a size class */
+    size_t slab_used_size;      /**< Size of the blocks handed out from the slabs (thread caches included) */
+    size_t slab_fallback_cnt;   /**< Small requests served by the allocator as the slabs were full */
+    uint8_t slab_frag_pct;      /**< Unused part of the assigned slabs */
+#endif
 } lv_mem_monitor_t;
 
+#if LV_USE_MEM_SLAB
+/**
+ * State of one slab size class
+ */
+typedef struct {
+    uint32_t block_size;    /**< Size of the blocks of this class */
+    uint32_t chunk_cnt;     /**< Number of slabs assigned to this class */
+    uint32_t used_cnt;      /**< Blocks handed out, including the ones kept by the thread caches */
+    uint32_t max_used_cnt;  /**< Max number of blocks handed out at once */
+    uint32_t free_cnt;      /**< Blocks available in the assigned slabs */
+} lv_mem_slab_class_info_t;
+#endif
+
+#if LV_USE_MEM_TAGS
+/**
+ * Subsystems the allocations are attributed to.
+ * A file selects the tag of its `lv_malloc()` calls by redefining `LV_MEM_TAG` after its includes.
+ */
+typedef enum {
+    LV_MEM_TAG_OTHER,   /**< Not attributed to any of the below */
+    LV_MEM_TAG_OBJ,     /**< Widgets and their data */
+    LV_MEM_TAG_STYLE,   /**< Styles, local styles and themes */
+    LV_MEM_TAG_DRAW,    /**< Draw tasks, draw buffers, masks and other rendering data */
+    LV_MEM_TAG_LAYER,   /**< Buffers of the layers (limited by `LV_DRAW_LAYER_MAX_MEMORY`) */
+    LV_MEM_TAG_IMAGE,   /**< Image decoders and the decoded images in the image cache */
+    LV_MEM_TAG_FONT,    /**< Fonts and glyph caches */
+    LV_MEM_TAG_LOTTIE,  /**< Lottie animations */
+    LV_MEM_TAG_THORVG,  /**< ThorVG's vector rendering */
+    LV_MEM_TAG_USER,    /**< Free to use by the application */
+    LV_MEM_TAG_CNT,
+} lv_mem_tag_t;
+
+/**
+ * Memory usage of a tag
+ */
+typedef struct {
+    size_t size;        /**< Bytes allocated now */
+    size_t peak_size;   /**< Most bytes allocated at once since `lv_init()` or `lv_mem_tag_reset_peak()` */
+    uint32_t cnt;       /**< Number of allocations now */
+} lv_mem_tag_info_t;
+
+/**
+ * Memory usage of all tags at a point in time
+ */
+typedef struct {
+    lv_mem_tag_info_t tags[LV_MEM_TAG_CNT];
+    lv_mem_tag_info_t total;    /**< Sum of all tags. `peak_size` is the peak of the sum. */
+} lv_mem_tag_snapshot_t;
+
+/**
+ * Change of the memory usage between two snapshots
+ */
+typedef struct {
+    intptr_t size[LV_MEM_TAG_CNT];  /**< Change of the allocated bytes per tag */
+    int32_t cnt[LV_MEM_TAG_CNT];    /**< Change of the number of allocations per tag */
+    intptr_t total_size;
+    int32_t total_cnt;
+} lv_mem_tag_diff_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -155,10 +222,133 @@ lv_result_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+#if LV_USE_MEM_SLAB
+/**
+ * Get the number of slab size classes
+ * @return          number of size classes
+ */
+uint32_t lv_mem_slab_get_class_count(void);
+
+/**
+ * Give information about a slab size class
+ * @param class_idx index of the size class, `< lv_mem_slab_get_class_count()`
+ * @param info      the result will be stored here
+ */
+void lv_mem_slab_get_class_info(uint32_t class_idx, lv_mem_slab_class_info_t * info);
+#endif
+
+#if LV_USE_MEM_TAGS
+/**
+ * Allocate memory and attribute it to a tag.
+ * `lv_malloc()` calls it with the tag of the file.
+ * @param size      requested size in bytes
+ * @param tag       the subsystem to attribute the memory to
+ * @return          pointer to allocated uninitialized memory, or NULL on failure
+ */
+void * lv_malloc_tagged(size_t size, lv_mem_tag_t tag);
+
+/**
+ * Allocate zeroed memory and attribute it to a tag.
+ * `lv_malloc_zeroed()`, `lv_zalloc()` and `lv_calloc()` call it with the tag of the file.
+ * @param size      requested size in bytes
+ * @param tag       the subsystem to attribute the memory to
+ * @return          pointer to allocated zeroed memory, or NULL on failure
+ */
+void * lv_malloc_zeroed_tagged(size_t size, lv_mem_tag_t tag);
+
+/**
+ * Reallocate a memory with a new size. The old content and the tag is kept.
+ * `lv_realloc()` calls it with the tag of the file.
+ * @param data_p    pointer to an allocated memory
+ * @param new_size  the desired new size in byte
+ * @param tag       the tag to use if `data_p` is NULL and new memory is allocated
+ * @return          pointer to the new memory, NULL on failure
+ */
+void * lv_realloc_tagged(void * data_p, size_t new_size, lv_mem_tag_t tag);
+
+/**
+ * Attribute an allocated memory to an other tag.
+ * E.g. to move a draw buffer allocated by `lv_draw_buf_create()` to the tag of the user of the buffer.
+ * @param data      pointer returned by `lv_malloc()` or `lv_realloc()`
+ * @param tag       the new tag
+ */
+void lv_mem_tag_set(void * data, lv_mem_tag_t tag);
+
+/**
+ * Get the tag of an allocated memory
+ * @param data      pointer returned by `lv_malloc()` or `lv_realloc()`
+ * @return          the tag of the memory
+ */
+lv_mem_tag_t lv_mem_tag_get(const void * data);
+
+/**
+ * Get the name of a tag, e.g. "layer"
+ * @param tag       a tag
+ * @return          the name of the tag
+ */
+const char * lv_mem_tag_get_name(lv_mem_tag_t tag);
+
+/**
+ * Get the memory usage of a tag
+ * @param tag       a tag
+ * @param info      the result will be stored here
+ */
+void lv_mem_tag_get_info(lv_mem_tag_t tag, lv_mem_tag_info_t * info);
+
+/**
+ * Save the memory usage of all tags, e.g. before and after opening a screen
+ * @param snapshot  the result will be stored here
+ */
+void lv_mem_tag_take_snapshot(lv_mem_tag_snapshot_t * snapshot);
+
+/**
+ * Calculate how the memory usage changed between two snapshots
+ * @param before    the earlier snapshot
+ * @param after     the later snapshot
+ * @param diff      the result will be stored here
+ */
+void lv_mem_tag_snapshot_diff(const lv_mem_tag_snapshot_t * before, const lv_mem_tag_snapshot_t * after,
+                              lv_mem_tag_diff_t * diff);
+
+/**
+ * Log the change of the memory usage per tag between two snapshots
+ * @param before    the earlier snapshot
+ * @param after     the later snapshot
+ */
+void lv_mem_tag_log_diff(const lv_mem_tag_snapshot_t * before, const lv_mem_tag_snapshot_t * after);
+
+/**
+ * Start tracking the peak of every tag from the current usage
+ */
+void lv_mem_tag_reset_peak(void);
+
+/**
+ * Write the current size of the tags whose size changed since the last call
+ * as counters to the profiler's trace (e.g. "mem:layer").
+ * It's called on every display refresh if the profiler is enabled.
+ */
+void lv_mem_tag_trace(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
 
+#if LV_USE_MEM_TAGS
+
+/*Attribute the allocations to the tag of the file calling them*/
+#ifndef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OTHER
+#endif
+
+#define lv_malloc(size)             lv_malloc_tagged((size), LV_MEM_TAG)
+#define lv_malloc_zeroed(size)      lv_malloc_zeroed_tagged((size), LV_MEM_TAG)
+#define lv_zalloc(size)             lv_malloc_zeroed_tagged((size), LV_MEM_TAG)
+#define lv_calloc(num, size)        lv_malloc_zeroed_tagged((num) * (size), LV_MEM_TAG)
+#define lv_realloc(data_p, size)    lv_realloc_tagged((data_p), (size), LV_MEM_TAG)
+
+#endif /*LV_USE_MEM_TAGS*/
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -24,6 +24,20 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_MEM_TAGS
+/** Stored in front of every allocation */
+typedef struct {
+    size_t size;                /**< Requested size */
+    size_t tag;                 /**< `lv_mem_tag_t`, `size_t` to keep the alignment of the allocator */
+} lv_mem_tag_header_t;
+
+typedef struct {
+    lv_mem_tag_info_t tags[LV_MEM_TAG_CNT];
+    lv_mem_tag_info_t total;
+    size_t traced_size[LV_MEM_TAG_CNT];     /**< The sizes written to the trace last time */
+} lv_mem_tag_state_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -0,0 +1,435 @@
+/**
+ * @file lv_mem_slab.c
+ *
+ * Size-class slab layer in front of `lv_malloc_core()`.
+ *
+ * A single arena is reserved at init and cut into `LV_MEM_SLAB_CHUNK_SIZE` sized chunks.
+ * A chunk is assigned to one size class on demand and is returned to the unused chunks
+ * when all of its blocks are freed, so memory can move between the classes.
+ * As the arena is contiguous, finding out whether a pointer is a slab block and
+ * which class it belongs to is only a range check and a division.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_mem_slab_private.h"
+#if LV_USE_MEM_SLAB
+
+#include "lv_string.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+#include "../misc/lv_math.h"
+#include "../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define state LV_GLOBAL_DEFAULT()->mem_slab_state
+
+#define CHUNK_HEADROOM(block_size) (LV_MEM_SLAB_CHUNK_SIZE - (block_size))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+typedef struct {
+    uint16_t cnt[LV_MEM_SLAB_CLASS_CNT];
+    void * blocks[LV_MEM_SLAB_CLASS_CNT][LV_MEM_SLAB_THREAD_CACHE_CNT];
+} thread_cache_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * class_alloc(uint32_t class_idx);
+static void class_free(lv_mem_slab_chunk_t * chunk, void * p);
+static void partial_add(lv_mem_slab_class_t * cls, lv_mem_slab_chunk_t * chunk);
+static void partial_remove(lv_mem_slab_class_t * cls, lv_mem_slab_chunk_t * chunk);
+static void lock(void);
+static void unlock(void);
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+    static thread_cache_t * thread_cache_get(void);
+    static void thread_cache_flush(thread_cache_t * tc, uint32_t class_idx, uint32_t keep);
+    static void thread_cache_destructor(void * tc);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+static inline uint32_t class_block_size(uint32_t class_idx)
+{
+    return (class_idx + 1) * LV_MEM_SLAB_ALIGN;
+}
+
+static inline lv_mem_slab_chunk_t * chunk_of(const void * p)
+{
+    return &state.chunks[((const uint8_t *)p - state.arena) / LV_MEM_SLAB_CHUNK_SIZE];
+}
+
+static inline uint8_t * chunk_data(const lv_mem_slab_chunk_t * chunk)
+{
+    return state.arena + (size_t)(chunk - state.chunks) * LV_MEM_SLAB_CHUNK_SIZE;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_mem_slab_init(void)
+{
+    uint32_t chunk_cnt = LV_MEM_SLAB_SIZE / LV_MEM_SLAB_CHUNK_SIZE;
+    if(chunk_cnt == 0) {
+        LV_LOG_WARN("LV_MEM_SLAB_SIZE is smaller than a chunk, slabs are not used");
+        return;
+    }
+
+    state.arena_alloc = lv_malloc_core((size_t)chunk_cnt * LV_MEM_SLAB_CHUNK_SIZE + LV_MEM_SLAB_ALIGN);
+    state.chunks = lv_malloc_core(chunk_cnt * sizeof(lv_mem_slab_chunk_t));
+    if(state.arena_alloc == NULL || state.chunks == NULL) {
+        LV_LOG_WARN("couldn't reserve the slab arena, slabs are not used");
+        if(state.arena_alloc) lv_free_core(state.arena_alloc);
+        if(state.chunks) lv_free_core(state.chunks);
+        state.arena_alloc = NULL;
+        state.chunks = NULL;
+        return;
+    }
+
+    state.arena = (uint8_t *)(((lv_uintptr_t)state.arena_alloc + LV_MEM_SLAB_ALIGN - 1) &
+                              ~(lv_uintptr_t)(LV_MEM_SLAB_ALIGN - 1));
+    state.arena_end = state.arena + (size_t)chunk_cnt * LV_MEM_SLAB_CHUNK_SIZE;
+
+    lv_memzero(state.chunks, chunk_cnt * sizeof(lv_mem_slab_chunk_t));
+    lv_memzero(state.classes, sizeof(state.classes));
+
+    /*Link the chunks in address order so that the beginning of the arena is used first*/
+    uint32_t i;
+    for(i = 0; i < chunk_cnt - 1; i++) {
+        state.chunks[i].next = &state.chunks[i + 1];
+    }
+    state.unused_chunks = &state.chunks[0];
+    state.unused_chunk_cnt = chunk_cnt;
+    state.fallback_cnt = 0;
+
+#if LV_USE_OS
+    lv_mutex_init(&state.mutex);
+#endif
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+    pthread_key_create(&state.thread_cache_key, thread_cache_destructor);
+#endif
+
+    state.inited = true;
+}
+
+void lv_mem_slab_deinit(void)
+{
+    if(!state.inited) return;
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+    /*Other threads flush their caches when they exit, only the caller's cache is left*/
+    thread_cache_t * tc = pthread_getspecific(state.thread_cache_key);
+    if(tc) {
+        pthread_setspecific(state.thread_cache_key, NULL);
+        thread_cache_destructor(tc);
+    }
+    pthread_key_delete(state.thread_cache_key);
+#endif
+
+    state.inited = false;
+
+#if LV_USE_OS
+    lv_mutex_delete(&state.mutex);
+#endif
+
+    lv_free_core(state.arena_alloc);
+    lv_free_core(state.chunks);
+    state.arena_alloc = NULL;
+    state.arena = NULL;
+    state.arena_end = NULL;
+    state.chunks = NULL;
+    state.unused_chunks = NULL;
+}
+
+void * lv_mem_slab_alloc(size_t size)
+{
+    if(size > LV_MEM_SLAB_MAX_SIZE || !state.inited) return NULL;
+
+    uint32_t class_idx = (uint32_t)(size - 1) / LV_MEM_SLAB_ALIGN;
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+    thread_cache_t * tc = thread_cache_get();
+    if(tc) {
+        if(tc->cnt[class_idx] == 0) {
+            /*Refill half of the cache at once to take the lock less often*/
+            lock();
+            while(tc->cnt[class_idx] < LV_MEM_SLAB_THREAD_CACHE_CNT / 2 + 1) {
+                void * p = class_alloc(class_idx);
+                if(p == NULL) break;
+                tc->blocks[class_idx][tc->cnt[class_idx]] = p;
+                tc->cnt[class_idx]++;
+            }
+            unlock();
+        }
+
+        if(tc->cnt[class_idx] == 0) return NULL;
+        tc->cnt[class_idx]--;
+        return tc->blocks[class_idx][tc->cnt[class_idx]];
+    }
+#endif
+
+    lock();
+    void * p = class_alloc(class_idx);
+    unlock();
+
+    return p;
+}
+
+bool lv_mem_slab_is_owned(const void * p)
+{
+    return (const uint8_t *)p >= state.arena && (const uint8_t *)p < state.arena_end;
+}
+
+bool lv_mem_slab_free(void * p)
+{
+    if(!lv_mem_slab_is_owned(p)) return false;
+
+    lv_mem_slab_chunk_t * chunk = chunk_of(p);
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+    thread_cache_t * tc = thread_cache_get();
+    if(tc) {
+        /*The class of a chunk can't change while it has a block in use, so it's safe to read without lock*/
+        uint32_t class_idx = chunk->class_idx;
+        if(tc->cnt[class_idx] == LV_MEM_SLAB_THREAD_CACHE_CNT) {
+            thread_cache_flush(tc, class_idx, LV_MEM_SLAB_THREAD_CACHE_CNT / 2);
+        }
+        tc->blocks[class_idx][tc->cnt[class_idx]] = p;
+        tc->cnt[class_idx]++;
+        return true;
+    }
+#endif
+
+    lock();
+    class_free(chunk, p);
+    unlock();
+
+    return true;
+}
+
+void * lv_mem_slab_realloc(void * p, size_t new_size)
+{
+    uint32_t class_idx = chunk_of(p)->class_idx;
+    uint32_t block_size = class_block_size(class_idx);
+
+    /*Still the same class, nothing to do*/
+    if(new_size <= block_size && new_size > block_size - LV_MEM_SLAB_ALIGN) return p;
+
+    void * new_p = lv_mem_slab_alloc(new_size);
+    if(new_p == NULL) new_p = lv_malloc_core(new_size);
+    if(new_p == NULL) return NULL;
+
+    lv_memcpy(new_p, p, LV_MIN(new_size, block_size));
+    lv_mem_slab_free(p);
+
+    return new_p;
+}
+
+void lv_mem_slab_monitor(lv_mem_monitor_t * mon_p)
+{
+    if(!state.inited) return;
+
+    size_t assigned_size = 0;
+    size_t used_size = 0;
+
+    lock();
+    uint32_t i;
+    for(i = 0; i < LV_MEM_SLAB_CLASS_CNT; i++) {
+        assigned_size += (size_t)state.classes[i].chunk_cnt * LV_MEM_SLAB_CHUNK_SIZE;
+        used_size += (size_t)state.classes[i].used_cnt * class_block_size(i);
+    }
+    mon_p->slab_fallback_cnt = state.fallback_cnt;
+    unlock();
+
+    mon_p->slab_total_size = (size_t)(state.arena_end - state.arena);
+    mon_p->slab_assigned_size = assigned_size;
+    mon_p->slab_used_size = used_size;
+    mon_p->slab_frag_pct = assigned_size ? (uint8_t)(100 - (used_size * 100) / assigned_size) : 0;
+}
+
+uint32_t lv_mem_slab_get_class_count(void)
+{
+    return LV_MEM_SLAB_CLASS_CNT;
+}
+
+void lv_mem_slab_get_class_info(uint32_t class_idx, lv_mem_slab_class_info_t * info)
+{
+    LV_ASSERT_NULL(info);
+    lv_memzero(info, sizeof(lv_mem_slab_class_info_t));
+    if(class_idx >= LV_MEM_SLAB_CLASS_CNT) return;
+
+    info->block_size = class_block_size(class_idx);
+    if(!state.inited) return;
+
+    lock();
+    lv_mem_slab_class_t * cls = &state.classes[class_idx];
+    info->chunk_cnt = cls->chunk_cnt;
+    info->used_cnt = cls->used_cnt;
+    info->max_used_cnt = cls->max_used_cnt;
+    info->free_cnt = cls->chunk_cnt * (LV_MEM_SLAB_CHUNK_SIZE / info->block_size) - cls->used_cnt;
+    unlock();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * class_alloc(uint32_t class_idx)
+{
+    lv_mem_slab_class_t * cls = &state.classes[class_idx];
+    uint32_t block_size = class_block_size(class_idx);
+
+    lv_mem_slab_chunk_t * chunk = cls->partial;
+    if(chunk == NULL) {
+        chunk = state.unused_chunks;
+        if(chunk == NULL) {
+            state.fallback_cnt++;
+            return NULL;
+        }
+        state.unused_chunks = chunk->next;
+        state.unused_chunk_cnt--;
+
+        chunk->free_list = NULL;
+        chunk->bump_ofs = 0;
+        chunk->used_cnt = 0;
+        chunk->class_idx = (uint8_t)class_idx;
+        cls->chunk_cnt++;
+        partial_add(cls, chunk);
+    }
+
+    void * p;
+    if(chunk->free_list) {
+        p = chunk->free_list;
+        chunk->free_list = *(void **)p;
+    }
+    else {
+        p = chunk_data(chunk) + chunk->bump_ofs;
+        chunk->bump_ofs += block_size;
+    }
+
+    chunk->used_cnt++;
+    if(chunk->free_list == NULL && chunk->bump_ofs > CHUNK_HEADROOM(block_size)) {
+        partial_remove(cls, chunk);
+    }
+
+    cls->used_cnt++;
+    if(cls->used_cnt > cls->max_used_cnt) cls->max_used_cnt = cls->used_cnt;
+
+    return p;
+}
+
+static void class_free(lv_mem_slab_chunk_t * chunk, void * p)
+{
+    lv_mem_slab_class_t * cls = &state.classes[chunk->class_idx];
+
+    *(void **)p = chunk->free_list;
+    chunk->free_list = p;
+    chunk->used_cnt--;
+    cls->used_cnt--;
+
+    if(!chunk->in_partial) partial_add(cls, chunk);
+
+    /*Keep the last chunk of the class to avoid moving a chunk back and forth*/
+    if(chunk->used_cnt == 0 && cls->chunk_cnt > 1) {
+        partial_remove(cls, chunk);
+        cls->chunk_cnt--;
+        chunk->next = state.unused_chunks;
+        state.unused_chunks = chunk;
+        state.unused_chunk_cnt++;
+    }
+}
+
+static void partial_add(lv_mem_slab_class_t * cls, lv_mem_slab_chunk_t * chunk)
+{
+    chunk->prev = NULL;
+    chunk->next = cls->partial;
+    if(cls->partial) cls->partial->prev = chunk;
+    cls->partial = chunk;
+    chunk->in_partial = 1;
+}
+
+static void partial_remove(lv_mem_slab_class_t * cls, lv_mem_slab_chunk_t * chunk)
+{
+    if(chunk->prev) chunk->prev->next = chunk->next;
+    else cls->partial = chunk->next;
+    if(chunk->next) chunk->next->prev = chunk->prev;
+    chunk->next = NULL;
+    chunk->prev = NULL;
+    chunk->in_partial = 0;
+}
+
+static void lock(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+}
+
+static void unlock(void)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+
+static thread_cache_t * thread_cache_get(void)
+{
+    thread_cache_t * tc = pthread_getspecific(state.thread_cache_key);
+    if(tc) return tc;
+
+    tc = lv_malloc_core(sizeof(thread_cache_t));
+    if(tc == NULL) return NULL;
+
+    lv_memzero(tc->cnt, sizeof(tc->cnt));
+    if(pthread_setspecific(state.thread_cache_key, tc) != 0) {
+        lv_free_core(tc);
+        return NULL;
+    }
+
+    return tc;
+}
+
+static void thread_cache_flush(thread_cache_t * tc, uint32_t class_idx, uint32_t keep)
+{
+    lock();
+    while(tc->cnt[class_idx] > keep) {
+        tc->cnt[class_idx]--;
+        void * p = tc->blocks[class_idx][tc->cnt[class_idx]];
+        class_free(chunk_of(p), p);
+    }
+    unlock();
+}
+
+static void thread_cache_destructor(void * tc)
+{
+    if(state.inited) {
+        uint32_t i;
+        for(i = 0; i < LV_MEM_SLAB_CLASS_CNT; i++) {
+            thread_cache_flush(tc, i, 0);
+        }
+    }
+    lv_free_core(tc);
+}
+
+#endif /*LV_MEM_SLAB_THREAD_CACHE_CNT*/
+
+#endif /*LV_USE_MEM_SLAB*/
@@ -0,0 +1,145 @@
+/**
+ * @file lv_mem_slab_private.h
+ *
+ */
+
+#ifndef LV_MEM_SLAB_PRIVATE_H
+#define LV_MEM_SLAB_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_mem.h"
+
+#if LV_USE_MEM_SLAB
+
+#include "../osal/lv_os.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifdef LV_ARCH_64
+    #define LV_MEM_SLAB_ALIGN       16
+#else
+    #define LV_MEM_SLAB_ALIGN       8
+#endif
+
+/** Size classes are spaced `LV_MEM_SLAB_ALIGN` bytes apart up to `LV_MEM_SLAB_MAX_SIZE` */
+#define LV_MEM_SLAB_CLASS_CNT   ((LV_MEM_SLAB_MAX_SIZE + LV_MEM_SLAB_ALIGN - 1) / LV_MEM_SLAB_ALIGN)
+
+#if LV_MEM_SLAB_CHUNK_SIZE < LV_MEM_SLAB_MAX_SIZE
+    #error "LV_MEM_SLAB_CHUNK_SIZE must be larger than LV_MEM_SLAB_MAX_SIZE"
+#endif
+
+#if LV_MEM_SLAB_THREAD_CACHE_CNT && LV_USE_OS != LV_OS_PTHREAD
+    #warning "LV_MEM_SLAB_THREAD_CACHE_CNT requires LV_OS_PTHREAD, the thread caches are disabled"
+    #undef LV_MEM_SLAB_THREAD_CACHE_CNT
+    #define LV_MEM_SLAB_THREAD_CACHE_CNT 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Bookkeeping of one `LV_MEM_SLAB_CHUNK_SIZE` sized part of the slab arena */
+typedef struct _lv_mem_slab_chunk_t {
+    struct _lv_mem_slab_chunk_t * next;     /**< Next chunk in the partial list of the class or in the unused list */
+    struct _lv_mem_slab_chunk_t * prev;
+    void * free_list;                       /**< Freed blocks of this chunk, linked through their first word */
+    uint32_t bump_ofs;                      /**< Offset of the first block which was never handed out */
+    uint16_t used_cnt;                      /**< Blocks handed out from this chunk */
+    uint8_t class_idx;
+    uint8_t in_partial : 1;                 /**< 1: the chunk is on the partial list of its class */
+} lv_mem_slab_chunk_t;
+
+typedef struct {
+    lv_mem_slab_chunk_t * partial;          /**< Chunks having at least one free block */
+    uint32_t chunk_cnt;                     /**< Chunks assigned to this class */
+    uint32_t used_cnt;                      /**< Blocks handed out (thread caches included) */
+    uint32_t max_used_cnt;
+} lv_mem_slab_class_t;
+
+typedef struct {
+    bool inited;
+    void * arena_alloc;                     /**< The block returned by the allocator */
+    uint8_t * arena;                        /**< Aligned start of the first chunk */
+    uint8_t * arena_end;
+    lv_mem_slab_chunk_t * chunks;           /**< Bookkeeping of every chunk of the arena */
+    lv_mem_slab_chunk_t * unused_chunks;    /**< Chunks not assigned to any class */
+    uint32_t unused_chunk_cnt;
+    uint32_t fallback_cnt;                  /**< Small requests passed to the allocator as the arena was full */
+    lv_mem_slab_class_t classes[LV_MEM_SLAB_CLASS_CNT];
+#if LV_USE_OS
+    lv_mutex_t mutex;
+#endif
+#if LV_MEM_SLAB_THREAD_CACHE_CNT
+    pthread_key_t thread_cache_key;
+#endif
+} lv_mem_slab_state_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Reserve the slab arena. Called by `lv_init()` after the allocator is initialized.
+ */
+void lv_mem_slab_init(void);
+
+/**
+ * Give back the slab arena to the allocator. Every block served from the slabs is invalid afterwards.
+ */
+void lv_mem_slab_deinit(void);
+
+/**
+ * Allocate a block from the slab of the matching size class
+ * @param size      requested size in bytes
+ * @return          pointer to the block, or NULL if `size` is too large or the arena is full
+ */
+void * lv_mem_slab_alloc(size_t size);
+
+/**
+ * Return a block to its slab if it was served from there
+ * @param p         pointer to an allocated memory
+ * @return          true: `p` was freed; false: `p` is not a slab block
+ */
+bool lv_mem_slab_free(void * p);
+
+/**
+ * Check if a pointer was served from the slabs
+ * @param p         pointer to an allocated memory
+ * @return          true: `p` is a slab block
+ */
+bool lv_mem_slab_is_owned(const void * p);
+
+/**
+ * Resize a slab block. The result might be a slab block or a block of the allocator.
+ * @param p         pointer to a slab block
+ * @param new_size  the desired new size in bytes
+ * @return          pointer to the new memory, NULL on failure (`p` is kept in this case)
+ */
+void * lv_mem_slab_realloc(void * p, size_t new_size);
+
+/**
+ * Add the state of the slabs to a memory monitor descriptor
+ * @param mon_p     pointer to a `lv_mem_monitor_t` to update
+ */
+void lv_mem_slab_monitor(lv_mem_monitor_t * mon_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_MEM_SLAB*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_MEM_SLAB_PRIVATE_H*/
@@ -17,6 +17,8 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_STYLE
 
 struct _my_theme_t;
 typedef struct _my_theme_t my_theme_t;
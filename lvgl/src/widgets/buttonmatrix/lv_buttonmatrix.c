@@ -24,6 +24,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_buttonmatrix_class)
 
 #define BTN_EXTRA_CLICK_AREA_MAX (LV_DPI_DEF / 10)
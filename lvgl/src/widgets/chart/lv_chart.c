@@ -18,6 +18,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_chart_class)
 
 #define LV_CHART_HDIV_DEF 3
@@ -43,6 +46,13 @@ static void draw_series_scatter(lv_obj_t * obj, lv_layer_t * layer);
 static void draw_cursors(lv_obj_t * obj, lv_layer_t * layer);
 static uint32_t get_index_from_x(lv_obj_t * obj, int32_t x);
 static void invalidate_point(lv_obj_t * obj, uint32_t i);
+static void draw_series_line_crowded(lv_obj_t * obj, lv_layer_t * layer, lv_chart_series_t * ser,
+                                     lv_draw_line_dsc_t * line_dsc, const lv_area_t * clip_area);
+static bool column_cache_update(lv_obj_t * obj, lv_chart_series_t * ser, int32_t w);
+static void column_cache_update_point(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t id);
+static void column_cache_invalidate_all(lv_obj_t * obj);
+static void column_cache_calc(lv_chart_t * chart, lv_chart_series_t * ser, uint32_t col);
+static uint32_t column_start_id(uint32_t point_cnt, uint32_t w, uint32_t col);
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, int32_t ** a);
 
 /**********************
@@ -122,6 +132,7 @@ void lv_chart_set_point_count(lv_obj_t * obj, uint32_t cnt)
         }
         if(!ser->y_ext_buf_assigned) new_points_alloc(obj, ser, cnt, &ser->y_points);
         ser->start_point = 0;
+        ser->column_cache_valid = 0;
     }
 
     chart->point_cnt = cnt;
@@ -169,6 +180,7 @@ void lv_chart_set_update_mode(lv_obj_t * obj, lv_chart_update_mode_t update_mode
     if(chart->update_mode == update_mode) return;
 
     chart->update_mode = update_mode;
+    column_cache_invalidate_all(obj);
     lv_obj_invalidate(obj);
 }
 
@@ -293,6 +305,8 @@ void lv_chart_refresh(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The values might have been changed directly in the arrays*/
+    column_cache_invalidate_all(obj);
     lv_obj_invalidate(obj);
 }
 
@@ -370,6 +384,7 @@ void lv_chart_remove_series(lv_obj_t * obj, lv_chart_series_t * series)
     lv_chart_t * chart    = (lv_chart_t *)obj;
     if(!series->y_ext_buf_assigned && series->y_points) lv_free(series->y_points);
     if(!series->x_ext_buf_assigned && series->x_points) lv_free(series->x_points);
+    lv_free(series->column_cache);
 
     lv_ll_remove(&chart->series_ll, series);
     lv_free(series);
@@ -412,6 +427,7 @@ void lv_chart_set_x_start_point(lv_obj_t * obj, lv_chart_series_t * ser, uint32_
     lv_chart_t * chart  = (lv_chart_t *)obj;
     if(id >= chart->point_cnt) return;
     ser->start_point = id;
+    ser->column_cache_valid = 0;
 }
 
 lv_chart_series_t * lv_chart_get_series_next(const lv_obj_t * obj, const lv_chart_series_t * ser)
@@ -501,6 +517,7 @@ void lv_chart_set_next_value(lv_obj_t * obj, lv_chart_series_t * ser, int32_t va
 
     lv_chart_t * chart  = (lv_chart_t *)obj;
     ser->y_points[ser->start_point] = value;
+    column_cache_update_point(obj, ser, ser->start_point);
     invalidate_point(obj, ser->start_point);
     ser->start_point = (ser->start_point + 1) % chart->point_cnt;
     invalidate_point(obj, ser->start_point);
@@ -550,6 +567,7 @@ void lv_chart_set_series_value_by_id(lv_obj_t * obj, lv_chart_series_t * ser, ui
 
     if(id >= chart->point_cnt) return;
     ser->y_points[id] = value;
+    column_cache_update_point(obj, ser, id);
     invalidate_point(obj, id);
 }
 
@@ -579,6 +597,7 @@ void lv_chart_set_series_ext_y_array(lv_obj_t * obj, lv_chart_series_t * ser, in
     if(!ser->y_ext_buf_assigned && ser->y_points) lv_free(ser->y_points);
     ser->y_ext_buf_assigned = true;
     ser->y_points = array;
+    ser->column_cache_valid = 0;
     lv_obj_invalidate(obj);
 }
 
@@ -679,6 +698,7 @@ static void lv_chart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
         if(!ser->y_ext_buf_assigned) lv_free(ser->y_points);
         if(!ser->x_ext_buf_assigned) lv_free(ser->x_points);
+        lv_free(ser->column_cache);
 
         lv_ll_remove(&chart->series_ll, ser);
         lv_free(ser);
@@ -857,7 +877,7 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
     int32_t point_w = lv_obj_get_style_width(obj, LV_PART_INDICATOR) / 2;
     int32_t point_h = lv_obj_get_style_height(obj, LV_PART_INDICATOR) / 2;
 
-    /*If there are at least as many points as pixels then draw only vertical lines*/
+    /*If there are at least as many points as pixels then draw only a vertical line in each pixel column*/
     bool crowded_mode = (int32_t)chart->point_cnt >= w;
 
     line_dsc.base.id1 = lv_ll_get_len(&chart->series_ll) - 1;
@@ -874,6 +894,13 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
         line_dsc.base.id2 = 0;
         point_dsc_default.base.id2 = 0;
 
+        if(crowded_mode) {
+            draw_series_line_crowded(obj, layer, ser, &line_dsc, &clip_area_ori);
+            point_dsc_default.base.id1--;
+            line_dsc.base.id1--;
+            continue;
+        }
+
         int32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
 
         line_dsc.p1.x = x_ofs;
@@ -885,9 +912,6 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
         y_tmp  = y_tmp / (chart->ymax[ser->y_axis_sec] - chart->ymin[ser->y_axis_sec]);
         line_dsc.p2.y   = h - y_tmp + y_ofs;
 
-        lv_value_precise_t y_min = line_dsc.p2.y;
-        lv_value_precise_t y_max = line_dsc.p2.y;
-
         for(i = 0; i < chart->point_cnt; i++) {
             line_dsc.p1.x = line_dsc.p2.x;
             line_dsc.p1.y = line_dsc.p2.y;
@@ -908,49 +932,27 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
 
             /*Don't draw the first point. A second point is also required to draw the line*/
             if(i != 0) {
-                if(crowded_mode) {
-                    if(ser->y_points[p_prev] != LV_CHART_POINT_NONE && ser->y_points[p_act] != LV_CHART_POINT_NONE) {
-                        /*Draw only one vertical line between the min and max y-values on the same x-value*/
-                        y_max = LV_MAX(y_max, line_dsc.p2.y);
-                        y_min = LV_MIN(y_min, line_dsc.p2.y);
-                        if(line_dsc.p1.x != line_dsc.p2.x) {
-                            lv_value_precise_t y_cur = line_dsc.p2.y;
-                            line_dsc.p2.x--;         /*It's already on the next x value*/
-                            line_dsc.p1.x = line_dsc.p2.x;
-                            line_dsc.p1.y = y_min;
-                            line_dsc.p2.y = y_max;
-                            if(line_dsc.p1.y == line_dsc.p2.y) line_dsc.p2.y++;    /*If they are the same no line will be drawn*/
-                            lv_draw_line(layer, &line_dsc);
-                            line_dsc.p2.x++;         /*Compensate the previous x--*/
-                            y_min = y_cur;  /*Start the line of the next x from the current last y*/
-                            y_max = y_cur;
-                        }
-                    }
-                }
-                else {
-                    lv_area_t point_area;
-                    point_area.x1 = (int32_t)line_dsc.p1.x - point_w;
-                    point_area.x2 = (int32_t)line_dsc.p1.x + point_w;
-                    point_area.y1 = (int32_t)line_dsc.p1.y - point_h;
-                    point_area.y2 = (int32_t)line_dsc.p1.y + point_h;
-
-                    if(ser->y_points[p_prev] != LV_CHART_POINT_NONE && ser->y_points[p_act] != LV_CHART_POINT_NONE) {
-                        line_dsc.base.id2 = i;
-                        lv_draw_line(layer, &line_dsc);
-                    }
+                lv_area_t point_area;
+                point_area.x1 = (int32_t)line_dsc.p1.x - point_w;
+                point_area.x2 = (int32_t)line_dsc.p1.x + point_w;
+                point_area.y1 = (int32_t)line_dsc.p1.y - point_h;
+                point_area.y2 = (int32_t)line_dsc.p1.y + point_h;
 
-                    if(point_w && point_h && ser->y_points[p_prev] != LV_CHART_POINT_NONE) {
-                        point_dsc_default.base.id2 = i - 1;
-                        lv_draw_rect(layer, &point_dsc_default, &point_area);
-                    }
+                if(ser->y_points[p_prev] != LV_CHART_POINT_NONE && ser->y_points[p_act] != LV_CHART_POINT_NONE) {
+                    line_dsc.base.id2 = i;
+                    lv_draw_line(layer, &line_dsc);
                 }
 
+                if(point_w && point_h && ser->y_points[p_prev] != LV_CHART_POINT_NONE) {
+                    point_dsc_default.base.id2 = i - 1;
+                    lv_draw_rect(layer, &point_dsc_default, &point_area);
+                }
             }
             p_prev = p_act;
         }
 
         /*Draw the last point*/
-        if(!crowded_mode && i == chart->point_cnt) {
+        if(i == chart->point_cnt) {
 
             if(ser->y_points[p_act] != LV_CHART_POINT_NONE) {
                 lv_area_t point_area;
@@ -970,6 +972,75 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
     layer->_clip_area = clip_area_ori;
 }
 
+/**
+ * Draw a line series which has at least as many points as pixel columns.
+ * Only one vertical line is drawn in each column, between the smallest and largest value
+ * of the column's points and the first point of the next column.
+ * The min/max values are cached, so the points are not processed again on every redraw.
+ */
+static void draw_series_line_crowded(lv_obj_t * obj, lv_layer_t * layer, lv_chart_series_t * ser,
+                                     lv_draw_line_dsc_t * line_dsc, const lv_area_t * clip_area)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    int32_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    int32_t pad_left = lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width;
+    int32_t pad_top = lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + border_width;
+    int32_t w     = lv_obj_get_content_width(obj);
+    int32_t h     = lv_obj_get_content_height(obj);
+    int32_t x_ofs = obj->coords.x1 + pad_left - lv_obj_get_scroll_left(obj);
+    int32_t y_ofs = obj->coords.y1 + pad_top - lv_obj_get_scroll_top(obj);
+
+    if(w <= 0) return;
+    if(column_cache_update(obj, ser, w) == false) return;
+
+    uint32_t point_cnt = chart->point_cnt;
+    uint32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+    int32_t ymin = chart->ymin[ser->y_axis_sec];
+    int32_t yrange = chart->ymax[ser->y_axis_sec] - ymin;
+
+    /*Skip the columns whose lines can't be in the clip area*/
+    int32_t margin = line_dsc->width + 2;
+    int32_t col_first = LV_MAX(clip_area->x1 - x_ofs - margin, 0);
+    int32_t col_last = LV_MIN(clip_area->x2 - x_ofs + margin, w);
+    if(col_first > col_last) return;
+
+    int32_t prev_col = -1;
+    uint32_t id_next = column_start_id(point_cnt, w, col_first);
+    int32_t col;
+    for(col = col_first; col <= w; col++) {
+        uint32_t id = id_next;
+        id_next = column_start_id(point_cnt, w, col + 1);
+        if(id >= id_next) continue;     /*No points in this column*/
+
+        /*The line of the previous column is drawn right before this column*/
+        if(prev_col >= 0) {
+            int32_t vmin = ser->column_cache[prev_col * 2];
+            int32_t vmax = ser->column_cache[prev_col * 2 + 1];
+            if(vmin <= vmax) {  /*Not only LV_CHART_POINT_NONE points*/
+                uint32_t p = id + start_point;
+                if(p >= point_cnt) p -= point_cnt;
+                int32_t v_next = ser->y_points[p];
+                if(v_next != LV_CHART_POINT_NONE) {
+                    vmin = LV_MIN(vmin, v_next);
+                    vmax = LV_MAX(vmax, v_next);
+                }
+
+                int32_t y_vmin = h - ((vmin - ymin) * h) / yrange + y_ofs;
+                int32_t y_vmax = h - ((vmax - ymin) * h) / yrange + y_ofs;
+                line_dsc->p1.x = col - 1 + x_ofs;
+                line_dsc->p2.x = line_dsc->p1.x;
+                line_dsc->p1.y = LV_MIN(y_vmin, y_vmax);
+                line_dsc->p2.y = LV_MAX(y_vmin, y_vmax);
+                if(line_dsc->p1.y == line_dsc->p2.y) line_dsc->p2.y++;    /*If they are the same no line will be drawn*/
+                lv_draw_line(layer, line_dsc);
+            }
+        }
+
+        if(col > col_last) break;
+        prev_col = col;
+    }
+}
+
 static void draw_series_scatter(lv_obj_t * obj, lv_layer_t * layer)
 {
 
@@ -1378,6 +1449,103 @@ static void invalidate_point(lv_obj_t * obj, uint32_t i)
     }
 }
 
+/**
+ * Make sure the min/max values of the pixel columns are up to date for a content width
+ * @param obj   pointer to a chart
+ * @param ser   pointer to a series
+ * @param w     content width of the chart
+ * @return      false if the cache couldn't be allocated
+ */
+static bool column_cache_update(lv_obj_t * obj, lv_chart_series_t * ser, int32_t w)
+{
+    lv_chart_t * chart = (lv_chart_t *)obj;
+    uint32_t column_cnt = w + 1;
+    if(ser->column_cache_valid && ser->column_cnt == column_cnt) return true;
+
+    if(ser->column_cnt != column_cnt) {
+        int32_t * new_cache = lv_realloc(ser->column_cache, sizeof(int32_t) * 2 * column_cnt);
+        LV_ASSERT_MALLOC(new_cache);
+        if(new_cache == NULL) return false;
+        ser->column_cache = new_cache;
+        ser->column_cnt = column_cnt;
+    }
+
+    uint32_t col;
+    for(col = 0; col < column_cnt; col++) {
+        column_cache_calc(chart, ser, col);
+    }
+    ser->column_cache_valid = 1;
+
+    return true;
+}
+
+/**
+ * Update the min/max values of the column of a point after its value has changed
+ * @param obj   pointer to a chart
+ * @param ser   pointer to a series
+ * @param id    index of the changed point
+ */
+static void column_cache_update_point(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t id)
+{
+    if(ser->column_cache_valid == 0) return;
+
+    /*In shift mode all the points move to an other position so everything needs to be recalculated*/
+    lv_chart_t * chart = (lv_chart_t *)obj;
+    if(chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
+        ser->column_cache_valid = 0;
+        return;
+    }
+
+    uint32_t w = ser->column_cnt - 1;
+    column_cache_calc(chart, ser, (w * id) / (chart->point_cnt - 1));
+}
+
+static void column_cache_invalidate_all(lv_obj_t * obj)
+{
+    lv_chart_t * chart = (lv_chart_t *)obj;
+    lv_chart_series_t * ser;
+    LV_LL_READ(&chart->series_ll, ser) {
+        ser->column_cache_valid = 0;
+    }
+}
+
+static void column_cache_calc(lv_chart_t * chart, lv_chart_series_t * ser, uint32_t col)
+{
+    uint32_t w = ser->column_cnt - 1;
+    uint32_t point_cnt = chart->point_cnt;
+    uint32_t id = column_start_id(point_cnt, w, col);
+    uint32_t id_end = column_start_id(point_cnt, w, col + 1);
+
+    uint32_t p = id + (chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0);
+    if(p >= point_cnt) p -= point_cnt;
+
+    int32_t vmin = INT32_MAX;
+    int32_t vmax = INT32_MIN;
+    for(; id < id_end; id++) {
+        int32_t v = ser->y_points[p];
+        if(v != LV_CHART_POINT_NONE) {
+            if(v < vmin) vmin = v;
+            if(v > vmax) vmax = v;
+        }
+        p++;
+        if(p == point_cnt) p = 0;
+    }
+
+    ser->column_cache[col * 2] = vmin;
+    ser->column_cache[col * 2 + 1] = vmax;
+}
+
+/**
+ * Get the index of the first point which is drawn in a pixel column
+ * (or `point_cnt` if there are no points from that column).
+ * The point with index `i` is in the column `(w * i) / (point_cnt - 1)`.
+ */
+static uint32_t column_start_id(uint32_t point_cnt, uint32_t w, uint32_t col)
+{
+    uint32_t id = (col * (point_cnt - 1) + w - 1) / w;
+    return LV_MIN(id, point_cnt);
+}
+
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, int32_t ** a)
 {
     if((*a) == NULL) return;
@@ -33,13 +33,16 @@ extern "C" {
 struct _lv_chart_series_t {
     int32_t * x_points;
     int32_t * y_points;
+    int32_t * column_cache;     /**< Min and max value of each pixel column if there are more points than pixels*/
     lv_color_t color;
     uint32_t start_point;
+    uint32_t column_cnt;        /**< Number of min/max pairs in `column_cache`*/
     uint32_t hidden : 1;
     uint32_t x_ext_buf_assigned : 1;
     uint32_t y_ext_buf_assigned : 1;
     uint32_t x_axis_sec : 1;
     uint32_t y_axis_sec : 1;
+    uint32_t column_cache_valid : 1;
 };
 
 struct _lv_chart_cursor_t {
@@ -27,6 +27,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_dropdown_class)
 #define MY_CLASS_LIST &lv_dropdownlist_class
 
@@ -18,6 +18,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_keyboard_class)
 #define LV_KB_BTN(width) LV_BUTTONMATRIX_CTRL_POPOVER | width
 
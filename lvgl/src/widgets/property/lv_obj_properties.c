@@ -37,6 +37,7 @@ const lv_property_name_t lv_obj_property_names[73] = {
     {"flag_layout_2",          LV_PROPERTY_OBJ_FLAG_LAYOUT_2,},
     {"flag_overflow_visible",  LV_PROPERTY_OBJ_FLAG_OVERFLOW_VISIBLE,},
     {"flag_press_lock",        LV_PROPERTY_OBJ_FLAG_PRESS_LOCK,},
+    {"flag_scroll_blit",       LV_PROPERTY_OBJ_FLAG_SCROLL_BLIT,},
     {"flag_scroll_chain_hor",  LV_PROPERTY_OBJ_FLAG_SCROLL_CHAIN_HOR,},
     {"flag_scroll_chain_ver",  LV_PROPERTY_OBJ_FLAG_SCROLL_CHAIN_VER,},
     {"flag_scroll_elastic",    LV_PROPERTY_OBJ_FLAG_SCROLL_ELASTIC,},
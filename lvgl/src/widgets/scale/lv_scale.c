@@ -19,6 +19,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_scale_class)
 
 #define LV_SCALE_LABEL_TXT_LEN          (20U)
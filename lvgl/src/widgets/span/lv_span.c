@@ -22,6 +22,9 @@
 /*********************
  *      DEFINES
  *********************/
+#undef LV_MEM_TAG
+#define LV_MEM_TAG LV_MEM_TAG_OBJ
+
 #define MY_CLASS (&lv_spangroup_class)
 #define snippet_stack LV_GLOBAL_DEFAULT()->span_snippet_stack
 
@@ -23,6 +23,11 @@ extern "C" {
 #define LV_USE_OS                   LV_OS_PTHREAD
 #define LV_OBJ_STYLE_CACHE          0
 #define LV_BIN_DECODER_RAM_LOAD     1   /* Run test with bin image loaded to RAM */
+#define LV_USE_MEM_SLAB             1   /* Serve small allocations from slabs on top of malloc */
+#define LV_MEM_SLAB_THREAD_CACHE_CNT 16
+#define LV_USE_MEM_TAGS             1   /* Account the allocations per subsystem */
+#define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE 64
+#define LV_ANIM_PATH_LUT            1
 #endif
 
 #ifdef LVGL_CI_USING_DEF_HEAP
@@ -3,7 +3,13 @@
 
 #define LV_MEM_SIZE                     (32 * 1024 * 1024)
 #define LV_DRAW_SW_SHADOW_CACHE_SIZE    8
+#define LV_DRAW_SW_ARC_CACHE_SIZE       (256 * 1024)
+#define LV_OBJ_RENDER_CACHE_SIZE        (1024 * 1024)
+#define LV_USE_OCCLUSION_CULLING        1
+#define LV_USE_OVERDRAW_DEBUG           1
+#define LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN 16
 #define LV_DRAW_THREAD_STACK_SIZE    (64 * 1024) /*Increase stack size to 64KB in order to run ThorVG*/
+#define LV_DRAW_TASK_ARENA_SIZE         (4 * 1024)
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
 #define LV_LOG_PRINTF           1
@@ -151,4 +151,54 @@ void test_cache_1(void)
     TEST_ASSERT_EQUAL(40, lv_cache_get_free_size(cache, NULL));
 }
 
+
+static bool create_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    node->data = lv_malloc(node->slot.size);
+    return node->data != NULL;
+}
+
+void test_cache_hit_miss_count(void)
+{
+    lv_cache_set_create_cb(cache, (lv_cache_create_cb_t)create_cb, NULL);
+
+    test_data search_key = {
+        .slot.size = 100,
+        .key1 = 1,
+        .key2 = 2
+    };
+
+    /*Not found and not added*/
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+    TEST_ASSERT_NULL(entry);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_miss_count(cache));
+
+    entry = lv_cache_acquire_or_create(cache, &search_key, NULL);
+    TEST_ASSERT_NOT_NULL(entry);
+    lv_cache_release(cache, entry, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_cache_get_miss_count(cache));
+
+    entry = lv_cache_acquire_or_create(cache, &search_key, NULL);
+    lv_cache_release(cache, entry, NULL);
+    entry = lv_cache_acquire(cache, &search_key, NULL);
+    lv_cache_release(cache, entry, NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_cache_get_miss_count(cache));
+
+    search_key.key1 = 10;
+    entry = lv_cache_add(cache, &search_key, NULL);
+    test_data * data = lv_cache_entry_get_data(entry);
+    data->data = lv_malloc(data->slot.size);
+    lv_cache_release(cache, entry, NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_cache_get_miss_count(cache));
+
+    lv_cache_reset_stats(cache);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_miss_count(cache));
+}
+
 #endif
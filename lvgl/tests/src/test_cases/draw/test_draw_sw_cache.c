@@ -0,0 +1,301 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include <time.h>
+
+#define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
+#define circle_cache LV_GLOBAL_DEFAULT()->sw_circle_cache
+#define arc_cache LV_GLOBAL_DEFAULT()->sw_arc_cache
+
+static uint8_t * ref_buf;
+static size_t shadow_cache_size_ori;
+static size_t circle_cache_size_ori;
+static size_t arc_cache_size_ori;
+
+void setUp(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    ref_buf = lv_malloc(buf->data_size);
+    TEST_ASSERT_NOT_NULL(ref_buf);
+
+    shadow_cache_size_ori = lv_cache_get_max_size(shadow_cache, NULL);
+    circle_cache_size_ori = lv_cache_get_max_size(circle_cache, NULL);
+    arc_cache_size_ori = lv_cache_get_max_size(arc_cache, NULL);
+}
+
+void tearDown(void)
+{
+    lv_free(ref_buf);
+    lv_obj_clean(lv_screen_active());
+
+    lv_cache_drop_all(shadow_cache, NULL);
+    lv_cache_drop_all(circle_cache, NULL);
+    lv_cache_drop_all(arc_cache, NULL);
+    lv_cache_set_max_size(shadow_cache, shadow_cache_size_ori, NULL);
+    lv_cache_set_max_size(circle_cache, circle_cache_size_ori, NULL);
+    lv_cache_set_max_size(arc_cache, arc_cache_size_ori, NULL);
+}
+
+static void set_cache_sizes(size_t shadow_size, size_t circle_cnt)
+{
+    lv_cache_drop_all(shadow_cache, NULL);
+    lv_cache_drop_all(circle_cache, NULL);
+    lv_cache_set_max_size(shadow_cache, shadow_size, NULL);
+    lv_cache_set_max_size(circle_cache, circle_cnt, NULL);
+    lv_cache_reset_stats(shadow_cache);
+    lv_cache_reset_stats(circle_cache);
+}
+
+static void set_arc_cache_size(size_t size)
+{
+    lv_cache_drop_all(arc_cache, NULL);
+    lv_cache_set_max_size(arc_cache, size, NULL);
+    lv_cache_reset_stats(arc_cache);
+}
+
+/**
+ * Create cards with a few different shadow sizes and radii.
+ * Some of them are small to have corners affected by the size of the card too.
+ */
+static void create_cards(void)
+{
+    static const int32_t params[][4] = {
+        /*width, height, radius, shadow width*/
+        {120, 80, 10, 20},
+        {120, 80, 10, 20},
+        {120, 80, 20, 30},
+        {60, 120, 20, 30},
+        {20, 20, 10, 40},
+        {10, 30, 0, 15},
+        {120, 40, LV_RADIUS_CIRCLE, 10},
+        {120, 40, LV_RADIUS_CIRCLE, 10},
+    };
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(scr, 40, 0);
+    lv_obj_set_style_pad_gap(scr, 50, 0);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+        lv_obj_t * card = lv_obj_create(scr);
+        lv_obj_set_size(card, params[i][0], params[i][1]);
+        lv_obj_set_style_radius(card, params[i][2], 0);
+        lv_obj_set_style_shadow_width(card, params[i][3], 0);
+        lv_obj_set_style_shadow_spread(card, i % 3, 0);
+        lv_obj_set_style_shadow_offset_y(card, 5, 0);
+        lv_obj_set_style_shadow_opa(card, LV_OPA_70, 0);
+        lv_obj_set_style_border_width(card, 0, 0);
+
+        /*Mask out part of the shadow under the card too*/
+        if(i % 2) lv_obj_set_style_bg_opa(card, LV_OPA_50, 0);
+    }
+}
+
+static void redraw(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+}
+
+void test_draw_sw_cache_same_as_without_cache(void)
+{
+    create_cards();
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+
+    set_cache_sizes(0, 0);
+    redraw();
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_hit_count(shadow_cache));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_miss_count(shadow_cache));
+
+    set_cache_sizes(64 * 1024, 16);
+
+    /*Fill the caches*/
+    redraw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+    uint32_t shadow_miss = lv_cache_get_miss_count(shadow_cache);
+    uint32_t circle_miss = lv_cache_get_miss_count(circle_cache);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, shadow_miss);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, circle_miss);
+
+    /*Draw from the caches*/
+    uint32_t shadow_hit = lv_cache_get_hit_count(shadow_cache);
+    uint32_t circle_hit = lv_cache_get_hit_count(circle_cache);
+    redraw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+    TEST_ASSERT_EQUAL_UINT32(shadow_miss, lv_cache_get_miss_count(shadow_cache));
+    TEST_ASSERT_EQUAL_UINT32(circle_miss, lv_cache_get_miss_count(circle_cache));
+    TEST_ASSERT_GREATER_THAN_UINT32(shadow_hit, lv_cache_get_hit_count(shadow_cache));
+    TEST_ASSERT_GREATER_THAN_UINT32(circle_hit, lv_cache_get_hit_count(circle_cache));
+}
+
+void test_draw_sw_cache_small_budget(void)
+{
+    create_cards();
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+
+    set_cache_sizes(0, 0);
+    redraw();
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    /*Only some of the corners fit, the others are evicted or calculated without caching*/
+    set_cache_sizes(2 * 40 * 40, 1);
+    redraw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+    redraw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * 40 * 40, lv_cache_get_size(shadow_cache, NULL));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, lv_cache_get_size(circle_cache, NULL));
+}
+
+static uint32_t bench_redraw(void)
+{
+    clock_t t = clock();
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        redraw();
+    }
+    t = clock() - t;
+
+    return (uint32_t)((uint64_t)t * 1000000 / CLOCKS_PER_SEC / 20);
+}
+
+void test_draw_sw_cache_bench(void)
+{
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs*/
+    create_cards();
+
+    set_cache_sizes(0, 0);
+    uint32_t no_cache_us = bench_redraw();
+
+    set_cache_sizes(64 * 1024, 16);
+    uint32_t cache_us = bench_redraw();
+
+    TEST_PRINTF("Cards with shadows: %d us per frame without cache, %d us with cache",
+                (int)no_cache_us, (int)cache_us);
+}
+
+/**
+ * Create arcs with a few different sizes, widths and angles.
+ * Some of them are partially out of the screen to draw only a part of them.
+ */
+static void create_arcs(void)
+{
+    static const int32_t params[][6] = {
+        /*x, y, size, width, start angle, end angle*/
+        {10, 10, 150, 20, 0, 90},
+        {180, 10, 150, 20, 45, 300},
+        {350, 10, 150, 8, 350, 10},
+        {520, 10, 101, 50, 100, 260},
+        {690, 10, 51, 30, 200, 199},
+        {10, 200, 33, 5, 10, 350},
+        {100, 200, 300, 40, 123, 321},
+        {450, 200, 200, 100, 270, 180},
+        {700, 350, 200, 30, 30, 220},
+        {-50, 400, 150, 25, 0, 360},
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+        lv_obj_t * arc = lv_arc_create(lv_screen_active());
+        lv_obj_remove_style_all(arc);
+        lv_obj_set_pos(arc, params[i][0], params[i][1]);
+        lv_obj_set_size(arc, params[i][2], params[i][2]);
+        lv_obj_set_style_arc_width(arc, params[i][3], LV_PART_INDICATOR);
+        lv_obj_set_style_arc_color(arc, lv_palette_main(LV_PALETTE_BLUE), LV_PART_INDICATOR);
+        lv_obj_set_style_arc_opa(arc, LV_OPA_COVER, LV_PART_INDICATOR);
+        lv_obj_set_style_arc_rounded(arc, i % 2, LV_PART_INDICATOR);
+        lv_arc_set_bg_angles(arc, 0, 360);
+        lv_arc_set_angles(arc, params[i][4], params[i][5]);
+    }
+}
+
+static void rotate_arcs(int32_t delta)
+{
+    lv_obj_t * scr = lv_screen_active();
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_count(scr); i++) {
+        lv_obj_t * arc = lv_obj_get_child(scr, i);
+        int32_t start = (int32_t)(lv_arc_get_angle_start(arc) + delta) % 360;
+        int32_t end = (int32_t)(lv_arc_get_angle_end(arc) + delta) % 360;
+        lv_arc_set_angles(arc, start, end);
+    }
+}
+
+void test_draw_sw_cache_arc_same_as_without_cache(void)
+{
+    create_arcs();
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        set_arc_cache_size(0);
+        redraw();
+        lv_memcpy(ref_buf, buf->data, buf->data_size);
+        TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_miss_count(arc_cache));
+
+        set_arc_cache_size(1024 * 1024);
+        redraw();
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, lv_cache_get_miss_count(arc_cache));
+
+        /*Drawn from the cache*/
+        redraw();
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, lv_cache_get_hit_count(arc_cache));
+
+        rotate_arcs(37);
+    }
+}
+
+void test_draw_sw_cache_arc_too_large(void)
+{
+    create_arcs();
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+
+    set_arc_cache_size(0);
+    redraw();
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    /*Only the small arcs fit*/
+    set_arc_cache_size(50 * 50);
+    redraw();
+    redraw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(50 * 50, lv_cache_get_size(arc_cache, NULL));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_cache_get_hit_count(arc_cache));
+}
+
+static uint32_t bench_rotate_arcs(void)
+{
+    clock_t t = clock();
+    uint32_t i;
+    for(i = 0; i < 60; i++) {
+        rotate_arcs(3);
+        lv_refr_now(NULL);
+    }
+    t = clock() - t;
+
+    return (uint32_t)((uint64_t)t * 1000000 / CLOCKS_PER_SEC / 60);
+}
+
+void test_draw_sw_cache_arc_bench(void)
+{
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs*/
+    create_arcs();
+    lv_refr_now(NULL);
+
+    set_arc_cache_size(0);
+    uint32_t no_cache_us = bench_rotate_arcs();
+
+    set_arc_cache_size(1024 * 1024);
+    uint32_t cache_us = bench_rotate_arcs();
+
+    TEST_PRINTF("Rotating arcs, 3 degrees per frame: %d us per frame without cache, %d us with cache",
+                (int)no_cache_us, (int)cache_us);
+}
+
+#endif
\ No newline at end of file
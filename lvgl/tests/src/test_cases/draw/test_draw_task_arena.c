@@ -0,0 +1,92 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static void create_ui(void)
+{
+    uint32_t i;
+    for(i = 0; i < 60; i++) {
+        lv_obj_t * btn = lv_button_create(lv_screen_active());
+        lv_obj_set_pos(btn, (i % 10) * 78, (i / 10) * 78);
+        lv_obj_set_size(btn, 70, 70);
+        lv_obj_set_style_shadow_width(btn, 10, 0);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%d", (int)i);
+        lv_obj_center(label);
+    }
+
+    /*Child layers have their own arenas*/
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 200, 100);
+    lv_obj_set_style_opa(obj, LV_OPA_50, 0);
+    lv_obj_set_style_transform_rotation(obj, 150, 0);
+    lv_label_set_text(lv_label_create(obj), "Layer");
+}
+
+void test_draw_task_arena_steady_frames_do_not_allocate(void)
+{
+    create_ui();
+
+    /*The first frame fills the pool*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_task_arena_info_t info1;
+    lv_draw_get_task_arena_info(&info1);
+    TEST_ASSERT_GREATER_THAN(0, info1.chunk_cnt);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+
+    lv_draw_task_arena_info_t info2;
+    lv_draw_get_task_arena_info(&info2);
+    TEST_ASSERT_GREATER_THAN(info1.task_cnt, info2.task_cnt);
+    TEST_ASSERT_EQUAL(info1.chunk_alloc_cnt, info2.chunk_alloc_cnt);
+    TEST_ASSERT_EQUAL(info1.fallback_cnt, info2.fallback_cnt);
+    TEST_ASSERT_EQUAL(info1.chunk_cnt, info2.chunk_cnt);
+}
+
+void test_draw_task_arena_canvas_layer(void)
+{
+    LV_DRAW_BUF_DEFINE_STATIC(buf, 100, 100, LV_COLOR_FORMAT_ARGB8888);
+    LV_DRAW_BUF_INIT_STATIC(buf);
+
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &buf);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    lv_area_t a = {10, 10, 50, 50};
+    uint32_t i;
+    for(i = 0; i < 100; i++) lv_draw_rect(&layer, &dsc, &a);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    /*All chunks of the layer are given back when it's drained*/
+    TEST_ASSERT_NULL(layer.task_arena);
+}
+
+#endif /*LV_DRAW_TASK_ARENA_SIZE > 0*/
+
+#endif
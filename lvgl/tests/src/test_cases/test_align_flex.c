@@ -3,6 +3,7 @@
 #include "../../lvgl_private.h"
 
 #include "unity/unity.h"
+#include <time.h>
 
 static lv_obj_t * active_screen = NULL;
 
@@ -170,5 +171,53 @@ void test_flex_hide_items(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("flex_hide_items.png");
 }
 
+void test_flex_incremental_layout(void)
+{
+    lv_obj_t * list = lv_obj_create(active_screen);
+    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    simple_style(list);
+    lv_obj_set_style_pad_row(list, 0, LV_PART_MAIN);
+
+    uint32_t i;
+    for(i = 0; i < 1200; i++) {
+        lv_obj_t * btn = lv_button_create(list);
+        lv_obj_set_size(btn, LV_PCT(100), 40);
+        lv_label_set_text_fmt(lv_label_create(btn), "Item %d", (int)i);
+    }
+    lv_obj_update_layout(list);
+
+    lv_obj_t * item = lv_obj_get_child(list, 600);
+    lv_obj_t * next = lv_obj_get_child(list, 601);
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(list, 1100), 0);
+
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs*/
+    clock_t t_resize = clock();
+    for(i = 0; i < 100; i++) {
+        lv_obj_set_height(item, 40 + (i & 1) * 10);
+        lv_obj_update_layout(list);
+        TEST_ASSERT_EQUAL_INT32(item->coords.y2 + 1, next->coords.y1);
+    }
+    t_resize = clock() - t_resize;
+
+    /*Only the label's subtree should be visited if nothing else is dirty*/
+    clock_t t_leaf = clock();
+    for(i = 0; i < 100; i++) {
+        lv_obj_mark_layout_as_dirty(label);
+        lv_obj_update_layout(list);
+        TEST_ASSERT_FALSE(active_screen->subtree_layout_inv);
+    }
+    t_leaf = clock() - t_leaf;
+
+    TEST_PRINTF("%d children, update layout: %ld us after resizing an item / %ld us after marking a label",
+                (int)lv_obj_get_child_count(list),
+                (long)(t_resize * 1000000 / CLOCKS_PER_SEC / 100), (long)(t_leaf * 1000000 / CLOCKS_PER_SEC / 100));
+
+    /*The last item is still placed correctly*/
+    lv_obj_t * last = lv_obj_get_child(list, -1);
+    lv_obj_t * first = lv_obj_get_child(list, 0);
+    TEST_ASSERT_EQUAL_INT32(first->coords.y1 + 600 * 40 + 50 + 598 * 40, last->coords.y1);
+}
+
 
 #endif
@@ -3,6 +3,7 @@
 #include "../../lvgl_private.h"
 
 #include "unity/unity.h"
+#include <time.h>
 
 
 void setUp(void)
@@ -193,4 +194,122 @@ void test_scroll_anim_delete(void)
     TEST_ASSERT_EQUAL(1, var);
 }
 
+static uint32_t completed_cnt;
+
+static void completed_cnt_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    completed_cnt++;
+}
+
+static void completed_delete_other_cb(lv_anim_t * a)
+{
+    completed_cnt++;
+    lv_anim_delete(lv_anim_get_user_data(a), exec_cb);
+}
+
+static int32_t expected_bezier_value(const lv_anim_t * a, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    int32_t t = lv_map(a->act_time, 0, a->duration, 0, LV_BEZIER_VAL_MAX);
+    int32_t step = lv_cubic_bezier(t, x1, y1, x2, y2);
+    return ((step * (a->end_value - a->start_value)) >> LV_BEZIER_VAL_SHIFT) + a->start_value;
+}
+
+void test_anim_path_ease_values(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, -200, 1000);
+    lv_anim_set_duration(&a, 777);
+
+    /*The result must be the same with or without the lookup tables*/
+    for(a.act_time = 0; a.act_time <= (int32_t)a.duration; a.act_time++) {
+        TEST_ASSERT_EQUAL_INT32(expected_bezier_value(&a, LV_BEZIER_VAL_FLOAT(0.42), 0, LV_BEZIER_VAL_MAX, LV_BEZIER_VAL_MAX),
+                                lv_anim_path_ease_in(&a));
+        TEST_ASSERT_EQUAL_INT32(expected_bezier_value(&a, 0, 0, LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_MAX),
+                                lv_anim_path_ease_out(&a));
+        TEST_ASSERT_EQUAL_INT32(expected_bezier_value(&a, LV_BEZIER_VAL_FLOAT(0.42), 0, LV_BEZIER_VAL_FLOAT(0.58),
+                                                      LV_BEZIER_VAL_MAX),
+                                lv_anim_path_ease_in_out(&a));
+        TEST_ASSERT_EQUAL_INT32(expected_bezier_value(&a, 341, 0, 683, 1300), lv_anim_path_overshoot(&a));
+    }
+}
+
+void test_anim_many_complete_in_same_round(void)
+{
+    static int32_t vars[300];
+    completed_cnt = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_set_completed_cb(&a, completed_cnt_cb);
+
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        lv_anim_set_var(&a, &vars[i]);
+        /*Every 10th animation deletes an other one in its completed callback.
+         *The animations are started at the head, so the other one has already completed by then.*/
+        if(i % 10 == 0) {
+            lv_anim_set_completed_cb(&a, completed_delete_other_cb);
+            lv_anim_set_user_data(&a, &vars[i + 1]);
+        }
+        else {
+            lv_anim_set_completed_cb(&a, completed_cnt_cb);
+        }
+        lv_anim_start(&a);
+    }
+    TEST_ASSERT_EQUAL_UINT16(300, lv_anim_count_running());
+
+    lv_tick_inc(150);
+    lv_anim_refr_now();
+
+    TEST_ASSERT_EQUAL_UINT16(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL_UINT32(300, completed_cnt);
+    for(i = 0; i < 300; i++) {
+        TEST_ASSERT_EQUAL_INT32(100, vars[i]);
+    }
+}
+
+void test_anim_bench_500_anims(void)
+{
+    static int32_t vars[500];
+    static const lv_anim_path_cb_t paths[5] = {
+        lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out,
+        lv_anim_path_ease_in_out, lv_anim_path_overshoot
+    };
+
+    uint32_t i;
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, 1000);
+    lv_anim_set_values(&a, 0, 1000);
+    for(i = 0; i < 500; i++) {
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_set_path_cb(&a, paths[i % 5]);
+        lv_anim_start(&a);
+    }
+    TEST_ASSERT_EQUAL_UINT16(500, lv_anim_count_running());
+
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs*/
+    uint32_t steps = 0;
+    clock_t t = clock();
+    while(lv_anim_count_running()) {
+        lv_tick_inc(2);
+        lv_anim_refr_now();
+        steps++;
+    }
+    t = clock() - t;
+
+    TEST_PRINTF("500 animations: %ld us per animation step (%d steps)",
+                (long)(t * 1000000 / CLOCKS_PER_SEC / steps), (int)steps);
+
+    for(i = 0; i < 500; i++) {
+        TEST_ASSERT_EQUAL_INT32(1000, vars[i]);
+    }
+}
+
 #endif
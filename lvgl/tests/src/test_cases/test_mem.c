@@ -4,6 +4,17 @@
 
 #include "unity/unity.h"
 
+#if LV_USE_MEM_SLAB
+    #include <time.h>
+#endif
+
+/*The allocations are larger by the header of the tag*/
+#if LV_USE_MEM_TAGS
+    #define TAG_HEADER_SIZE sizeof(lv_mem_tag_header_t)
+#else
+    #define TAG_HEADER_SIZE 0
+#endif
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -50,4 +61,299 @@ void test_memcpy_unaligned(void)
     }
 }
 
+#if LV_USE_MEM_SLAB
+
+void test_mem_slab_reuse(void)
+{
+    void * p1 = lv_malloc(24);
+    void * p2 = lv_malloc(LV_MEM_SLAB_MAX_SIZE - TAG_HEADER_SIZE);
+    void * p3 = lv_malloc(LV_MEM_SLAB_MAX_SIZE + 1);
+    TEST_ASSERT_NOT_NULL(p1);
+    TEST_ASSERT_NOT_NULL(p2);
+    TEST_ASSERT_NOT_NULL(p3);
+    TEST_ASSERT_TRUE(lv_mem_slab_is_owned(p1));
+    TEST_ASSERT_TRUE(lv_mem_slab_is_owned(p2));
+    TEST_ASSERT_FALSE(lv_mem_slab_is_owned(p3));
+
+    lv_memset(p1, 0x11, 24);
+    lv_memset(p2, 0x22, LV_MEM_SLAB_MAX_SIZE - TAG_HEADER_SIZE);
+
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_GREATER_OR_EQUAL(24 + LV_MEM_SLAB_MAX_SIZE - TAG_HEADER_SIZE, mon2.slab_used_size);
+    TEST_ASSERT_LESS_OR_EQUAL(mon2.slab_assigned_size, mon2.slab_used_size);
+    TEST_ASSERT_LESS_OR_EQUAL(mon2.slab_total_size, mon2.slab_assigned_size);
+
+    /*A freed block is handed out again for the same size class*/
+    lv_free(p1);
+    void * p4 = lv_malloc(20);
+    TEST_ASSERT_EQUAL_PTR(p1, p4);
+
+    lv_free(p2);
+    lv_free(p3);
+    lv_free(p4);
+
+    /*The blocks might stay in the cache of this thread, so they can't be considered free yet*/
+    lv_mem_monitor_t mon3;
+    lv_mem_monitor(&mon3);
+    TEST_ASSERT_LESS_OR_EQUAL(mon2.slab_used_size, mon3.slab_used_size);
+}
+
+void test_mem_slab_realloc(void)
+{
+    uint8_t * p = lv_malloc(10);
+    uint32_t i;
+    for(i = 0; i < 10; i++) p[i] = (uint8_t)i;
+
+    /*Within the same size class*/
+    TEST_ASSERT_EQUAL_PTR(p, lv_realloc(p, 12));
+
+    /*To a larger size class*/
+    p = lv_realloc(p, 100);
+    TEST_ASSERT_TRUE(lv_mem_slab_is_owned(p));
+    for(i = 0; i < 10; i++) TEST_ASSERT_EQUAL_UINT8(i, p[i]);
+
+    /*Out of the slabs*/
+    p = lv_realloc(p, LV_MEM_SLAB_MAX_SIZE * 4);
+    TEST_ASSERT_FALSE(lv_mem_slab_is_owned(p));
+    for(i = 0; i < 10; i++) TEST_ASSERT_EQUAL_UINT8(i, p[i]);
+
+    /*Back to the slabs*/
+    p = lv_realloc(p, 8);
+    for(i = 0; i < 8; i++) TEST_ASSERT_EQUAL_UINT8(i, p[i]);
+
+    lv_free(p);
+}
+
+void test_mem_slab_class_info(void)
+{
+    uint32_t cnt = lv_mem_slab_get_class_count();
+    TEST_ASSERT_GREATER_THAN(0, cnt);
+
+    lv_mem_slab_class_info_t info;
+    lv_mem_slab_get_class_info(cnt - 1, &info);
+    TEST_ASSERT_GREATER_OR_EQUAL(LV_MEM_SLAB_MAX_SIZE, info.block_size);
+
+    void * p = lv_malloc(info.block_size - TAG_HEADER_SIZE);
+    lv_mem_slab_get_class_info(cnt - 1, &info);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, info.used_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, info.chunk_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(info.used_cnt, info.max_used_cnt);
+    lv_free(p);
+}
+
+void test_mem_slab_exhaust(void)
+{
+    /*Allocate more than the arena can hold, the rest has to come from the allocator*/
+    uint32_t cnt = LV_MEM_SLAB_SIZE / 64 + 16;
+    void ** ptrs = lv_malloc(cnt * sizeof(void *));
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        ptrs[i] = lv_malloc(64);
+        TEST_ASSERT_NOT_NULL(ptrs[i]);
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.slab_fallback_cnt);
+    TEST_ASSERT_FALSE(lv_mem_slab_is_owned(ptrs[cnt - 1]));
+
+    for(i = 0; i < cnt; i++) lv_free(ptrs[i]);
+    lv_free(ptrs);
+
+    /*The empty chunks can be used by other classes again*/
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_LESS_THAN(mon.slab_total_size / 2, mon.slab_assigned_size);
+}
+
+/*Not a real benchmark, just to see the order of magnitude of the gain in the test logs*/
+void test_mem_slab_create_delete_bench(void)
+{
+    /*Sizes of a typical widget creation: object, spec_attr, event descriptors, style arrays*/
+    static const size_t sizes[] = {96, 64, 24, 24, 16, 32, 48, 120, 24, 40};
+    const uint32_t size_cnt = sizeof(sizes) / sizeof(sizes[0]);
+    const uint32_t obj_cnt = 200;
+    static void * ptrs[200 * 10];
+    uint32_t round;
+    uint32_t i;
+
+    /*Call the same functions as `lv_malloc()` and `lv_free()` but without the logging overhead of the tests*/
+    clock_t t_slab = clock();
+    for(round = 0; round < 50; round++) {
+        for(i = 0; i < obj_cnt * size_cnt; i++) {
+            ptrs[i] = lv_mem_slab_alloc(sizes[i % size_cnt]);
+            if(ptrs[i] == NULL) ptrs[i] = lv_malloc_core(sizes[i % size_cnt]);
+        }
+        for(i = 0; i < obj_cnt * size_cnt; i++) {
+            if(!lv_mem_slab_free(ptrs[i])) lv_free_core(ptrs[i]);
+        }
+    }
+    t_slab = clock() - t_slab;
+
+    clock_t t_core = clock();
+    for(round = 0; round < 50; round++) {
+        for(i = 0; i < obj_cnt * size_cnt; i++) ptrs[i] = lv_malloc_core(sizes[i % size_cnt]);
+        for(i = 0; i < obj_cnt * size_cnt; i++) lv_free_core(ptrs[i]);
+    }
+    t_core = clock() - t_core;
+
+    clock_t t_obj = clock();
+    for(round = 0; round < 5; round++) {
+        lv_obj_t * cont = lv_obj_create(lv_screen_active());
+        for(i = 0; i < 200; i++) {
+            lv_obj_t * btn = lv_button_create(cont);
+            lv_label_set_text(lv_label_create(btn), "Button");
+        }
+        lv_obj_delete(cont);
+    }
+    t_obj = clock() - t_obj;
+
+    TEST_PRINTF("slab: %ld us, allocator: %ld us, 1000 buttons create/delete: %ld us",
+                (long)(t_slab * 1000000 / CLOCKS_PER_SEC), (long)(t_core * 1000000 / CLOCKS_PER_SEC),
+                (long)(t_obj * 1000000 / CLOCKS_PER_SEC));
+}
+
+#endif /*LV_USE_MEM_SLAB*/
+
+#if LV_USE_MEM_TAGS
+
+void test_mem_tags_alloc_free(void)
+{
+    lv_mem_tag_info_t info;
+    lv_mem_tag_reset_peak();
+
+    uint8_t * p = lv_malloc_tagged(100, LV_MEM_TAG_USER);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL(LV_MEM_TAG_USER, lv_mem_tag_get(p));
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_size_t(100, info.size);
+    TEST_ASSERT_EQUAL_UINT32(1, info.cnt);
+
+    /*The tag and the content are kept on realloc*/
+    lv_memset(p, 0x5a, 100);
+    p = lv_realloc(p, 300);
+    TEST_ASSERT_EQUAL(LV_MEM_TAG_USER, lv_mem_tag_get(p));
+    TEST_ASSERT_EACH_EQUAL_UINT8(0x5a, p, 100);
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_size_t(300, info.size);
+    TEST_ASSERT_EQUAL_size_t(300, info.peak_size);
+    TEST_ASSERT_EQUAL_UINT32(1, info.cnt);
+
+    p = lv_realloc(p, 20);
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_size_t(20, info.size);
+    TEST_ASSERT_EQUAL_size_t(300, info.peak_size);
+
+    lv_free(p);
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_size_t(0, info.size);
+    TEST_ASSERT_EQUAL_UINT32(0, info.cnt);
+    TEST_ASSERT_EQUAL_size_t(300, info.peak_size);
+
+    lv_mem_tag_reset_peak();
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_size_t(0, info.peak_size);
+
+    /*Zero sized allocations are not counted*/
+    p = lv_malloc_tagged(0, LV_MEM_TAG_USER);
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_UINT32(0, info.cnt);
+    lv_free(p);
+}
+
+void test_mem_tags_file_tag(void)
+{
+    /*This file doesn't select a tag*/
+    void * p1 = lv_malloc(10);
+    void * p2 = lv_zalloc(10);
+    void * p3 = lv_calloc(2, 10);
+    void * p4 = lv_realloc(NULL, 10);
+    TEST_ASSERT_EQUAL(LV_MEM_TAG_OTHER, lv_mem_tag_get(p1));
+    TEST_ASSERT_EQUAL(LV_MEM_TAG_OTHER, lv_mem_tag_get(p2));
+    TEST_ASSERT_EQUAL(LV_MEM_TAG_OTHER, lv_mem_tag_get(p3));
+    TEST_ASSERT_EQUAL(LV_MEM_TAG_OTHER, lv_mem_tag_get(p4));
+
+    /*Move the memory to an other tag*/
+    lv_mem_tag_info_t info;
+    lv_mem_tag_set(p3, LV_MEM_TAG_USER);
+    TEST_ASSERT_EQUAL(LV_MEM_TAG_USER, lv_mem_tag_get(p3));
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_size_t(20, info.size);
+
+    lv_free(p1);
+    lv_free(p2);
+    lv_free(p3);
+    lv_free(p4);
+    lv_mem_tag_get_info(LV_MEM_TAG_USER, &info);
+    TEST_ASSERT_EQUAL_size_t(0, info.size);
+
+    TEST_ASSERT_EQUAL_STRING("layer", lv_mem_tag_get_name(LV_MEM_TAG_LAYER));
+}
+
+void test_mem_tags_snapshot(void)
+{
+    lv_mem_tag_snapshot_t before;
+    lv_mem_tag_snapshot_t after;
+    lv_mem_tag_diff_t diff;
+
+    lv_mem_tag_take_snapshot(&before);
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_set_text(label, "Some text");
+    lv_obj_set_style_text_color(label, lv_color_hex(0xff0000), 0);
+
+    lv_mem_tag_take_snapshot(&after);
+    lv_mem_tag_log_diff(&before, &after);
+    lv_mem_tag_snapshot_diff(&before, &after, &diff);
+    TEST_ASSERT_GREATER_THAN(0, diff.size[LV_MEM_TAG_OBJ]);
+    TEST_ASSERT_GREATER_THAN(0, diff.cnt[LV_MEM_TAG_OBJ]);
+    TEST_ASSERT_GREATER_THAN(0, diff.size[LV_MEM_TAG_STYLE]);
+    TEST_ASSERT_EQUAL(0, diff.size[LV_MEM_TAG_LAYER]);
+    TEST_ASSERT_EQUAL((intptr_t)(after.total.size - before.total.size), diff.total_size);
+
+    /*Everything is freed*/
+    lv_obj_delete(label);
+    lv_mem_tag_take_snapshot(&after);
+    lv_mem_tag_snapshot_diff(&before, &after, &diff);
+    TEST_ASSERT_EQUAL(0, diff.size[LV_MEM_TAG_OBJ]);
+    TEST_ASSERT_EQUAL(0, diff.cnt[LV_MEM_TAG_OBJ]);
+    TEST_ASSERT_EQUAL(0, diff.size[LV_MEM_TAG_STYLE]);
+}
+
+void test_mem_tags_layer_and_image(void)
+{
+    lv_mem_tag_info_t info;
+
+    /*A semi-transparent layer*/
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(parent, 200, 100);
+    lv_obj_set_style_opa_layered(parent, LV_OPA_50, 0);
+    lv_obj_create(parent);
+
+    lv_mem_tag_reset_peak();
+    lv_refr_now(NULL);
+    lv_mem_tag_get_info(LV_MEM_TAG_LAYER, &info);
+    TEST_ASSERT_EQUAL_size_t(0, info.size);
+    TEST_ASSERT_GREATER_THAN(0, info.peak_size);
+
+    lv_image_cache_drop(NULL);
+    lv_mem_tag_info_t info_ori;
+    lv_mem_tag_get_info(LV_MEM_TAG_IMAGE, &info_ori);
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, "A:src/test_assets/test_img_lvgl_logo.png");
+    lv_refr_now(NULL);
+
+    /*The decoded image stays in the cache*/
+    lv_mem_tag_get_info(LV_MEM_TAG_IMAGE, &info);
+    TEST_ASSERT_GREATER_OR_EQUAL(info_ori.size + 105 * 40 * 4, info.size);
+
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(NULL);
+    lv_mem_tag_get_info(LV_MEM_TAG_IMAGE, &info);
+    TEST_ASSERT_EQUAL_size_t(info_ori.size, info.size);
+}
+
+#endif /*LV_USE_MEM_TAGS*/
+
 #endif
@@ -0,0 +1,312 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static uint8_t * ref_buf;
+
+void setUp(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    ref_buf = lv_malloc(buf->data_size);
+    TEST_ASSERT_NOT_NULL(ref_buf);
+}
+
+void tearDown(void)
+{
+    lv_free(ref_buf);
+    lv_obj_clean(lv_screen_active());
+    lv_obj_clean(lv_layer_top());
+}
+
+static lv_obj_t * create_button(lv_obj_t * parent, int32_t x, int32_t y)
+{
+    lv_obj_t * btn = lv_button_create(parent);
+    lv_obj_set_pos(btn, x, y);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Hidden");
+    return btn;
+}
+
+static lv_obj_t * create_panel(lv_obj_t * parent, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    lv_obj_t * panel = lv_obj_create(parent);
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_radius(panel, 0, 0);
+    lv_obj_set_style_border_width(panel, 0, 0);
+    lv_obj_set_pos(panel, x, y);
+    lv_obj_set_size(panel, w, h);
+    return panel;
+}
+
+/**
+ * Refresh the whole screen and check how many Widgets were culled.
+ * Then hide the Widgets which should be culled and check that the result is the same.
+ * @param obj_cnt   number of the expected culled Widgets
+ * @param objs      the expected culled Widgets
+ */
+static void check_culled(uint32_t obj_cnt, lv_obj_t * objs[])
+{
+    lv_refr_reset_occlusion_stats(NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_refr_occlusion_stats_t stats;
+    lv_refr_get_occlusion_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL(obj_cnt, stats.culled_obj_cnt);
+    TEST_ASSERT_EQUAL(800 * 480, stats.rendered_px);
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    uint32_t i;
+    for(i = 0; i < obj_cnt; i++) lv_obj_add_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    for(i = 0; i < obj_cnt; i++) lv_obj_remove_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+}
+
+void test_occlusion_culling_siblings(void)
+{
+    lv_obj_t * btn1 = create_button(lv_screen_active(), 100, 100);
+    lv_obj_t * btn2 = create_button(lv_screen_active(), 150, 300);
+    lv_obj_t * btn3 = create_button(lv_screen_active(), 500, 100);
+    LV_UNUSED(btn3);
+    create_panel(lv_screen_active(), 50, 50, 300, 400);
+
+    lv_obj_t * culled[] = {btn1, btn2};
+    check_culled(2, culled);
+}
+
+void test_occlusion_culling_nested(void)
+{
+    /*Covered by the child of a younger sibling of the parent*/
+    lv_obj_t * cont = create_panel(lv_screen_active(), 20, 20, 400, 300);
+    lv_obj_t * btn = create_button(cont, 20, 20);
+    lv_obj_t * panel = create_panel(lv_screen_active(), 0, 0, 800, 480);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_TRANSP, 0);
+    create_panel(panel, 0, 0, 200, 200);
+
+    lv_obj_t * culled[] = {btn};
+    check_culled(1, culled);
+
+    /*A child never hides its parent, only the older siblings*/
+    lv_obj_delete(panel);
+    lv_obj_t * label = lv_obj_get_child(btn, 0);
+    lv_obj_t * child = create_panel(btn, 0, 0, 300, 300);
+    lv_obj_set_style_pad_all(btn, 0, 0);
+    lv_obj_t * culled_label[] = {label};
+    check_culled(1, culled_label);
+
+    lv_obj_delete(child);
+    lv_obj_t * btn2 = create_button(cont, 40, 40);
+    create_panel(cont, 0, 0, 300, 200);
+    lv_obj_t * culled2[] = {btn, btn2};
+    check_culled(2, culled2);
+}
+
+void test_occlusion_culling_top_layer(void)
+{
+    lv_obj_t * btn = create_button(lv_screen_active(), 100, 100);
+    create_panel(lv_layer_top(), 50, 50, 300, 300);
+
+    lv_obj_t * culled[] = {btn};
+    check_culled(1, culled);
+}
+
+void test_occlusion_culling_rounded(void)
+{
+    create_button(lv_screen_active(), 100, 40);
+    lv_obj_t * btn = create_button(lv_screen_active(), 100, 120);
+    lv_obj_t * panel = create_panel(lv_screen_active(), 50, 30, 300, 200);
+    lv_obj_set_style_radius(panel, 40, 0);
+
+    /*Only the band between the rounded corners covers*/
+    lv_obj_t * culled[] = {btn};
+    check_culled(1, culled);
+
+    /*The children of a Widget with clipped corners are covering in the middle*/
+    lv_obj_set_style_bg_opa(panel, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_clip_corner(panel, true, 0);
+    create_panel(panel, -50, -50, 400, 300);
+    check_culled(1, culled);
+
+    /*Not even the middle is covered with a large radius*/
+    lv_obj_set_style_radius(panel, LV_RADIUS_CIRCLE, 0);
+    check_culled(0, NULL);
+}
+
+void test_occlusion_culling_not_covering(void)
+{
+    create_button(lv_screen_active(), 100, 100);
+    lv_obj_t * panel = create_panel(lv_screen_active(), 50, 50, 300, 300);
+
+    /*Semi transparent*/
+    lv_obj_set_style_bg_opa(panel, LV_OPA_90, 0);
+    check_culled(0, NULL);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, 0);
+
+    lv_obj_set_style_opa(panel, LV_OPA_90, 0);
+    check_culled(0, NULL);
+    lv_obj_set_style_opa(panel, LV_OPA_COVER, 0);
+
+    lv_obj_set_style_opa_layered(panel, LV_OPA_90, 0);
+    check_culled(0, NULL);
+    lv_obj_set_style_opa_layered(panel, LV_OPA_COVER, 0);
+
+    /*Transformed*/
+    lv_obj_set_style_transform_rotation(panel, 10, 0);
+    check_culled(0, NULL);
+    lv_obj_set_style_transform_rotation(panel, 0, 0);
+
+    /*Below the button*/
+    lv_obj_move_to_index(panel, 0);
+    check_culled(0, NULL);
+
+    /*Partially covering*/
+    lv_obj_move_to_index(panel, -1);
+    lv_obj_set_x(panel, 120);
+    check_culled(0, NULL);
+}
+
+void test_occlusion_culling_transformed(void)
+{
+    /*The transformed area of the Widget is checked*/
+    lv_obj_t * btn = create_button(lv_screen_active(), 100, 100);
+    lv_obj_set_style_transform_scale(btn, 512, 0);
+    lv_obj_t * small_panel = create_panel(lv_screen_active(), 50, 50, 180, 180);
+    check_culled(0, NULL);
+
+    lv_obj_delete(small_panel);
+    lv_obj_t * panel = create_panel(lv_screen_active(), 0, 0, 400, 400);
+    lv_obj_t * culled[] = {btn};
+    check_culled(1, culled);
+
+    /*Widgets in a transformed parent are not culled*/
+    lv_obj_t * cont = create_panel(lv_screen_active(), 0, 0, 400, 400);
+    lv_obj_set_style_transform_rotation(cont, 900, 0);
+    lv_obj_set_style_transform_pivot_x(cont, 200, 0);
+    lv_obj_set_style_transform_pivot_y(cont, 200, 0);
+    create_button(cont, 100, 100);
+    create_panel(cont, 0, 0, 300, 300);
+    lv_obj_move_to_index(panel, -1);
+    lv_obj_set_size(panel, 450, 450);
+    lv_obj_t * culled2[] = {btn, cont};
+    check_culled(2, culled2);
+}
+
+/**
+ * Refresh the whole screen and compare it with a snapshot of the screen (which is not culled)
+ */
+static void check_same_as_snapshot(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_screen_active(), buf->header.cf);
+    TEST_ASSERT_NOT_NULL(snapshot);
+
+    uint32_t y;
+    for(y = 0; y < buf->header.h; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(lv_draw_buf_goto_xy(snapshot, 0, y), lv_draw_buf_goto_xy(buf, 0, y),
+                                 buf->header.w * lv_color_format_get_size(buf->header.cf));
+    }
+
+    lv_draw_buf_destroy(snapshot);
+}
+
+void test_occlusion_culling_clip(void)
+{
+    /*Only the visible part of the items is drawn next to the panel*/
+    lv_obj_t * list = lv_list_create(lv_screen_active());
+    lv_obj_set_size(list, lv_pct(100), lv_pct(100));
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * btn = lv_list_add_button(list, LV_SYMBOL_FILE, "Item");
+        lv_obj_set_style_bg_grad_color(btn, lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_style_bg_grad_dir(btn, LV_GRAD_DIR_HOR, 0);
+    }
+
+    lv_obj_t * panel = create_panel(lv_screen_active(), 0, 0, 300, lv_pct(100));
+    lv_obj_align(panel, LV_ALIGN_RIGHT_MID, 0, 0);
+
+    lv_refr_reset_occlusion_stats(NULL);
+    check_same_as_snapshot();
+    lv_refr_occlusion_stats_t stats;
+    lv_refr_get_occlusion_stats(NULL, &stats);
+    TEST_ASSERT_GREATER_THAN(300 * 400, stats.culled_px);
+
+    /*On the left side*/
+    lv_obj_align(panel, LV_ALIGN_LEFT_MID, 0, 0);
+    check_same_as_snapshot();
+
+    /*Headers on the top and the bottom*/
+    lv_obj_set_size(panel, lv_pct(100), 60);
+    lv_obj_align(panel, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_t * footer = create_panel(lv_screen_active(), 0, 0, lv_pct(100), 50);
+    lv_obj_align(footer, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_obj_scroll_by(list, 0, -25, LV_ANIM_OFF);
+    check_same_as_snapshot();
+
+    /*Nothing is cut from the middle*/
+    lv_obj_set_size(panel, 200, lv_pct(100));
+    lv_obj_center(panel);
+    lv_refr_reset_occlusion_stats(NULL);
+    check_same_as_snapshot();
+    lv_refr_get_occlusion_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL(0, stats.culled_obj_cnt);
+}
+
+static void print_stats(const char * name)
+{
+    lv_refr_reset_occlusion_stats(NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_refr_occlusion_stats_t stats;
+    lv_refr_get_occlusion_stats(NULL, &stats);
+    TEST_PRINTF("%s: %d Widgets culled, %d px not drawn on %d px (%d%%)", name,
+                (int)stats.culled_obj_cnt, (int)stats.culled_px, (int)stats.rendered_px,
+                (int)((uint64_t)stats.culled_px * 100 / stats.rendered_px));
+}
+
+void test_occlusion_culling_stats(void)
+{
+    /*A list partially covered by a side panel*/
+    lv_obj_t * list = lv_list_create(lv_screen_active());
+    lv_obj_set_size(list, lv_pct(100), lv_pct(100));
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_list_add_button(list, LV_SYMBOL_FILE, "Item");
+    }
+
+    lv_obj_t * panel = create_panel(lv_screen_active(), 0, 0, 300, lv_pct(100));
+    lv_obj_align(panel, LV_ALIGN_RIGHT_MID, 0, 0);
+    lv_obj_t * label = lv_label_create(panel);
+    lv_label_set_text(label, "Settings");
+    print_stats("List under a side panel");
+    lv_obj_clean(lv_screen_active());
+
+    /*A deck of cards, only the edges of the lower cards are visible*/
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * card = create_panel(lv_screen_active(), 100 + i * 20, 50 + i * 10, 400, 280);
+        lv_obj_set_style_bg_color(card, lv_palette_main(i % LV_PALETTE_LAST), 0);
+        lv_obj_t * label = lv_label_create(card);
+        lv_label_set_text(label, "Card");
+        create_button(card, 100, 100);
+    }
+    print_stats("Deck of cards");
+    lv_obj_clean(lv_screen_active());
+
+#if LV_USE_DEMO_WIDGETS
+    lv_demo_widgets();
+    print_stats("Widgets demo");
+    lv_obj_clean(lv_screen_active());
+#endif
+}
+
+#endif
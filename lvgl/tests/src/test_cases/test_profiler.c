@@ -4,9 +4,14 @@
 
 #include "unity/unity.h"
 #include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
 
 #define OUTPUT_LINE_MAX 8
 #define OUTPUT_BUF_MAX 128
+#define THREAD_NUM 3
+#define THREAD_EVENT_NUM 1000
+#define TID_MAX LV_PROFILER_BUILTIN_THREAD_MAX
 
 static uint32_t profiler_tick = 0;
 static int output_line = 0;
@@ -26,6 +31,51 @@ static void flush_cb(const char * buf)
     output_line++;
 }
 
+static uint32_t thread_event_cnt[TID_MAX];
+static uint64_t thread_last_ts[TID_MAX];
+static int thread_tid_next;
+static __thread int thread_tid;
+
+static int get_tid_cb(void)
+{
+    if(thread_tid == 0) thread_tid = __atomic_add_fetch(&thread_tid_next, 1, __ATOMIC_RELAXED);
+    return thread_tid;
+}
+
+static uint64_t get_tick_atomic_cb(void)
+{
+    return __atomic_fetch_add(&profiler_tick, 1, __ATOMIC_RELAXED);
+}
+
+static void flush_count_cb(const char * buf)
+{
+    int tid;
+    uint64_t ts;
+    int frac;
+    char ph;
+    const char * p = strstr(buf, "\"ph\":\"");
+    if(p == NULL || p[6] == 'M') return;
+    TEST_ASSERT_EQUAL_INT(4, sscanf(p, "\"ph\":\"%c\",\"ts\":%" SCNu64 ".%d,\"pid\":1,\"tid\":%d", &ph, &ts, &frac, &tid));
+    TEST_ASSERT_TRUE(tid >= 1 && tid <= TID_MAX);
+
+    /*The events of a thread are in order. The LVGL thread of the test can write events too.*/
+    if(thread_last_ts[tid - 1]) TEST_ASSERT_GREATER_THAN_UINT64(thread_last_ts[tid - 1], ts);
+    thread_last_ts[tid - 1] = ts;
+    if(strstr(buf, "\"thread_cb\"")) thread_event_cnt[tid - 1]++;
+}
+
+static void thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_profiler_builtin_set_thread_name("worker");
+
+    uint32_t i;
+    for(i = 0; i < THREAD_EVENT_NUM / 2; i++) {
+        LV_PROFILER_BEGIN;
+        LV_PROFILER_END;
+    }
+}
+
 void setUp(void)
 {
     lv_profiler_builtin_config_t config;
@@ -98,4 +148,122 @@ void test_profiler_disable(void)
     TEST_ASSERT_EQUAL_CHAR(output_buf[4][0], '\0');
 }
 
+void test_profiler_chrome_json(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = 1024;
+    config.tick_per_sec = 1000000000; /* One second is equal to 1000000000 nanoseconds */
+    config.tick_get_cb = get_tick_cb;
+    config.flush_cb = flush_cb;
+    config.format = LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON;
+
+    profiler_tick = 1500;
+    output_line = 0;
+    lv_memzero(output_buf, sizeof(output_buf));
+    lv_profiler_builtin_init(&config);
+
+    LV_PROFILER_BEGIN_TAG("custom_tag");
+    LV_PROFILER_END_TAG("custom_tag");
+    lv_profiler_builtin_flush();
+
+    /* only new events are flushed again */
+    lv_profiler_builtin_flush();
+
+    TEST_ASSERT_EQUAL_INT(output_line, 4);
+    TEST_ASSERT_EQUAL_STRING(output_buf[0], "[\n");
+    TEST_ASSERT_EQUAL_STRING(output_buf[1],
+                             "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"LVGL\"}}\n");
+    TEST_ASSERT_EQUAL_STRING(output_buf[2], ",{\"name\":\"custom_tag\",\"ph\":\"B\",\"ts\":1.500,\"pid\":1,\"tid\":1}\n");
+    TEST_ASSERT_EQUAL_STRING(output_buf[3], ",{\"name\":\"custom_tag\",\"ph\":\"E\",\"ts\":1.501,\"pid\":1,\"tid\":1}\n");
+}
+
+void test_profiler_counter(void)
+{
+    lv_profiler_builtin_set_enable(true);
+
+    profiler_tick = 0;
+    output_line = 0;
+    lv_memzero(output_buf, sizeof(output_buf));
+
+    LV_PROFILER_COUNTER("mem:test", 1234);
+    lv_profiler_builtin_flush();
+
+    TEST_ASSERT_EQUAL_INT(1, output_line);
+    TEST_ASSERT_EQUAL_STRING("   LVGL-1 [0] 0.000000000: tracing_mark_write: C|1|mem:test|1234\n", output_buf[0]);
+
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = 1024;
+    config.tick_per_sec = 1000000000;
+    config.tick_get_cb = get_tick_cb;
+    config.flush_cb = flush_cb;
+    config.format = LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON;
+
+    profiler_tick = 2000;
+    output_line = 0;
+    lv_memzero(output_buf, sizeof(output_buf));
+    lv_profiler_builtin_init(&config);
+
+    LV_PROFILER_COUNTER("mem:test", 42);
+    lv_profiler_builtin_flush();
+
+    TEST_ASSERT_EQUAL_INT(3, output_line);
+    TEST_ASSERT_EQUAL_STRING(",{\"name\":\"mem:test\",\"ph\":\"C\",\"ts\":2.000,\"pid\":1,\"tid\":1,\"args\":{\"value\":42}}\n",
+                             output_buf[2]);
+}
+
+static void test_threads(bool flush_thread)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = 64 * 16; /* A few dozens of events to flush often */
+    config.tick_per_sec = 1000000;
+    config.tick_get_cb = get_tick_atomic_cb;
+    config.tid_get_cb = get_tid_cb;
+    config.flush_cb = flush_count_cb;
+    config.format = LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON;
+    config.flush_thread = flush_thread;
+
+    profiler_tick = 1;
+    thread_tid = 0;
+    thread_tid_next = 0;
+    lv_memzero(thread_event_cnt, sizeof(thread_event_cnt));
+    lv_memzero(thread_last_ts, sizeof(thread_last_ts));
+    lv_profiler_builtin_init(&config);
+
+    lv_thread_t threads[THREAD_NUM];
+    uint32_t i;
+    for(i = 0; i < THREAD_NUM; i++) {
+        lv_thread_init(&threads[i], "worker", LV_THREAD_PRIO_MID, thread_cb, 16 * 1024, NULL);
+    }
+
+    /* events of the main thread in parallel */
+    thread_cb(NULL);
+
+    for(i = 0; i < THREAD_NUM; i++) {
+        lv_thread_delete(&threads[i]);
+    }
+
+    lv_profiler_builtin_flush();
+
+    uint32_t thread_cnt = 0;
+    for(i = 0; i < TID_MAX; i++) {
+        if(thread_event_cnt[i] == 0) continue;
+        TEST_ASSERT_EQUAL_UINT32(THREAD_EVENT_NUM, thread_event_cnt[i]);
+        thread_cnt++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(THREAD_NUM + 1, thread_cnt);
+}
+
+void test_profiler_threads(void)
+{
+    test_threads(false);
+}
+
+void test_profiler_flush_thread(void)
+{
+    test_threads(true);
+}
+
 #endif
@@ -0,0 +1,110 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_OVERDRAW_DEBUG
+
+static lv_obj_t * obj;
+static uint32_t report_cnt;
+static lv_refr_overdraw_stats_t reported;
+
+static void report_cb(lv_display_t * disp, const lv_refr_overdraw_stats_t * stats)
+{
+    TEST_ASSERT_EQUAL_PTR(lv_display_get_default(), disp);
+    reported = *stats;
+    report_cnt++;
+}
+
+void setUp(void)
+{
+    /*Semi transparent so the screen's background is not culled below it*/
+    obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x000000), 0);
+    lv_obj_set_size(obj, 100, 100);
+    lv_obj_set_pos(obj, 10, 20);
+    report_cnt = 0;
+
+    lv_refr_overdraw_enable(NULL, true);
+}
+
+void tearDown(void)
+{
+    lv_refr_overdraw_enable(NULL, false);
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_refr_overdraw_stats(void)
+{
+    lv_refr_overdraw_set_report_cb(NULL, report_cb);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    uint32_t screen_px = lv_display_get_horizontal_resolution(NULL) * lv_display_get_vertical_resolution(NULL);
+    lv_refr_overdraw_stats_t stats;
+    lv_refr_overdraw_get_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, report_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(&stats, &reported, sizeof(stats));
+    TEST_ASSERT_EQUAL_UINT32(screen_px, stats.screen_px);
+    TEST_ASSERT_EQUAL_UINT32(screen_px, stats.invalidated_px);
+    TEST_ASSERT_EQUAL_UINT32(screen_px, stats.drawn_px);
+    TEST_ASSERT_EQUAL_UINT32(100 * 100, stats.overdrawn_px);
+    TEST_ASSERT_EQUAL_UINT32(screen_px + 100 * 100, stats.written_px);
+    TEST_ASSERT_EQUAL_PTR(lv_screen_active(), stats.top[0].obj);
+    TEST_ASSERT_EQUAL_UINT32(screen_px, stats.top[0].written_px);
+    TEST_ASSERT_EQUAL_PTR(obj, stats.top[1].obj);
+    TEST_ASSERT_EQUAL_UINT32(100 * 100, stats.top[1].written_px);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.top[2].written_px);
+
+    /*Only the invalidated area is counted*/
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    lv_refr_overdraw_get_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, report_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats.frame - 1, 1);
+    TEST_ASSERT_EQUAL_UINT32(100 * 100, stats.invalidated_px);
+    TEST_ASSERT_EQUAL_UINT32(100 * 100, stats.drawn_px);
+    TEST_ASSERT_EQUAL_UINT32(2 * 100 * 100, stats.written_px);
+
+    /*Nothing to redraw, no frame*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, report_cnt);
+
+    /*The CSV report works without display*/
+    lv_refr_overdraw_set_report_cb(NULL, lv_refr_overdraw_report_csv);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+}
+
+void test_refr_overdraw_heatmap(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    uint32_t px_in = *(uint32_t *)lv_draw_buf_goto_xy(buf, 50, 50);
+    uint32_t px_out = *(uint32_t *)lv_draw_buf_goto_xy(buf, 200, 200);
+
+    lv_refr_overdraw_set_heatmap(NULL, true);
+    lv_refr_now(NULL);
+
+    /*Only the pixels written more than once are tinted*/
+    TEST_ASSERT_NOT_EQUAL(px_in, *(uint32_t *)lv_draw_buf_goto_xy(buf, 50, 50));
+    TEST_ASSERT_EQUAL_UINT32(px_out, *(uint32_t *)lv_draw_buf_goto_xy(buf, 200, 200));
+
+    /*The heatmap is not counted*/
+    lv_refr_overdraw_stats_t stats;
+    lv_refr_overdraw_get_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(stats.screen_px + 100 * 100, stats.written_px);
+
+    lv_refr_overdraw_set_heatmap(NULL, false);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(px_in, *(uint32_t *)lv_draw_buf_goto_xy(buf, 50, 50));
+}
+
+#endif /*LV_USE_OVERDRAW_DEBUG*/
+
+#endif
@@ -0,0 +1,238 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include <time.h>
+
+#define render_cache LV_GLOBAL_DEFAULT()->obj_render_cache
+
+static uint8_t * ref_buf;
+static size_t render_cache_size_ori;
+
+void setUp(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    ref_buf = lv_malloc(buf->data_size);
+    TEST_ASSERT_NOT_NULL(ref_buf);
+
+    render_cache_size_ori = lv_cache_get_max_size(render_cache, NULL);
+    lv_cache_reset_stats(render_cache);
+}
+
+void tearDown(void)
+{
+    lv_free(ref_buf);
+    lv_obj_clean(lv_screen_active());
+    lv_cache_set_max_size(render_cache, render_cache_size_ori, NULL);
+}
+
+/**
+ * Create a card with shadow, gradient, rounded corners and a few children
+ */
+static lv_obj_t * create_card(lv_obj_t * parent, int32_t x, int32_t y)
+{
+    lv_obj_t * card = lv_obj_create(parent);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(card, 220, 140);
+    lv_obj_set_pos(card, x, y);
+    lv_obj_set_style_radius(card, 16, 0);
+    lv_obj_set_style_shadow_width(card, 30, 0);
+    lv_obj_set_style_shadow_offset_y(card, 8, 0);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_lighten(LV_PALETTE_BLUE, 3), 0);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_clip_corner(card, true, 0);
+
+    lv_obj_t * label = lv_label_create(card);
+    lv_label_set_text(label, "Menu card");
+    lv_obj_align(label, LV_ALIGN_TOP_LEFT, 0, 0);
+
+    lv_obj_t * btn = lv_button_create(card);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, 10, 10);
+    label = lv_label_create(btn);
+    lv_label_set_text(label, "Open");
+
+    lv_obj_set_render_cache(card, true);
+    return card;
+}
+
+/**
+ * Refresh the display and check that the content is the same as if the caches were rendered again
+ */
+static void check_cached_content(void)
+{
+    lv_refr_now(NULL);
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    lv_cache_drop_all(render_cache, NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+}
+
+void test_render_cache_hit_and_invalidate(void)
+{
+    lv_obj_t * card1 = create_card(lv_screen_active(), 40, 40);
+    lv_obj_t * card2 = create_card(lv_screen_active(), 320, 40);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, lv_cache_get_miss_count(render_cache));
+
+    /*Something is drawn over the cards: they are drawn from the cache*/
+    lv_obj_t * dot = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(dot, 40, 40);
+    lv_obj_set_pos(dot, 230, 80);
+    lv_cache_reset_stats(render_cache);
+    lv_refr_now(NULL);
+    lv_obj_set_x(dot, 300);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_miss_count(render_cache));
+    TEST_ASSERT_GREATER_THAN(0, lv_cache_get_hit_count(render_cache));
+    check_cached_content();
+
+    /*A child has changed: only that card is rendered again*/
+    lv_cache_reset_stats(render_cache);
+    lv_label_set_text(lv_obj_get_child(card1, 0), "Changed text");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, lv_cache_get_miss_count(render_cache));
+    check_cached_content();
+
+    /*A grandchild has changed while the card is not visible*/
+    lv_obj_add_flag(card2, LV_OBJ_FLAG_HIDDEN);
+    lv_refr_now(NULL);
+    lv_obj_set_style_bg_color(lv_obj_get_child(card2, 1), lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_remove_flag(card2, LV_OBJ_FLAG_HIDDEN);
+    check_cached_content();
+
+    /*Moved, transformed and faded*/
+    lv_obj_set_pos(card1, 20, 330);
+    check_cached_content();
+    lv_obj_set_style_transform_scale(card2, 280, 0);
+    lv_obj_set_style_transform_rotation(card2, 150, 0);
+    check_cached_content();
+    lv_obj_set_style_opa(card1, LV_OPA_50, 0);
+    check_cached_content();
+
+    /*Inherited recolor*/
+    lv_obj_set_style_recolor(lv_screen_active(), lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_recolor_opa(lv_screen_active(), LV_OPA_30, 0);
+    check_cached_content();
+    lv_obj_set_style_recolor_opa(lv_screen_active(), LV_OPA_TRANSP, 0);
+
+    /*Disabled and deleted*/
+    lv_obj_set_render_cache(card1, false);
+    check_cached_content();
+    lv_obj_delete(card2);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(render_cache, NULL));
+}
+
+void test_render_cache_nested(void)
+{
+    lv_cache_set_max_size(render_cache, 4 * 1024 * 1024, NULL);
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 700, 400);
+    lv_obj_center(cont);
+    lv_obj_remove_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_render_cache(cont, true);
+
+    lv_obj_t * card = create_card(cont, 0, 0);
+    create_card(cont, 300, 160);
+    lv_refr_now(NULL);
+    check_cached_content();
+
+    /*The card and its parent are rendered again, the other card is taken from the cache*/
+    lv_cache_reset_stats(render_cache);
+    lv_label_set_text(lv_obj_get_child(card, 0), "Changed text");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, lv_cache_get_miss_count(render_cache));
+    TEST_ASSERT_EQUAL(1, lv_cache_get_hit_count(render_cache));
+    check_cached_content();
+}
+
+void test_render_cache_keep_on_placement(void)
+{
+    lv_obj_t * card = create_card(lv_screen_active(), 40, 40);
+    lv_refr_now(NULL);
+
+    /*Only the place of the content changes: it's not rendered again*/
+    lv_cache_reset_stats(render_cache);
+    lv_obj_set_pos(card, 200, 120);
+    lv_refr_now(NULL);
+    lv_obj_set_style_transform_pivot_x(card, 110, 0);
+    lv_obj_set_style_transform_pivot_y(card, 70, 0);
+    lv_obj_set_style_transform_scale_x(card, 400, 0);
+    lv_obj_set_style_transform_scale_y(card, 320, 0);
+    lv_refr_now(NULL);
+    lv_obj_set_style_transform_rotation(card, 100, 0);
+    lv_obj_set_style_translate_x(card, -30, 0);
+    lv_refr_now(NULL);
+    lv_obj_set_style_opa_layered(card, LV_OPA_60, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_miss_count(render_cache));
+    TEST_ASSERT_GREATER_THAN(0, lv_cache_get_hit_count(render_cache));
+    check_cached_content();
+
+    /*The transformed width changes the content*/
+    lv_cache_reset_stats(render_cache);
+    lv_obj_set_style_transform_width(card, 20, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, lv_cache_get_miss_count(render_cache));
+    check_cached_content();
+}
+
+void test_render_cache_too_large(void)
+{
+    lv_obj_t * card = create_card(lv_screen_active(), 40, 40);
+
+    /*It's drawn as usual if it doesn't fit into the cache*/
+    lv_cache_set_max_size(render_cache, 10 * 1024, NULL);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(render_cache, NULL));
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    lv_obj_set_render_cache(card, false);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+}
+
+static uint32_t bench_cards(bool cache)
+{
+    int32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_t * card = create_card(lv_screen_active(), 30 + (i % 3) * 250, 40 + (i / 3) * 220);
+        lv_obj_set_render_cache(card, cache);
+    }
+
+    /*A small object moving over the cards*/
+    lv_obj_t * dot = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(dot, 30, 30);
+    lv_obj_set_style_radius(dot, LV_RADIUS_CIRCLE, 0);
+    lv_refr_now(NULL);
+
+    clock_t t = clock();
+    for(i = 0; i < 200; i++) {
+        lv_obj_set_pos(dot, 20 + i * 3, 100 + (i % 50) * 4);
+        lv_refr_now(NULL);
+    }
+    t = clock() - t;
+
+    lv_obj_clean(lv_screen_active());
+    return (uint32_t)((uint64_t)t * 1000000 / CLOCKS_PER_SEC / 200);
+}
+
+void test_render_cache_bench(void)
+{
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs*/
+    uint32_t redraw_us = bench_cards(false);
+    uint32_t cache_us = bench_cards(true);
+    TEST_PRINTF("Cards under a moving object: %d us per frame without render cache, %d us with it",
+                (int)redraw_us, (int)cache_us);
+}
+
+#endif
@@ -0,0 +1,203 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include <time.h>
+
+static uint8_t * ref_buf;
+
+void setUp(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    ref_buf = lv_malloc(buf->data_size);
+    TEST_ASSERT_NOT_NULL(ref_buf);
+}
+
+void tearDown(void)
+{
+    lv_free(ref_buf);
+    lv_obj_clean(lv_screen_active());
+    lv_obj_clean(lv_layer_top());
+}
+
+static lv_obj_t * create_list(int32_t w, int32_t h, uint32_t item_cnt)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, w, h);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_scrollbar_mode(cont, LV_SCROLLBAR_MODE_ON);
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_SCROLL_BLIT);
+
+    /*A little wider than the list to scroll horizontally too*/
+    uint32_t i;
+    for(i = 0; i < item_cnt; i++) {
+        lv_obj_t * btn = lv_button_create(cont);
+        lv_obj_set_size(btn, lv_pct(120), LV_SIZE_CONTENT);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Item %d", (int)i);
+    }
+
+    return cont;
+}
+
+static lv_obj_t * create_test_list(void)
+{
+    lv_obj_t * cont = create_list(300, 360, 40);
+    lv_obj_align(cont, LV_ALIGN_LEFT_MID, 40, 0);
+
+    /*Something next to the list to see that it's not changed*/
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_set_text(label, "Not scrolled");
+    lv_obj_align(label, LV_ALIGN_RIGHT_MID, -40, 0);
+
+    lv_refr_now(NULL);
+    return cont;
+}
+
+/**
+ * Refresh the display and check that the content is the same as if the whole screen were redrawn
+ * @param moved     true: the content was expected to be moved instead of redrawing it
+ */
+static void check_scroll(bool moved)
+{
+    lv_display_t * disp = lv_display_get_default();
+    TEST_ASSERT_EQUAL(moved, disp->move_p > 0);
+    lv_refr_now(NULL);
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_MEMORY(buf->data, ref_buf, buf->data_size);
+}
+
+void test_scroll_blit_same_as_redraw(void)
+{
+    lv_obj_t * cont = create_test_list();
+
+    static const lv_point_t deltas[] = {
+        {0, -1}, {0, -37}, {0, -200}, {0, 15}, {0, 1}, {0, 100}, {-10, -10}, {-20, 0}, {30, 7},
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(deltas) / sizeof(deltas[0]); i++) {
+        lv_obj_scroll_by(cont, deltas[i].x, deltas[i].y, LV_ANIM_OFF);
+        check_scroll(true);
+    }
+
+    /*Nothing remains visible from the old content*/
+    lv_obj_scroll_by(cont, 0, -359, LV_ANIM_OFF);
+    check_scroll(false);
+
+    /*Scroll multiple times before refreshing*/
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, -25, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 3, 0, LV_ANIM_OFF);
+    check_scroll(true);
+
+    /*Scroll after a child has changed*/
+    lv_obj_set_style_bg_color(lv_obj_get_child(cont, 10), lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_color(lv_obj_get_child(cont, 12), lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_scroll_by(cont, 0, -40, LV_ANIM_OFF);
+    check_scroll(true);
+
+    /*Rounded corners and border*/
+    lv_obj_set_style_radius(cont, 30, 0);
+    lv_obj_set_style_border_width(cont, 8, 0);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, 60, LV_ANIM_OFF);
+    check_scroll(true);
+
+    /*Partially out of the screen*/
+    lv_obj_align(cont, LV_ALIGN_TOP_LEFT, -50, -100);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, -70, LV_ANIM_OFF);
+    check_scroll(true);
+}
+
+void test_scroll_blit_fallback(void)
+{
+    lv_obj_t * cont = create_test_list();
+
+    /*Without the flag*/
+    lv_obj_remove_flag(cont, LV_OBJ_FLAG_SCROLL_BLIT);
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    check_scroll(false);
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_SCROLL_BLIT);
+
+    /*Floating children are not scrolled*/
+    lv_obj_t * floating = lv_button_create(cont);
+    lv_obj_add_flag(floating, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(floating, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    check_scroll(false);
+    lv_obj_delete(floating);
+    lv_refr_now(NULL);
+
+    /*The background is not the same everywhere*/
+    lv_obj_set_style_bg_grad_dir(cont, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_grad_color(cont, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    check_scroll(false);
+    lv_obj_set_style_bg_grad_dir(cont, LV_GRAD_DIR_NONE, 0);
+
+    /*The parent is visible through the background*/
+    lv_obj_set_style_bg_opa(cont, LV_OPA_50, 0);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    check_scroll(false);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, 0);
+
+    /*Something is drawn on the list*/
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_align_to(obj, cont, LV_ALIGN_CENTER, 0, 0);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    check_scroll(false);
+
+    /*It's on the top layer*/
+    lv_obj_set_parent(obj, lv_layer_top());
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    check_scroll(false);
+
+    /*Not on the list anymore*/
+    lv_obj_align(obj, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    check_scroll(true);
+}
+
+static uint32_t bench_scroll(bool blit)
+{
+    lv_obj_t * cont = create_list(lv_pct(100), lv_pct(100), 20);
+    if(!blit) lv_obj_remove_flag(cont, LV_OBJ_FLAG_SCROLL_BLIT);
+    lv_refr_now(NULL);
+
+    clock_t t = clock();
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        lv_obj_scroll_by(cont, 0, i < 100 ? -5 : 5, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+    }
+    t = clock() - t;
+
+    lv_obj_clean(lv_screen_active());
+    return (uint32_t)((uint64_t)t * 1000000 / CLOCKS_PER_SEC / 200);
+}
+
+void test_scroll_blit_bench(void)
+{
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs*/
+    uint32_t redraw_us = bench_scroll(false);
+    uint32_t blit_us = bench_scroll(true);
+    TEST_PRINTF("Containers with scrolling, 5 px per frame: %d us per frame with redraw, %d us with blit",
+                (int)redraw_us, (int)blit_us);
+}
+
+#endif
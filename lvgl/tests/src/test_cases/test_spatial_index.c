@@ -0,0 +1,228 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define OBJ_CNT     200
+
+static uint8_t * ref_buf;
+static lv_obj_t * objs[OBJ_CNT];
+static uint32_t rnd_seed;
+
+void setUp(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    ref_buf = lv_malloc(buf->data_size);
+    TEST_ASSERT_NOT_NULL(ref_buf);
+    rnd_seed = 12345;
+}
+
+void tearDown(void)
+{
+    lv_free(ref_buf);
+    lv_obj_clean(lv_screen_active());
+    lv_obj_set_scrollbar_mode(lv_screen_active(), LV_SCROLLBAR_MODE_AUTO);
+}
+
+static int32_t rnd(int32_t min, int32_t max)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return min + (int32_t)((rnd_seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+/**
+ * The same as `lv_indev_search_obj()` without the spatial index
+ */
+static lv_obj_t * search_obj_linear(lv_obj_t * obj, lv_point_t * point)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
+
+    lv_point_t p_trans = *point;
+    lv_obj_transform_point(obj, &p_trans, LV_OBJ_POINT_TRANSFORM_FLAG_INVERSE);
+    bool hit_test_ok = lv_obj_hit_test(obj, &p_trans);
+
+    lv_area_t obj_coords = obj->coords;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+        lv_area_increase(&obj_coords, ext_draw_size, ext_draw_size);
+    }
+    if(lv_area_is_point_on(&obj_coords, &p_trans, 0)) {
+        int32_t i;
+        for(i = (int32_t)lv_obj_get_child_count(obj) - 1; i >= 0; i--) {
+            lv_obj_t * found = search_obj_linear(lv_obj_get_child(obj, i), &p_trans);
+            if(found) return found;
+        }
+    }
+
+    return hit_test_ok ? obj : NULL;
+}
+
+/**
+ * Create random rectangles with shadows, transformations, extended click areas and children
+ */
+static void create_objs(lv_obj_t * parent, uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * obj = lv_obj_create(parent);
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_pos(obj, rnd(-20, 780), rnd(-20, 460));
+        lv_obj_set_size(obj, rnd(8, 60), rnd(8, 60));
+        lv_obj_set_style_pad_all(obj, 0, 0);
+        lv_obj_set_style_bg_color(obj, lv_color_hex(rnd(0, 0xffffff)), 0);
+        lv_obj_set_style_shadow_width(obj, rnd(0, 3) == 0 ? 15 : 0, 0);
+        if(rnd(0, 20) == 0) lv_obj_set_style_transform_rotation(obj, rnd(1, 3599), 0);
+        if(rnd(0, 10) == 0) lv_obj_set_ext_click_area(obj, 10);
+        if(rnd(0, 20) == 0) lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        if(rnd(0, 10) == 0) {
+            lv_obj_t * child = lv_obj_create(obj);
+            lv_obj_set_size(child, 10, 10);
+            lv_obj_set_pos(child, rnd(-10, 30), rnd(-10, 30));
+            lv_obj_add_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+        }
+        objs[i] = obj;
+    }
+}
+
+static void check_hit_test(void)
+{
+    lv_obj_update_layout(lv_screen_active());
+
+    int32_t x;
+    int32_t y;
+    for(y = -10; y < 490; y += 13) {
+        for(x = -10; x < 810; x += 13) {
+            lv_point_t p = {x, y};
+            lv_obj_t * ref = search_obj_linear(lv_screen_active(), &p);
+            lv_obj_t * res = lv_indev_search_obj(lv_screen_active(), &p);
+            TEST_ASSERT_EQUAL_PTR(ref, res);
+        }
+    }
+}
+
+/**
+ * Move, resize, transform and optionally reorder some objects
+ */
+static void change_objs(uint32_t cnt, bool reorder)
+{
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * obj = objs[rnd(0, cnt - 1)];
+        if(obj == NULL) continue;
+        switch(rnd(0, 5)) {
+            case 0:
+                lv_obj_set_pos(obj, rnd(-20, 780), rnd(-20, 460));
+                break;
+            case 1:
+                lv_obj_set_size(obj, rnd(8, 120), rnd(8, 120));
+                break;
+            case 2:
+                if(reorder) lv_obj_move_foreground(obj);
+                else lv_obj_set_pos(obj, rnd(-20, 780), rnd(-20, 460));
+                break;
+            case 3:
+                lv_obj_set_style_transform_scale(obj, 300, 0);
+                break;
+            case 4:
+                lv_obj_set_style_outline_width(obj, 12, 0);
+                break;
+            case 5:
+                lv_obj_set_ext_click_area(obj, 20);
+                break;
+        }
+    }
+}
+
+void test_spatial_index_hit_test(void)
+{
+    lv_obj_t * scr = lv_screen_active();
+    create_objs(scr, OBJ_CNT);
+    check_hit_test();
+
+    change_objs(OBJ_CNT, true);
+    check_hit_test();
+
+    /*The index is shifted on scrolling. Floating children stay in place.*/
+    lv_obj_add_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(objs[0], LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_pos(objs[1], 1500, 1200);
+    lv_obj_scroll_by(scr, -35, -70, LV_ANIM_OFF);
+    check_hit_test();
+
+    /*Below the threshold the index is dropped*/
+    uint32_t i;
+    for(i = 0; i < OBJ_CNT - 10; i++) lv_obj_delete(objs[i]);
+    check_hit_test();
+    TEST_ASSERT_NULL(scr->spec_attr->spatial_index);
+}
+
+void test_spatial_index_nested(void)
+{
+    /*An indexed container in an indexed container, scrolled*/
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 500, 400);
+    lv_obj_set_pos(cont, 100, 40);
+    create_objs(cont, OBJ_CNT / 2);
+    create_objs(lv_screen_active(), 40);
+
+    check_hit_test();
+    lv_obj_scroll_by(cont, 20, 30, LV_ANIM_OFF);
+    check_hit_test();
+    lv_obj_set_pos(cont, 0, 0);
+    check_hit_test();
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    check_hit_test();
+    TEST_ASSERT_NOT_NULL(cont->spec_attr->spatial_index);
+}
+
+/**
+ * Render the objects once on the screen (indexed) and once in groups below the threshold
+ * (not indexed) and compare the results after the same changes.
+ */
+void test_spatial_index_draw(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    /*The groups don't overflow the screen so there would be no scrollbars*/
+    lv_obj_set_scrollbar_mode(lv_screen_active(), LV_SCROLLBAR_MODE_OFF);
+    uint32_t pass;
+    for(pass = 0; pass < 2; pass++) {
+        rnd_seed = 12345;
+        create_objs(lv_screen_active(), OBJ_CNT);
+        lv_obj_t * group = NULL;
+        uint32_t i;
+        if(pass == 1) {
+            for(i = 0; i < OBJ_CNT; i++) {
+                if(i % (LV_OBJ_SPATIAL_INDEX_MIN_CHILDREN - 1) == 0) {
+                    group = lv_obj_create(lv_screen_active());
+                    lv_obj_remove_style_all(group);
+                    lv_obj_set_size(group, LV_PCT(100), LV_PCT(100));
+                    lv_obj_remove_flag(group, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+                }
+                lv_obj_set_parent(objs[i], group);
+            }
+        }
+
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+
+        /*Only the changed areas are redrawn*/
+        for(i = 0; i < 5; i++) {
+            change_objs(OBJ_CNT, false);
+            lv_refr_now(NULL);
+        }
+
+        if(pass == 0) {
+            TEST_ASSERT_NOT_NULL(lv_screen_active()->spec_attr->spatial_index);
+            lv_memcpy(ref_buf, buf->data, buf->data_size);
+        }
+        else {
+            TEST_ASSERT_NULL(group->spec_attr->spatial_index);
+            TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+        }
+
+        lv_obj_clean(lv_screen_active());
+    }
+}
+
+#endif
@@ -2,8 +2,10 @@
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
 
+#include "../demos/lv_demos.h"
 #include "unity/unity.h"
 #include <unistd.h>
+#include <time.h>
 
 static void obj_set_height_helper(void * obj, int32_t height)
 {
@@ -114,6 +116,8 @@ void test_style_replacement(void)
     TEST_ASSERT_EQUAL(false, replaced);
     TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
 
+    /*The styles are on the stack, don't leave them on the screen*/
+    lv_obj_delete(obj);
     lv_style_reset(&style_red);
     lv_style_reset(&style_blue);
 }
@@ -138,7 +142,174 @@ void test_style_has_prop(void)
     TEST_ASSERT_EQUAL(true, lv_obj_has_style_prop(obj, LV_PART_MAIN, LV_STYLE_OUTLINE_WIDTH));
     TEST_ASSERT_EQUAL(false, lv_obj_has_style_prop(obj, LV_PART_INDICATOR, LV_STYLE_OUTLINE_COLOR));
 
+    /*The styles are on the stack, don't leave them on the screen*/
+    lv_obj_delete(obj);
     lv_style_reset(&style);
 }
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0
+
+void test_style_resolved_cache_follows_changes(void)
+{
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_color(&style, lv_color_hex(0xff0000));
+    lv_style_set_text_color(&style, lv_color_hex(0x00ff00));
+
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_t * parent2 = lv_obj_create(lv_screen_active());
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, 0);
+
+    /*Read twice to be sure the second read comes from the cache*/
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Changing a shared style*/
+    lv_style_set_bg_color(&style, lv_color_hex(0x0000ff));
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Local style*/
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x123456), 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*State change*/
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x654321), LV_STATE_CHECKED);
+    lv_obj_add_state(obj, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x654321), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_remove_state(obj, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Removing the style*/
+    lv_obj_remove_style(obj, &style, 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_obj_get_style_text_color(parent, LV_PART_MAIN),
+                            lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Inherited from the parent*/
+    lv_obj_set_style_text_color(parent, lv_color_hex(0xabcdef), 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xabcdef), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Inherited from the new parent*/
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0xfedcba), 0);
+    lv_obj_set_parent(obj, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xfedcba), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    lv_obj_delete(parent);
+    lv_obj_delete(parent2);
+    lv_style_reset(&style);
+}
+
+static void read_hot_props(lv_obj_t * obj)
+{
+    static const lv_part_t parts[] = {LV_PART_MAIN, LV_PART_INDICATOR, LV_PART_KNOB};
+    uint32_t p;
+    for(p = 0; p < sizeof(parts) / sizeof(parts[0]); p++) {
+        lv_part_t part = parts[p];
+        lv_obj_get_style_bg_color(obj, part);
+        lv_obj_get_style_bg_opa(obj, part);
+        lv_obj_get_style_radius(obj, part);
+        lv_obj_get_style_border_width(obj, part);
+        lv_obj_get_style_border_color(obj, part);
+        lv_obj_get_style_outline_width(obj, part);
+        lv_obj_get_style_shadow_width(obj, part);
+        lv_obj_get_style_text_font(obj, part);
+        lv_obj_get_style_text_color(obj, part);
+        lv_obj_get_style_pad_top(obj, part);
+        lv_obj_get_style_opa(obj, part);
+    }
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_count(obj); i++) {
+        read_hot_props(lv_obj_get_child(obj, i));
+    }
+}
+
+/*Not a real benchmark, just to see the order of magnitude of the gain in the test logs*/
+static void resolved_cache_bench(const char * name)
+{
+    uint32_t i;
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_style_resolved_cache_info_t info1;
+    lv_obj_style_resolved_cache_info_t info2;
+    lv_obj_style_resolved_cache_info_t info3;
+
+    clock_t t_walk = clock();
+    for(i = 0; i < 20; i++) {
+        lv_obj_style_resolved_cache_invalidate(NULL, true);
+        read_hot_props(scr);
+    }
+    t_walk = clock() - t_walk;
+    lv_obj_style_get_resolved_cache_info(&info1);
+
+    clock_t t_cached = clock();
+    for(i = 0; i < 20; i++) {
+        read_hot_props(scr);
+    }
+    t_cached = clock() - t_cached;
+    lv_obj_style_get_resolved_cache_info(&info2);
+
+    clock_t t_frame = clock();
+    for(i = 0; i < 5; i++) {
+        lv_obj_invalidate(scr);
+        lv_refr_now(NULL);
+    }
+    t_frame = clock() - t_frame;
+    lv_obj_style_get_resolved_cache_info(&info3);
+
+    uint32_t hit_cached = info2.hit_cnt - info1.hit_cnt;
+    uint32_t miss_cached = info2.miss_cnt - info1.miss_cnt;
+    uint32_t hit_frame = info3.hit_cnt - info2.hit_cnt;
+    uint32_t miss_frame = info3.miss_cnt - info2.miss_cnt;
+    TEST_PRINTF("%s: %d objects, %d bytes, lookups: %ld us uncached / %ld us cached (%d%% hit), "
+                "frame: %ld us (%d%% hit)",
+                name, (int)info3.obj_cnt, (int)info3.mem_size,
+                (long)(t_walk * 1000000 / CLOCKS_PER_SEC), (long)(t_cached * 1000000 / CLOCKS_PER_SEC),
+                (int)((uint64_t)hit_cached * 100 / LV_MAX(hit_cached + miss_cached, 1)),
+                (long)(t_frame * 1000000 / CLOCKS_PER_SEC / 5),
+                (int)((uint64_t)hit_frame * 100 / LV_MAX(hit_frame + miss_frame, 1)));
+
+    TEST_ASSERT_GREATER_THAN(0, info3.obj_cnt);
+    TEST_ASSERT_GREATER_THAN(miss_cached, hit_cached);
+    TEST_ASSERT_GREATER_THAN(miss_frame, hit_frame);
+}
+
+void test_style_resolved_cache_bench_containers(void)
+{
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW_WRAP);
+
+    /*Similar to the "Containers" scene of the benchmark demo*/
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * card = lv_obj_create(scr);
+        lv_obj_set_size(card, 180, 120);
+        lv_obj_set_style_shadow_width(card, 20, 0);
+        lv_obj_set_flex_flow(card, LV_FLEX_FLOW_COLUMN);
+        lv_label_set_text(lv_label_create(card), "Title");
+        lv_obj_t * btn = lv_button_create(card);
+        lv_label_set_text(lv_label_create(btn), "Button");
+        lv_obj_t * sw = lv_switch_create(card);
+        lv_obj_add_state(sw, LV_STATE_CHECKED);
+    }
+
+    resolved_cache_bench("Containers");
+    lv_obj_clean(scr);
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW);
+    lv_obj_set_layout(scr, LV_LAYOUT_NONE);
+}
+
+void test_style_resolved_cache_bench_widgets(void)
+{
+#if LV_USE_DEMO_WIDGETS
+    lv_demo_widgets();
+    resolved_cache_bench("Widgets demo");
+    lv_obj_clean(lv_screen_active());
+#endif
+}
+
+#endif /*LV_OBJ_STYLE_RESOLVED_CACHE_SIZE > 0*/
+
 #endif
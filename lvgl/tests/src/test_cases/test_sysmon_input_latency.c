@@ -0,0 +1,180 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PERF_MONITOR
+
+static lv_display_flush_cb_t flush_cb_ori;
+static lv_display_t * flush_pending_disp;
+static lv_indev_t * indev;
+static uint32_t indev_timestamp;
+static lv_indev_state_t indev_state;
+static lv_obj_t * btn;
+
+static void deferred_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    flush_pending_disp = disp;
+}
+
+static void read_cb(lv_indev_t * i, lv_indev_data_t * data)
+{
+    LV_UNUSED(i);
+    data->state = indev_state;
+    data->key = LV_KEY_ENTER;
+    data->timestamp = indev_timestamp;
+}
+
+void setUp(void)
+{
+    flush_cb_ori = lv_display_get_default()->flush_cb;
+    flush_pending_disp = NULL;
+
+    /*A keypad without group changes nothing on the screen*/
+    indev = lv_indev_create();
+    lv_indev_set_type(indev, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+    lv_indev_set_read_cb(indev, read_cb);
+    indev_state = LV_INDEV_STATE_RELEASED;
+    indev_timestamp = 0;
+
+    btn = lv_button_create(lv_screen_active());
+    lv_obj_center(btn);
+
+    /*Start from a clean state*/
+    lv_tick_inc(100);
+    lv_refr_now(NULL);
+    lv_sysmon_reset_input_latency(NULL);
+}
+
+void tearDown(void)
+{
+    lv_display_set_flush_cb(lv_display_get_default(), flush_cb_ori);
+    lv_indev_delete(indev);
+    lv_obj_clean(lv_screen_active());
+    lv_sysmon_reset_input_latency(NULL);
+}
+
+static void input(lv_indev_state_t state, uint32_t timestamp)
+{
+    indev_state = state;
+    indev_timestamp = timestamp;
+    lv_indev_read(indev);
+}
+
+void test_sysmon_input_latency_pointer(void)
+{
+    /*The button gets the pressed style so the press is shown*/
+    lv_test_mouse_move_to_obj(btn);
+    lv_test_mouse_press();
+    lv_test_wait(50);
+    lv_test_mouse_release();
+    lv_test_wait(50);
+
+    lv_sysmon_input_latency_t latency;
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, latency.cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(50, latency.max);
+}
+
+void test_sysmon_input_latency_until_flush_ready(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_display_set_flush_cb(disp, deferred_flush_cb);
+
+    /*The driver saw the input 7 ms ago*/
+    input(LV_INDEV_STATE_PRESSED, lv_tick_get() - 7);
+    lv_obj_invalidate(btn);
+
+    /*Rendering starts 5 ms later*/
+    lv_tick_inc(5);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_PTR(disp, flush_pending_disp);
+
+    lv_sysmon_input_latency_t latency;
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.cnt);
+
+    /*The transfer takes 4 ms*/
+    lv_tick_inc(4);
+    lv_display_flush_ready(disp);
+
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_EQUAL_UINT32(1, latency.cnt);
+    TEST_ASSERT_EQUAL_UINT32(16, latency.min);
+    TEST_ASSERT_EQUAL_UINT32(16, latency.max);
+    TEST_ASSERT_EQUAL_UINT32(16, latency.p50);
+    TEST_ASSERT_EQUAL_UINT32(16, latency.p99);
+
+    /*Not counted again on the next refresh*/
+    lv_obj_invalidate(btn);
+    lv_refr_now(NULL);
+    lv_display_flush_ready(disp);
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_EQUAL_UINT32(1, latency.cnt);
+}
+
+void test_sysmon_input_latency_no_change(void)
+{
+    /*Nothing is redrawn so the input is dropped*/
+    input(LV_INDEV_STATE_PRESSED, 0);
+    lv_refr_now(NULL);
+
+    lv_obj_invalidate(btn);
+    lv_refr_now(NULL);
+
+    /*Reading the same state again is not an input*/
+    input(LV_INDEV_STATE_PRESSED, 0);
+    lv_obj_invalidate(btn);
+    lv_refr_now(NULL);
+
+    lv_sysmon_input_latency_t latency;
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.cnt);
+
+    /*The first input of a frame is measured*/
+    input(LV_INDEV_STATE_RELEASED, lv_tick_get() - 20);
+    lv_sysmon_report_input(NULL, lv_tick_get() - 10);
+    lv_obj_invalidate(btn);
+    lv_refr_now(NULL);
+
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_EQUAL_UINT32(1, latency.cnt);
+    TEST_ASSERT_EQUAL_UINT32(20, latency.max);
+}
+
+void test_sysmon_input_latency_percentiles(void)
+{
+    uint32_t i;
+    for(i = 1; i <= 100; i++) {
+        lv_sysmon_report_input(NULL, lv_tick_get() - i);
+        lv_obj_invalidate(btn);
+        lv_refr_now(NULL);
+    }
+
+    lv_sysmon_input_latency_t latency;
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_EQUAL_UINT32(100, latency.cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, latency.min);
+    TEST_ASSERT_EQUAL_UINT32(100, latency.max);
+    /*Accurate to 12.5%*/
+    TEST_ASSERT_UINT32_WITHIN(50 / 8, 50, latency.p50);
+    TEST_ASSERT_UINT32_WITHIN(95 / 8, 95, latency.p95);
+    TEST_ASSERT_UINT32_WITHIN(99 / 8, 99, latency.p99);
+
+    /*Timestamps in the future are clamped*/
+    lv_sysmon_reset_input_latency(NULL);
+    lv_sysmon_report_input(NULL, lv_tick_get() + 1000);
+    lv_obj_invalidate(btn);
+    lv_refr_now(NULL);
+    lv_sysmon_get_input_latency(NULL, &latency);
+    TEST_ASSERT_EQUAL_UINT32(1, latency.cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.max);
+}
+
+#endif /*LV_USE_PERF_MONITOR*/
+
+#endif
@@ -0,0 +1,208 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include <time.h>
+
+static char run_order[16];
+static uint32_t run_order_cnt;
+
+void setUp(void)
+{
+    run_order_cnt = 0;
+    lv_memzero(run_order, sizeof(run_order));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = lv_timer_get_user_data(timer);
+    (*cnt)++;
+}
+
+static void order_cb(lv_timer_t * timer)
+{
+    const char * name = lv_timer_get_user_data(timer);
+    if(run_order_cnt < sizeof(run_order) - 1) run_order[run_order_cnt++] = name[0];
+}
+
+static void delete_other_cb(lv_timer_t * timer)
+{
+    lv_timer_t * other = lv_timer_get_user_data(timer);
+    lv_timer_delete(other);
+    lv_timer_delete(timer);
+}
+
+static bool timer_exists(lv_timer_t * timer)
+{
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(t == timer) return true;
+        t = lv_timer_get_next(t);
+    }
+    return false;
+}
+
+static void run_for(uint32_t ms)
+{
+    uint32_t i;
+    for(i = 0; i < ms; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+}
+
+void test_timer_period_and_repeat_count(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 10, &cnt);
+    lv_timer_set_repeat_count(timer, 3);
+
+    run_for(9);
+    TEST_ASSERT_EQUAL_UINT32(0, cnt);
+    run_for(1);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+    run_for(25);
+    TEST_ASSERT_EQUAL_UINT32(3, cnt);
+
+    /*Deleted after the last repeat*/
+    TEST_ASSERT_FALSE(timer_exists(timer));
+}
+
+void test_timer_repeat_count_without_auto_delete(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 10, &cnt);
+    lv_timer_set_auto_delete(timer, false);
+    lv_timer_set_repeat_count(timer, 1);
+
+    run_for(30);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+    TEST_ASSERT_TRUE(timer_exists(timer));
+    TEST_ASSERT_TRUE(lv_timer_get_paused(timer));
+
+    /*No repeats left: it's paused again without calling the callback*/
+    lv_timer_resume(timer);
+    run_for(1);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+    TEST_ASSERT_TRUE(lv_timer_get_paused(timer));
+
+    lv_timer_set_repeat_count(timer, 2);
+    lv_timer_resume(timer);
+    run_for(30);
+    TEST_ASSERT_EQUAL_UINT32(3, cnt);
+
+    lv_timer_delete(timer);
+}
+
+void test_timer_pause_resume_ready_reset(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 100, &cnt);
+
+    lv_timer_pause(timer);
+    run_for(300);
+    TEST_ASSERT_EQUAL_UINT32(0, cnt);
+
+    /*It's overdue so it runs right after resuming*/
+    lv_timer_resume(timer);
+    run_for(1);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+
+    lv_timer_ready(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, cnt);
+
+    run_for(50);
+    lv_timer_reset(timer);
+    run_for(99);
+    TEST_ASSERT_EQUAL_UINT32(2, cnt);
+    run_for(1);
+    TEST_ASSERT_EQUAL_UINT32(3, cnt);
+
+    /*A shorter period moves the deadline earlier*/
+    lv_timer_set_period(timer, 10);
+    run_for(10);
+    TEST_ASSERT_EQUAL_UINT32(4, cnt);
+
+    lv_timer_delete(timer);
+}
+
+void test_timer_time_until_next(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer1 = lv_timer_create(count_cb, 1000, &cnt);
+    lv_timer_t * timer2 = lv_timer_create(count_cb, 3000, &cnt);
+    lv_timer_handler();
+
+    /*The display and input device timers can run sooner*/
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1000, lv_timer_handler());
+
+    lv_timer_pause(timer1);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(3000, lv_timer_handler());
+    lv_timer_delete(timer1);
+    lv_timer_delete(timer2);
+}
+
+void test_timer_ready_timers_run_newest_first(void)
+{
+    lv_timer_t * a = lv_timer_create(order_cb, 10, "a");
+    lv_timer_t * b = lv_timer_create(order_cb, 20, "b");
+    lv_timer_t * c = lv_timer_create(order_cb, 10, "c");
+
+    /*All of them are ready, so they run in the order of the timer list*/
+    run_order_cnt = 0;
+    lv_tick_inc(25);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_STRING("cba", run_order);
+
+    lv_timer_delete(a);
+    lv_timer_delete(b);
+    lv_timer_delete(c);
+}
+
+void test_timer_delete_other_timer_in_callback(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * victim = lv_timer_create(count_cb, 10, &cnt);
+    lv_timer_create(delete_other_cb, 10, victim);
+
+    /*The newer timer runs first and deletes the other one*/
+    run_for(10);
+    TEST_ASSERT_EQUAL_UINT32(0, cnt);
+    TEST_ASSERT_FALSE(timer_exists(victim));
+}
+
+void test_timer_bench_1000_timers(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timers[1000];
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        timers[i] = lv_timer_create(count_cb, 50 + (i % 20) * 50, &cnt);
+    }
+
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs*/
+    clock_t t = clock();
+    run_for(1000);
+    t = clock() - t;
+
+    /*Every timer ran according to its period*/
+    uint32_t expected = 0;
+    for(i = 0; i < 1000; i++) expected += 1000 / (50 + (i % 20) * 50);
+    TEST_ASSERT_EQUAL_UINT32(expected, cnt);
+
+    TEST_PRINTF("1000 timers, lv_timer_handler(): %ld ns per call, %d callbacks in 1000 calls",
+                (long)((uint64_t)t * 1000000 / CLOCKS_PER_SEC), (int)cnt);
+
+    for(i = 0; i < 1000; i++) {
+        lv_timer_delete(timers[i]);
+    }
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "../../lvgl_private.h"
 
 #include "unity/unity.h"
+#include <time.h>
 
 static lv_obj_t * active_screen = NULL;
 static lv_obj_t * chart = NULL;
@@ -212,4 +213,113 @@ void test_chart_scatter(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_scatter.png");
 }
 
+static int32_t test_value(uint32_t i)
+{
+    /*A noisy wave which has different min/max values in every column*/
+    uint32_t noise = (i * 1103515245u + 12345u) >> 16;
+    return lv_trigo_sin((int16_t)((i / 8) % 360)) / 400 + (int32_t)(noise % 30) - 15;
+}
+
+static void crowded_chart_init(lv_chart_update_mode_t mode, uint32_t point_cnt)
+{
+    lv_obj_set_size(chart, 240, 160);
+    lv_obj_center(chart);
+    lv_chart_set_update_mode(chart, mode);
+    lv_chart_set_point_count(chart, point_cnt);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, -120, 120);
+    lv_chart_set_range(chart, LV_CHART_AXIS_SECONDARY_Y, -240, 240);
+}
+
+void test_chart_crowded_line(void)
+{
+    crowded_chart_init(LV_CHART_UPDATE_MODE_CIRCULAR, 2000);
+    lv_chart_series_t * ser1 = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_series_t * ser2 = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_BLUE),
+                                                   LV_CHART_AXIS_SECONDARY_Y);
+
+    uint32_t i;
+    for(i = 0; i < 1500; i++) {
+        lv_chart_set_next_value(chart, ser1, test_value(i));
+        lv_chart_set_next_value(chart, ser2, test_value(i + 5000));
+    }
+
+    /*Leave a gap in the second series*/
+    for(i = 300; i < 500; i++) {
+        lv_chart_set_series_value_by_id(chart, ser2, i, LV_CHART_POINT_NONE);
+    }
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_crowded_line_1.png");
+
+    /*Overwrite the beginning of the series. The columns of the new points are updated one by one.*/
+    for(i = 0; i < 900; i++) {
+        lv_chart_set_next_value(chart, ser1, test_value(i) * 3 / 2);
+        lv_chart_set_next_value(chart, ser2, test_value(i) + 80);
+    }
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_crowded_line_2.png");
+}
+
+void test_chart_crowded_line_shift(void)
+{
+    crowded_chart_init(LV_CHART_UPDATE_MODE_SHIFT, 2000);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+
+    uint32_t i;
+    for(i = 0; i < 2900; i++) {
+        lv_chart_set_next_value(chart, ser, test_value(i));
+    }
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_crowded_line_shift.png");
+
+    /*Changing the values directly in the array requires a refresh*/
+    int32_t * y_array = lv_chart_get_series_y_array(chart, ser);
+    for(i = 0; i < 2000; i++) {
+        y_array[i] = -y_array[i];
+    }
+    lv_chart_refresh(chart);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_crowded_line_shift_inverted.png");
+}
+
+static void bench_crowded(lv_chart_update_mode_t mode, const char * mode_name)
+{
+    crowded_chart_init(mode, 10000);
+
+    lv_chart_series_t * ser[4];
+    uint32_t s;
+    uint32_t i;
+    for(s = 0; s < 4; s++) {
+        ser[s] = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_RED + s * 3), LV_CHART_AXIS_PRIMARY_Y);
+        for(i = 0; i < 10000; i++) {
+            lv_chart_set_next_value(chart, ser[s], test_value(i + s * 100));
+        }
+    }
+    lv_refr_now(NULL);
+
+    /*Not a real benchmark, just to see the order of magnitude of the cost in the test logs.
+     *One second at 60 FPS with a new sample in each series on every frame.*/
+    clock_t t = clock();
+    uint32_t frame;
+    for(frame = 0; frame < 60; frame++) {
+        for(s = 0; s < 4; s++) {
+            lv_chart_set_next_value(chart, ser[s], test_value(frame * 7 + s));
+        }
+        lv_refr_now(NULL);
+    }
+    t = clock() - t;
+
+    TEST_PRINTF("4 x 10000 points, %s mode: %ld us per frame", mode_name,
+                (long)((uint64_t)t * 1000000 / CLOCKS_PER_SEC / 60));
+}
+
+void test_chart_bench_crowded_circular(void)
+{
+    bench_crowded(LV_CHART_UPDATE_MODE_CIRCULAR, "circular");
+}
+
+void test_chart_bench_crowded_shift(void)
+{
+    bench_crowded(LV_CHART_UPDATE_MODE_SHIFT, "shift");
+}
+
 #endif
@@ -107,4 +107,13 @@ typedef struct {
 #define TEMP_WARNING_THRESHOLD 70    // 温度警告阈值(℃)
 #define MEM_PRESSURE_THRESHOLD 80    // 内存压力阈值(%)
 
+// 性能追踪: 生成定时器回调cb的包装函数cb_traced, 在LVGL profiler的追踪中以tag标出该模块的耗时
+// (LV_USE_PROFILER为0时不产生任何开销)
+#define UI_PROFILER_TIMER_CB(cb, tag)                   \
+    static void cb##_traced(lv_timer_t *timer) {        \
+        LV_PROFILER_BEGIN_TAG(tag);                     \
+        cb(timer);                                      \
+        LV_PROFILER_END_TAG(tag);                       \
+    }
+
 #endif // LV_UI_COMMON_H
@@ -21,6 +21,7 @@
 
 static volatile bool thread_running = false;
 static volatile button_event_t current_event = BUTTON_EVENT_NONE;
+static uint32_t current_event_time = 0;  // 事件产生时间(CLOCK_MONOTONIC ms)，用于统计输入延迟
 static pthread_mutex_t event_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t thread_mutex = PTHREAD_MUTEX_INITIALIZER;
 static bool in_submenu = false;
@@ -58,18 +59,19 @@ static int read_from_file(const char *filename) {
     return buf[0] == '1' ? 1 : 0;
 }
 
-static void set_button_event(button_event_t event) {
-    pthread_mutex_lock(&event_mutex);
-    current_event = event;
-    pthread_mutex_unlock(&event_mutex);
-}
-
 static uint32_t get_time_ms(void) {
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
     return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
+static void set_button_event(button_event_t event) {
+    pthread_mutex_lock(&event_mutex);
+    current_event = event;
+    current_event_time = get_time_ms();
+    pthread_mutex_unlock(&event_mutex);
+}
+
 static int read_gpio_value(void) {
     if (gpio_value_fd < 0) return -1;
 
@@ -183,8 +185,18 @@ button_event_t key355_get_event(void) {
     button_event_t event;
     pthread_mutex_lock(&event_mutex);
     event = current_event;
+#if LV_USE_PERF_MONITOR
+    uint32_t event_time = current_event_time;
+#endif
     current_event = BUTTON_EVENT_NONE;
     pthread_mutex_unlock(&event_mutex);
+
+#if LV_USE_PERF_MONITOR
+    // 按键不是lv_indev，需自行上报：换算到lv_tick时间后，从按键识别到画面刷出计为一次输入延迟
+    if (event != BUTTON_EVENT_NONE) {
+        lv_sysmon_report_input(NULL, lv_tick_get() - (get_time_ms() - event_time));
+    }
+#endif
     return event;
 }
 
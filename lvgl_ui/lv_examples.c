@@ -48,6 +48,7 @@ static void global_update_cb(lv_timer_t *timer) {
         lv_refr_now(lv_display_get_default());
     }
 }
+UI_PROFILER_TIMER_CB(global_update_cb, "global_update")
 
 /**
  * 初始化并显示系统菜单UI
@@ -73,7 +74,7 @@ void storage_monitor_init(const char *path) {
         
     // 创建更智能的全局更新定时器
     if (global_update_timer == NULL) {
-        global_update_timer = lv_timer_create(global_update_cb, update_interval_ms, NULL);
+        global_update_timer = lv_timer_create(global_update_cb_traced, update_interval_ms, NULL);
     }
 }
 
@@ -4,6 +4,7 @@
 #include "../core/ipc_udp.h" // 修改为新的IPC UDP头文件
 #include "../core/cJSON.h" // 添加cJSON头文件
 #include "../core/ai_comm_manager.h" // 修改引入头文件 - 添加AI通信管理器
+#include "../utils/ui_transition.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -79,6 +80,9 @@ static void scroll_text_timer_cb(lv_timer_t *timer);
 static void process_udp_messages(lv_timer_t *timer); // 新增UDP消息处理函数
 static void update_dialog_text(const char *new_text); // 新增对话文本更新函数
 static void init_ai_communication(void); // 添加init_ai_communication的前向声明
+UI_PROFILER_TIMER_CB(button_event_timer_cb, "AI_ui/button")
+UI_PROFILER_TIMER_CB(scroll_text_timer_cb, "AI_ui/scroll")
+UI_PROFILER_TIMER_CB(process_udp_messages, "AI_ui/udp")
 
 // 添加一个简单的消息缓冲区
 static struct {
@@ -268,7 +272,7 @@ void AI_ui_create_screen(void) {
     start_text_autoscroll();
     
     // 创建按钮处理定时器
-    ui_data.button_timer = lv_timer_create(button_event_timer_cb, 50, NULL);
+    ui_data.button_timer = lv_timer_create(button_event_timer_cb_traced, 50, NULL);
     
     // 设置为活动状态
     ui_data.is_active = true;
@@ -278,7 +282,7 @@ void AI_ui_create_screen(void) {
     init_ai_communication();
     
     // 使用过渡动画加载屏幕
-    lv_scr_load_anim(ui_data.screen, LV_SCR_LOAD_ANIM_FADE_IN, ANIM_TIME_DEFAULT, 0, false);
+    ui_transition_load_screen(ui_data.screen, ANIM_FADE, ANIM_TIME_DEFAULT, 0, false);
 }
 
 // 按钮事件处理回调 (修改)
@@ -367,7 +371,7 @@ static void start_text_autoscroll(void) {
     // 只有当文本高度超过容器高度时才需要滚动
     if (text_height > container_height) {
         // 创建定时器来执行垂直滚动
-        ui_data.scroll_timer = lv_timer_create(scroll_text_timer_cb, 50, NULL);
+        ui_data.scroll_timer = lv_timer_create(scroll_text_timer_cb_traced, 50, NULL);
     }
 }
 
@@ -413,7 +417,7 @@ static void return_to_menu(void) {
     menu_ui_create_screen();
     
     // 使用与其他界面一致的动画切换屏幕
-    lv_scr_load_anim(lv_scr_act(), LV_SCR_LOAD_ANIM_FADE_OUT, 300, 0, true);
+    ui_transition_load_screen(lv_scr_act(), ANIM_FADE, 300, 0, true);
     
     // 激活菜单
     menu_ui_set_active();
@@ -435,7 +439,7 @@ static void init_ai_communication(void) {
     ai_comm_manager_register_callback(ai_message_callback, NULL);
     
     // 创建UDP处理定时器 - 使用更低频率降低CPU负载
-    ui_data.udp_timer = lv_timer_create(process_udp_messages, 200, NULL);
+    ui_data.udp_timer = lv_timer_create(process_udp_messages_traced, 200, NULL);
     
     // 发送初始化状态消息
     const char *init_message = "{\"type\":\"ai_status\",\"status\":\"ready\"}";
@@ -448,7 +452,7 @@ void AI_ui_set_active(void) {
     
     // 恢复按钮定时器
     if (!ui_data.button_timer) {
-        ui_data.button_timer = lv_timer_create(button_event_timer_cb, 50, NULL);
+        ui_data.button_timer = lv_timer_create(button_event_timer_cb_traced, 50, NULL);
     }
     
     // 恢复文本滚动
@@ -458,7 +462,7 @@ void AI_ui_set_active(void) {
     
     // 恢复UDP通信定时器
     if (!ui_data.udp_timer) {
-        ui_data.udp_timer = lv_timer_create(process_udp_messages, 100, NULL);
+        ui_data.udp_timer = lv_timer_create(process_udp_messages_traced, 100, NULL);
     }
 }
 
@@ -3,6 +3,7 @@
 #include "../core/ui_manager.h" // 添加UI管理器头文件
 #include "../core/key355.h"     // 添加按钮处理头文件
 #include "../utils/ui_utils.h"
+#include "../utils/ui_transition.h"
 #include <stdio.h>
 #include <math.h>   // 添加math.h头文件，解决fabs函数未声明问题
 #include "menu_ui.h" // 添加菜单UI头文件
@@ -39,6 +40,8 @@ static struct {
 // 函数前向声明
 static void _update_ui_data(lv_timer_t *timer);
 static void _button_handler_cb(lv_timer_t *timer);
+UI_PROFILER_TIMER_CB(_update_ui_data, "cpu_ui/update")
+UI_PROFILER_TIMER_CB(_button_handler_cb, "cpu_ui/button")
 static void _create_smooth_bar_animation(lv_obj_t *bar, int32_t start_value, int32_t end_value);
 
 // 切换屏幕的动画回调
@@ -69,8 +72,8 @@ static void _return_to_menu(void) {
     // 创建菜单屏幕（但还不显示）
     menu_ui_create_screen();
     
-    // 使用LVGL内置的屏幕切换动画 - 从左向右滑动效果
-    lv_scr_load_anim(lv_scr_act(), LV_SCR_LOAD_ANIM_MOVE_RIGHT, 500, 0, true); // 最后参数true表示自动删除旧屏幕
+    // 使用快照过渡切换屏幕 - 从左向右滑动效果
+    ui_transition_load_screen(lv_scr_act(), ANIM_SLIDE_RIGHT, 500, 0, true); // 最后参数true表示自动删除旧屏幕
     
     // 激活菜单
     menu_ui_set_active();
@@ -562,10 +565,10 @@ void cpu_ui_create_screen(void) {
     lv_anim_start(&a_x);
     
     // 创建按钮处理定时器
-    ui_data.button_timer = lv_timer_create(_button_handler_cb, 100, NULL);
+    ui_data.button_timer = lv_timer_create(_button_handler_cb_traced, 100, NULL);
     
     // 创建数据更新定时器
-    ui_data.update_timer = lv_timer_create(_update_ui_data, 300, NULL);
+    ui_data.update_timer = lv_timer_create(_update_ui_data_traced, 300, NULL);
     
     // 设置为活动状态
     ui_data.is_active = true;
@@ -574,6 +577,6 @@ void cpu_ui_create_screen(void) {
     ui_cache.first_update = true;
     _update_ui_data(NULL);
     
-    // 直接使用LVGL内置的屏幕切换动画 
-    lv_scr_load_anim(ui_data.screen, LV_SCR_LOAD_ANIM_FADE_IN, 500, 0, true);
+    // 使用快照过渡切换屏幕
+    ui_transition_load_screen(ui_data.screen, ANIM_FADE, 500, 0, true);
 }
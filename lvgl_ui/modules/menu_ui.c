@@ -3,6 +3,7 @@
 #include "cpu_ui.h" 
 #include "music_ui.h"
 #include "AI_ui.h" // 添加AI UI头文件引用
+#include "../utils/ui_transition.h"
 
 // 私有数据结构
 typedef struct {
@@ -417,6 +418,7 @@ static void _button_handler_cb(lv_timer_t *timer) {
             break;
     }
 }
+UI_PROFILER_TIMER_CB(_button_handler_cb, "menu_ui/button")
 
 // 创建菜单屏幕 - 苹果风格优化版
 void menu_ui_create_screen(void) {
@@ -571,7 +573,7 @@ void menu_ui_create_screen(void) {
     ui_data.current_index = 0;
     
     // 创建按钮检测定时器
-    ui_data.button_timer = lv_timer_create(_button_handler_cb, 50, NULL);
+    ui_data.button_timer = lv_timer_create(_button_handler_cb_traced, 50, NULL);
     
     // 设置菜单激活状态
     ui_data.is_active = true;
@@ -591,10 +593,10 @@ void menu_ui_create_screen(void) {
     // 根据是否从其他页面返回选择加载方式
     if (from_other_screen) {
         // 从其他页面返回时使用
-        lv_scr_load_anim(ui_data.screen, LV_SCR_LOAD_ANIM_FADE_ON, 500, 0, true);
+        ui_transition_load_screen(ui_data.screen, ANIM_FADE, 500, 0, true);
     } else {
         // 首次加载时使用淡入效果
-        lv_scr_load_anim(ui_data.screen, LV_SCR_LOAD_ANIM_FADE_IN, 500, 0, true);
+        ui_transition_load_screen(ui_data.screen, ANIM_FADE, 500, 0, true);
     }
 }
 
@@ -609,7 +611,7 @@ void menu_ui_set_active(void) {
         lv_timer_reset(ui_data.button_timer); // 重置定时器，确保它立即开始工作
     } else {
         // 如果定时器不存在，创建一个新的
-        ui_data.button_timer = lv_timer_create(_button_handler_cb, 50, NULL);
+        ui_data.button_timer = lv_timer_create(_button_handler_cb_traced, 50, NULL);
     }
     
     // 更新高亮显示并滚动到正确位置
@@ -1,5 +1,6 @@
 #include "music_ui.h"
 #include "menu_ui.h"
+#include "../utils/ui_transition.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -54,6 +55,8 @@ static void return_to_menu(void);
 static void button_event_timer_cb(lv_timer_t *timer);
 static void start_lyrics_autoscroll(void);
 static void scroll_lyrics_timer_cb(lv_timer_t *timer);
+UI_PROFILER_TIMER_CB(button_event_timer_cb, "music_ui/button")
+UI_PROFILER_TIMER_CB(scroll_lyrics_timer_cb, "music_ui/scroll")
 
 // 简化版的音乐界面创建函数
 void music_ui_create_screen(void) {
@@ -164,13 +167,13 @@ void music_ui_create_screen(void) {
     start_lyrics_autoscroll();
     
     // 创建按钮处理定时器
-    ui_data.button_timer = lv_timer_create(button_event_timer_cb, 50, NULL);
+    ui_data.button_timer = lv_timer_create(button_event_timer_cb_traced, 50, NULL);
     
     // 设置为活动状态
     ui_data.is_active = true;
     
     // 使用过渡动画加载屏幕
-    lv_scr_load_anim(ui_data.screen, LV_SCR_LOAD_ANIM_FADE_IN, ANIM_TIME_DEFAULT, 0, false);
+    ui_transition_load_screen(ui_data.screen, ANIM_FADE, ANIM_TIME_DEFAULT, 0, false);
 }
 
 // 按钮事件处理回调
@@ -247,7 +250,7 @@ static void start_lyrics_autoscroll(void) {
     // 只有当文本高度超过容器高度时才需要滚动
     if (text_height > container_height) {
         // 创建定时器来执行垂直滚动
-        ui_data.scroll_timer = lv_timer_create(scroll_lyrics_timer_cb, 50, NULL);
+        ui_data.scroll_timer = lv_timer_create(scroll_lyrics_timer_cb_traced, 50, NULL);
     }
 }
 
@@ -275,7 +278,7 @@ static void return_to_menu(void) {
     menu_ui_create_screen();
     
     // 使用动画切换屏幕
-    lv_scr_load_anim(lv_scr_act(), LV_SCR_LOAD_ANIM_FADE_IN, 500, 0, true);
+    ui_transition_load_screen(lv_scr_act(), ANIM_FADE, 500, 0, true);
     
     // 激活菜单
     menu_ui_set_active();
@@ -287,7 +290,7 @@ void music_ui_set_active(void) {
     
     // 恢复按钮定时器
     if (!ui_data.button_timer) {
-        ui_data.button_timer = lv_timer_create(button_event_timer_cb, 50, NULL);
+        ui_data.button_timer = lv_timer_create(button_event_timer_cb_traced, 50, NULL);
     }
     
     // 恢复歌词滚动
@@ -2,6 +2,7 @@
 #include "menu_ui.h"
 #include "../core/key355.h"
 #include "../core/data_manager.h"
+#include "../utils/ui_transition.h"
 #include <stdio.h>
 
 // Private data structure
@@ -88,6 +89,10 @@ static void _arc_animation_cb(lv_timer_t *timer) {
     lv_arc_set_angles(ui_data.memory_arc, memory_start, memory_end);
 }
 
+UI_PROFILER_TIMER_CB(_arc_animation_cb, "storage_ui/arc")
+UI_PROFILER_TIMER_CB(_update_ui_data, "storage_ui/update")
+UI_PROFILER_TIMER_CB(_button_handler_cb, "storage_ui/button")
+
 // Start arc animation effect
 static void _start_arc_animation(void) {
     if (!animation_active) {
@@ -101,7 +106,7 @@ static void _start_arc_animation(void) {
         
         // Create animation timer
         if (arc_animation_timer == NULL) {
-            arc_animation_timer = lv_timer_create(_arc_animation_cb, 16, NULL); // Approx. 60FPS
+            arc_animation_timer = lv_timer_create(_arc_animation_cb_traced, 16, NULL); // Approx. 60FPS
         } else {
             lv_timer_resume(arc_animation_timer);
         }
@@ -184,8 +189,8 @@ static void _return_to_menu(void) {
     // 创建菜单屏幕（但还不显示）
     menu_ui_create_screen();
     
-    // 使用LVGL内置的屏幕切换动画 - 从左向右滑动效果（返回感觉）
-    lv_scr_load_anim(lv_scr_act(), LV_SCR_LOAD_ANIM_MOVE_RIGHT, 500, 0, true); // 最后参数true表示自动删除旧屏幕
+    // 使用快照过渡切换屏幕 - 从左向右滑动效果（返回感觉）
+    ui_transition_load_screen(lv_scr_act(), ANIM_SLIDE_RIGHT, 500, 0, true); // 最后参数true表示自动删除旧屏幕
     
     // 激活菜单
     menu_ui_set_active();
@@ -411,10 +416,10 @@ void storage_ui_create_screen(void) {
     lv_anim_start(&a_x);
     
     // Create button handler timer
-    ui_data.button_timer = lv_timer_create(_button_handler_cb, 50, NULL);
+    ui_data.button_timer = lv_timer_create(_button_handler_cb_traced, 50, NULL);
     
     // Create data update timer (update every 500ms)
-    ui_data.update_timer = lv_timer_create(_update_ui_data, 500, NULL);
+    ui_data.update_timer = lv_timer_create(_update_ui_data_traced, 500, NULL);
     
     // Set as active
     ui_data.is_active = true;
@@ -426,6 +431,6 @@ void storage_ui_create_screen(void) {
     // Start arc animation effect
     _start_arc_animation();
     
-    // 直接使用LVGL内置的屏幕切换动画 - 淡入效果
-    lv_scr_load_anim(ui_data.screen, LV_SCR_LOAD_ANIM_FADE_IN, 500, 0, true);
+    // 使用快照过渡切换屏幕 - 淡入效果
+    ui_transition_load_screen(ui_data.screen, ANIM_FADE, 500, 0, true);
 }
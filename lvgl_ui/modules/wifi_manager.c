@@ -299,6 +299,7 @@ static void wifi_check_timer_cb(lv_timer_t *timer) {
         last_check_time = now;
     }
 }
+UI_PROFILER_TIMER_CB(wifi_check_timer_cb, "wifi_manager")
 
 // WiFi状态变化回调函数 - 通知UI
 void wifi_status_changed_callback(wifi_state_t new_state, const char *ssid) {
@@ -331,7 +332,7 @@ void wifi_manager_init(void) {
     last_check_time = time(NULL);
     
     // 创建定时器定期检查WiFi状态
-    wifi_check_timer = lv_timer_create(wifi_check_timer_cb, CHECK_INTERVAL * 1000, NULL);
+    wifi_check_timer = lv_timer_create(wifi_check_timer_cb_traced, CHECK_INTERVAL * 1000, NULL);
     
     wifi_initialized = true;
     
@@ -0,0 +1,466 @@
+/**
+ * @file ui_transition.c
+ * @brief 快照过渡引擎实现
+ *
+ * 实时过渡每帧都要以半透明/位移/缩放重新渲染两棵完整的控件树(包括lottie)，
+ * 这里改为在开始时各截取一次快照，之后只对两张图片做混合。
+ */
+
+#include "ui_transition.h"
+#include "ui_utils.h"
+#include <stdlib.h>
+
+#if !LV_USE_SNAPSHOT
+#error "ui_transition需要在lv_conf.h中启用LV_USE_SNAPSHOT"
+#endif
+
+// 快照颜色格式 - 与屏幕的RGB565一致，混合时只需直接拷贝
+#define TRANS_SNAPSHOT_CF   LV_COLOR_FORMAT_RGB565
+// 缩放类过渡的缩放幅度(与实时动画的 LV_ZOOM_NONE - 30 一致)
+#define TRANS_SCALE_DELTA   30
+// 动画进度的最大值
+#define TRANS_PROGRESS_MAX  1024
+
+// 过渡数据结构
+typedef struct {
+    lv_obj_t *overlay;          // 顶层覆盖层，承载两张快照图片并拦截输入
+    lv_obj_t *old_img;          // 旧屏幕/页面的快照图片
+    lv_obj_t *new_img;          // 新屏幕/页面的快照图片
+    lv_draw_buf_t *old_buf;     // 旧快照缓冲区
+    lv_draw_buf_t *new_buf;     // 新快照缓冲区
+    lv_area_t old_area;         // 旧快照的屏幕坐标
+    lv_area_t new_area;         // 新快照的屏幕坐标
+    lv_obj_t *old_obj;          // 真实的旧屏幕/页面(被删除时置NULL)
+    lv_obj_t *new_obj;          // 真实的新屏幕/页面(被删除时置NULL)
+    ui_anim_type_t type;        // 动画类型
+    int32_t dist_x;             // 水平滑动距离
+    int32_t dist_y;             // 垂直滑动距离
+    bool is_screen;             // 屏幕切换(结束时加载新屏幕)还是页面切换
+    bool destroy_old;           // 结束后是否删除旧对象
+    lv_anim_ready_cb_t user_cb; // 用户回调函数
+} ui_transition_t;
+
+// 当前正在进行的过渡，同一时间只有一个
+static ui_transition_t *active_trans = NULL;
+
+// 缩放过渡数据结构
+typedef struct {
+    lv_obj_t *obj;                  // 被缩放的对象
+    lv_area_t from;                 // 起始区域(屏幕坐标)
+    lv_area_t to;                   // 目标区域(屏幕坐标)
+    bool translate_x;               // 宽度不变时水平方向只能用translate移动
+    bool translate_y;               // 高度不变时垂直方向只能用translate移动
+    bool render_cache_ori;          // 对象原来的渲染缓存设置
+    lv_anim_completed_cb_t ready_cb; // 用户回调函数
+    void *user_data;                // 用户数据
+} ui_zoom_data_t;
+
+// 真实对象在过渡期间被删除时清除引用
+static void _trans_obj_delete_cb(lv_event_t *e) {
+    ui_transition_t *t = (ui_transition_t *)lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+
+    if (t->old_obj == obj) t->old_obj = NULL;
+    if (t->new_obj == obj) t->new_obj = NULL;
+}
+
+// 截取对象的快照并创建对应的图片，失败时返回NULL
+static lv_obj_t *_trans_create_image(ui_transition_t *t, lv_obj_t *obj, lv_draw_buf_t **buf, lv_area_t *area) {
+    // 快照会按当前布局绘制，隐藏的页面需要先显示出来
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+
+    *buf = lv_snapshot_take(obj, TRANS_SNAPSHOT_CF);
+    if (*buf == NULL) return NULL;
+
+    // 快照包含对象的扩展绘制区域(阴影等)，四周各多出 ext 像素
+    int32_t ext = ((int32_t)(*buf)->header.w - lv_obj_get_width(obj)) / 2;
+    lv_obj_get_coords(obj, area);
+    lv_area_increase(area, ext, ext);
+
+    lv_obj_t *img = lv_image_create(t->overlay);
+    lv_image_set_src(img, *buf);
+    lv_obj_set_pos(img, area->x1, area->y1);
+    lv_image_set_pivot(img, (*buf)->header.w / 2, (*buf)->header.h / 2);
+    lv_obj_add_event_cb(obj, _trans_obj_delete_cb, LV_EVENT_DELETE, t);
+    return img;
+}
+
+// 释放快照图片和缓冲区
+static void _trans_free_images(ui_transition_t *t) {
+    // 先删除图片，再释放它们引用的缓冲区
+    if (t->overlay) {
+        lv_obj_delete(t->overlay);
+        t->overlay = NULL;
+    }
+
+    if (t->old_buf) {
+        lv_image_cache_drop(t->old_buf);
+        lv_draw_buf_destroy(t->old_buf);
+        t->old_buf = NULL;
+    }
+
+    if (t->new_buf) {
+        lv_image_cache_drop(t->new_buf);
+        lv_draw_buf_destroy(t->new_buf);
+        t->new_buf = NULL;
+    }
+
+    if (t->old_obj) lv_obj_remove_event_cb_with_user_data(t->old_obj, _trans_obj_delete_cb, t);
+    if (t->new_obj) lv_obj_remove_event_cb_with_user_data(t->new_obj, _trans_obj_delete_cb, t);
+}
+
+// 动画帧回调 - 只更新两张快照图片的位置、透明度和缩放
+static void _trans_anim_cb(void *var, int32_t v) {
+    ui_transition_t *t = (ui_transition_t *)var;
+
+    int32_t old_dx = 0, old_dy = 0;
+    int32_t new_dx = 0, new_dy = 0;
+    int32_t old_opa = LV_OPA_COVER;
+    int32_t new_opa = LV_OPA_COVER;
+    int32_t old_scale = LV_SCALE_NONE;
+    int32_t new_scale = LV_SCALE_NONE;
+
+    switch (t->type) {
+        case ANIM_FADE:
+            new_opa = v * LV_OPA_COVER / TRANS_PROGRESS_MAX;
+            // 全屏快照不透明，新屏幕直接盖在旧屏幕上即可
+            old_opa = t->is_screen ? LV_OPA_COVER : LV_OPA_COVER - new_opa;
+            break;
+
+        case ANIM_SLIDE_LEFT:
+        case ANIM_SPRING:
+            old_dx = -t->dist_x * v / TRANS_PROGRESS_MAX;
+            new_dx = old_dx + t->dist_x;
+            break;
+
+        case ANIM_SLIDE_RIGHT:
+            old_dx = t->dist_x * v / TRANS_PROGRESS_MAX;
+            new_dx = old_dx - t->dist_x;
+            break;
+
+        case ANIM_SLIDE_TOP:
+            old_dy = -t->dist_y * v / TRANS_PROGRESS_MAX;
+            new_dy = old_dy + t->dist_y;
+            break;
+
+        case ANIM_SLIDE_BOTTOM:
+            old_dy = t->dist_y * v / TRANS_PROGRESS_MAX;
+            new_dy = old_dy - t->dist_y;
+            break;
+
+        case ANIM_ZOOM:
+        case ANIM_FADE_SCALE:
+        default:
+            new_opa = v * LV_OPA_COVER / TRANS_PROGRESS_MAX;
+            old_opa = LV_OPA_COVER - new_opa;
+            old_scale = LV_SCALE_NONE - TRANS_SCALE_DELTA * v / TRANS_PROGRESS_MAX;
+            new_scale = LV_SCALE_NONE - TRANS_SCALE_DELTA + TRANS_SCALE_DELTA * v / TRANS_PROGRESS_MAX;
+            break;
+    }
+
+    // 使用图片自身的透明度和缩放，避免为对象透明度创建额外的图层
+    if (t->old_img) {
+        lv_obj_set_pos(t->old_img, t->old_area.x1 + old_dx, t->old_area.y1 + old_dy);
+        lv_obj_set_style_image_opa(t->old_img, LV_CLAMP(LV_OPA_TRANSP, old_opa, LV_OPA_COVER), 0);
+        lv_image_set_scale(t->old_img, old_scale);
+    }
+
+    if (t->new_img) {
+        lv_obj_set_pos(t->new_img, t->new_area.x1 + new_dx, t->new_area.y1 + new_dy);
+        lv_obj_set_style_image_opa(t->new_img, LV_CLAMP(LV_OPA_TRANSP, new_opa, LV_OPA_COVER), 0);
+        lv_image_set_scale(t->new_img, new_scale);
+    }
+}
+
+// 结束过渡 - 换回真实的控件树并释放快照
+static void _trans_complete(ui_transition_t *t) {
+    if (active_trans == t) active_trans = NULL;
+
+    lv_anim_delete(t, NULL);
+    _trans_free_images(t);
+
+    lv_obj_t *old_obj = t->old_obj;
+    lv_obj_t *new_obj = t->new_obj;
+
+    if (t->is_screen) {
+        if (old_obj) lv_obj_clear_flag(old_obj, LV_OBJ_FLAG_HIDDEN);
+        if (new_obj) lv_screen_load(new_obj);
+    } else {
+        if (new_obj) lv_obj_clear_flag(new_obj, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    // 执行用户回调，a->var 与实时动画一致指向页面
+    if (t->user_cb) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        a.var = new_obj ? new_obj : old_obj;
+        t->user_cb(&a);
+    }
+
+    // 页面不删除时保持隐藏，与退出动画后的不可见状态一致
+    if (old_obj && t->destroy_old && old_obj != new_obj) {
+        lv_obj_delete(old_obj);
+    }
+
+    free(t);
+}
+
+static void _trans_anim_completed_cb(lv_anim_t *a) {
+    _trans_complete((ui_transition_t *)a->var);
+}
+
+// 动画路径与原实时过渡保持一致
+static lv_anim_path_cb_t _trans_get_path(ui_anim_type_t type) {
+    switch (type) {
+        case ANIM_FADE:
+            return lv_anim_path_ease_in;
+        case ANIM_SPRING:
+            return ui_utils_anim_path_overshoot;
+        default:
+            return lv_anim_path_ease_out;
+    }
+}
+
+// 截取快照并启动过渡动画，快照失败时返回NULL且不改变任何对象
+static ui_transition_t *_trans_start(lv_obj_t *old_obj, lv_obj_t *new_obj, ui_anim_type_t anim_type,
+                                     uint32_t duration_ms, uint32_t delay_ms, bool is_screen) {
+    // 同一时间只保留一个过渡，先完成上一个
+    ui_transition_finish();
+
+    ui_transition_t *t = (ui_transition_t *)calloc(1, sizeof(ui_transition_t));
+    if (!t) return NULL;
+
+    t->type = anim_type;
+    t->is_screen = is_screen;
+    t->dist_x = lv_display_get_horizontal_resolution(NULL);
+    t->dist_y = lv_display_get_vertical_resolution(NULL);
+
+    // 覆盖整个屏幕的容器，屏幕切换时用黑色背景填补缩放留下的空隙
+    t->overlay = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(t->overlay);
+    lv_obj_set_size(t->overlay, t->dist_x, t->dist_y);
+    lv_obj_clear_flag(t->overlay, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(t->overlay, LV_OBJ_FLAG_CLICKABLE);
+    if (is_screen) {
+        lv_obj_set_style_bg_color(t->overlay, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(t->overlay, LV_OPA_COVER, 0);
+    }
+
+    if (old_obj) {
+        t->old_img = _trans_create_image(t, old_obj, &t->old_buf, &t->old_area);
+        if (!t->old_img) goto fail;
+        t->old_obj = old_obj;
+    }
+
+    if (new_obj) {
+        t->new_img = _trans_create_image(t, new_obj, &t->new_buf, &t->new_area);
+        if (!t->new_img) goto fail;
+        t->new_obj = new_obj;
+    }
+
+    // 过渡期间只绘制快照，真实的控件树不再参与渲染
+    if (old_obj) lv_obj_add_flag(old_obj, LV_OBJ_FLAG_HIDDEN);
+    if (new_obj && !is_screen) lv_obj_add_flag(new_obj, LV_OBJ_FLAG_HIDDEN);
+
+    _trans_anim_cb(t, 0);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, t);
+    lv_anim_set_values(&a, 0, TRANS_PROGRESS_MAX);
+    lv_anim_set_exec_cb(&a, _trans_anim_cb);
+    lv_anim_set_path_cb(&a, _trans_get_path(anim_type));
+    lv_anim_set_time(&a, duration_ms);
+    lv_anim_set_delay(&a, delay_ms);
+    lv_anim_set_completed_cb(&a, _trans_anim_completed_cb);
+    lv_anim_start(&a);
+
+    active_trans = t;
+    return t;
+
+fail:
+    LV_LOG_WARN("ui_transition: snapshot failed, falling back to live animation");
+    _trans_free_images(t);
+    free(t);
+    return NULL;
+}
+
+// 计算缩放的固定点：以它为中心缩放时，对象的两条边同时线性地移动到目标位置
+// 这样整个过程只需要改变缩放比例，不需要每帧修改translate(会触发重新布局)
+static int32_t _zoom_get_pivot(int32_t from_start, int32_t from_len, int32_t to_start, int32_t to_len) {
+    return (int32_t)((int64_t)(from_start - to_start) * from_len / (to_len - from_len));
+}
+
+// 缩放动画帧回调 - 只修改变换样式
+static void _zoom_anim_cb(void *var, int32_t v) {
+    ui_zoom_data_t *z = (ui_zoom_data_t *)var;
+
+    int32_t from_w = lv_area_get_width(&z->from);
+    int32_t from_h = lv_area_get_height(&z->from);
+    int32_t w = lv_map(v, 0, TRANS_PROGRESS_MAX, from_w, lv_area_get_width(&z->to));
+    int32_t h = lv_map(v, 0, TRANS_PROGRESS_MAX, from_h, lv_area_get_height(&z->to));
+
+    lv_obj_set_style_transform_scale_x(z->obj, w * LV_SCALE_NONE / from_w, 0);
+    lv_obj_set_style_transform_scale_y(z->obj, h * LV_SCALE_NONE / from_h, 0);
+
+    if (z->translate_x) {
+        lv_obj_set_style_translate_x(z->obj, lv_map(v, 0, TRANS_PROGRESS_MAX, 0, z->to.x1 - z->from.x1), 0);
+    }
+
+    if (z->translate_y) {
+        lv_obj_set_style_translate_y(z->obj, lv_map(v, 0, TRANS_PROGRESS_MAX, 0, z->to.y1 - z->from.y1), 0);
+    }
+}
+
+// 对象在缩放过程中被删除时停止动画
+static void _zoom_obj_delete_cb(lv_event_t *e) {
+    ui_zoom_data_t *z = (ui_zoom_data_t *)lv_event_get_user_data(e);
+    lv_anim_delete(z, NULL);
+    free(z);
+}
+
+// 缩放动画完成回调 - 一次性提交最终的位置和尺寸
+static void _zoom_anim_completed_cb(lv_anim_t *a) {
+    ui_zoom_data_t *z = (ui_zoom_data_t *)a->var;
+    lv_obj_t *obj = z->obj;
+    lv_obj_remove_event_cb_with_user_data(obj, _zoom_obj_delete_cb, z);
+
+    static const lv_style_prop_t transform_props[] = {
+        LV_STYLE_TRANSFORM_SCALE_X, LV_STYLE_TRANSFORM_SCALE_Y,
+        LV_STYLE_TRANSFORM_PIVOT_X, LV_STYLE_TRANSFORM_PIVOT_Y,
+        LV_STYLE_TRANSLATE_X, LV_STYLE_TRANSLATE_Y,
+    };
+    for (uint32_t i = 0; i < sizeof(transform_props) / sizeof(transform_props[0]); i++) {
+        lv_obj_remove_local_style_prop(obj, transform_props[i], 0);
+    }
+
+    lv_obj_t *parent = lv_obj_get_parent(obj);
+    lv_area_t parent_coords;
+    lv_obj_get_coords(parent, &parent_coords);
+    lv_obj_set_pos(obj, z->to.x1 - parent_coords.x1, z->to.y1 - parent_coords.y1);
+    lv_obj_set_size(obj, lv_area_get_width(&z->to), lv_area_get_height(&z->to));
+    lv_obj_set_render_cache(obj, z->render_cache_ori);
+
+    if (z->ready_cb) {
+        lv_anim_t a_cb;
+        lv_anim_init(&a_cb);
+        a_cb.var = obj;
+        a_cb.user_data = z->user_data;
+        z->ready_cb(&a_cb);
+    }
+
+    free(z);
+}
+
+// 基于变换的缩放过渡
+void ui_transition_zoom_obj(lv_obj_t *obj, const lv_area_t *to_area, uint32_t duration_ms, lv_anim_path_cb_t path_cb, lv_anim_completed_cb_t ready_cb, void *user_data) {
+    if (obj == NULL || to_area == NULL) return;
+
+    ui_zoom_data_t *z = (ui_zoom_data_t *)calloc(1, sizeof(ui_zoom_data_t));
+    if (!z) return;
+
+    lv_obj_update_layout(obj);
+    z->obj = obj;
+    lv_obj_get_coords(obj, &z->from);
+    z->to = *to_area;
+    z->ready_cb = ready_cb;
+    z->user_data = user_data;
+
+    if (lv_area_get_width(&z->from) <= 0 || lv_area_get_height(&z->from) <= 0) {
+        free(z);
+        return;
+    }
+
+    // 以固定点为中心缩放，尺寸不变的方向才需要translate
+    int32_t from_w = lv_area_get_width(&z->from);
+    int32_t from_h = lv_area_get_height(&z->from);
+    int32_t to_w = lv_area_get_width(&z->to);
+    int32_t to_h = lv_area_get_height(&z->to);
+    z->translate_x = (to_w == from_w);
+    z->translate_y = (to_h == from_h);
+    lv_obj_set_style_transform_pivot_x(obj, z->translate_x ? 0 : _zoom_get_pivot(z->from.x1, from_w, z->to.x1, to_w), 0);
+    lv_obj_set_style_transform_pivot_y(obj, z->translate_y ? 0 : _zoom_get_pivot(z->from.y1, from_h, z->to.y1, to_h), 0);
+
+    // 过渡期间对象内容不变，缓存渲染结果后每帧只需变换一张位图
+    z->render_cache_ori = lv_obj_get_render_cache(obj);
+    lv_obj_set_render_cache(obj, true);
+
+    lv_obj_add_event_cb(obj, _zoom_obj_delete_cb, LV_EVENT_DELETE, z);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, z);
+    lv_anim_set_values(&a, 0, TRANS_PROGRESS_MAX);
+    lv_anim_set_exec_cb(&a, _zoom_anim_cb);
+    lv_anim_set_path_cb(&a, path_cb ? path_cb : lv_anim_path_ease_out);
+    lv_anim_set_time(&a, duration_ms);
+    lv_anim_set_completed_cb(&a, _zoom_anim_completed_cb);
+    lv_anim_start(&a);
+}
+
+// 快照不可用时使用的LVGL屏幕切换动画
+static lv_screen_load_anim_t _trans_to_lv_anim(ui_anim_type_t anim_type) {
+    switch (anim_type) {
+        case ANIM_NONE:
+            return LV_SCR_LOAD_ANIM_NONE;
+        case ANIM_SLIDE_LEFT:
+        case ANIM_SPRING:
+            return LV_SCR_LOAD_ANIM_MOVE_LEFT;
+        case ANIM_SLIDE_RIGHT:
+            return LV_SCR_LOAD_ANIM_MOVE_RIGHT;
+        case ANIM_SLIDE_TOP:
+            return LV_SCR_LOAD_ANIM_MOVE_TOP;
+        case ANIM_SLIDE_BOTTOM:
+            return LV_SCR_LOAD_ANIM_MOVE_BOTTOM;
+        default:
+            return LV_SCR_LOAD_ANIM_FADE_IN;
+    }
+}
+
+// 带快照过渡动画的屏幕切换
+void ui_transition_load_screen(lv_obj_t *new_scr, ui_anim_type_t anim_type, uint32_t duration_ms, uint32_t delay_ms, bool auto_del) {
+    if (new_scr == NULL) return;
+
+    // 已经是当前屏幕或正在切换到该屏幕
+    if (active_trans && active_trans->is_screen && active_trans->new_obj == new_scr) return;
+    lv_obj_t *old_scr = lv_screen_active();
+    if (old_scr == new_scr) return;
+
+    if (anim_type == ANIM_NONE || (duration_ms == 0 && delay_ms == 0)) {
+        ui_transition_finish();
+        lv_screen_load_anim(new_scr, LV_SCR_LOAD_ANIM_NONE, 0, delay_ms, auto_del);
+        return;
+    }
+
+    ui_transition_t *t = _trans_start(old_scr, new_scr, anim_type, duration_ms, delay_ms, true);
+    if (t) {
+        t->destroy_old = auto_del;
+    } else {
+        lv_screen_load_anim(new_scr, _trans_to_lv_anim(anim_type), duration_ms, delay_ms, auto_del);
+    }
+}
+
+// 带快照过渡动画的页面切换
+bool ui_transition_pages(lv_obj_t *old_page, lv_obj_t *new_page, ui_anim_type_t anim_type, uint32_t duration_ms, bool destroy_old, lv_anim_ready_cb_t user_cb) {
+    if (old_page == NULL && new_page == NULL) return false;
+    if (anim_type == ANIM_NONE) return false;
+
+    ui_transition_t *t = _trans_start(old_page, new_page, anim_type, duration_ms, 0, false);
+    if (!t) return false;
+
+    t->destroy_old = destroy_old;
+    t->user_cb = user_cb;
+    return true;
+}
+
+// 立即完成正在进行的过渡
+void ui_transition_finish(void) {
+    if (active_trans) {
+        _trans_complete(active_trans);
+    }
+}
+
+// 判断是否有过渡正在进行
+bool ui_transition_is_running(void) {
+    return active_trans != NULL;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ui_transition.h
+ * @brief 快照过渡引擎 - 过渡期间只移动两张位图，不再逐帧重绘控件树
+ *
+ * 过渡开始时把旧/新屏幕(或页面)各渲染一次到RGB565缓冲区，
+ * 动画过程中只对这两张快照做淡入淡出、滑动或缩放，
+ * 结束时再切换回真实的控件树。每帧开销约等于两次图像混合。
+ */
+
+#ifndef UI_TRANSITION_H
+#define UI_TRANSITION_H
+
+#include "../common.h"
+
+/**
+ * 带快照过渡动画的屏幕切换 - 替代 lv_scr_load_anim
+ * 快照申请失败时自动退回到LVGL自带的屏幕切换动画
+ * @param new_scr 新屏幕对象
+ * @param anim_type 动画类型(参见ui_anim_type_t)
+ * @param duration_ms 动画持续时间(ms)
+ * @param delay_ms 动画开始前的延迟(ms)，屏幕内容在调用时截取
+ * @param auto_del 是否在切换完成后删除旧屏幕
+ */
+void ui_transition_load_screen(lv_obj_t *new_scr, ui_anim_type_t anim_type, uint32_t duration_ms, uint32_t delay_ms, bool auto_del);
+
+/**
+ * 带快照过渡动画的页面切换
+ * 过渡期间两个页面都被隐藏，结束后新页面恢复显示
+ * @param old_page 旧页面对象(可为NULL，仅播放进入动画)
+ * @param new_page 新页面对象(可为NULL，仅播放退出动画)
+ * @param anim_type 动画类型(参见ui_anim_type_t)
+ * @param duration_ms 动画持续时间(ms)
+ * @param destroy_old 是否在动画结束后销毁旧页面，否则旧页面保持隐藏
+ * @param user_cb 动画完成后的用户回调函数(可为NULL)，a->var 为新页面(仅退出时为旧页面)
+ * @return 是否已开始快照过渡，false时调用者应使用实时动画
+ */
+bool ui_transition_pages(lv_obj_t *old_page, lv_obj_t *new_page, ui_anim_type_t anim_type, uint32_t duration_ms, bool destroy_old, lv_anim_ready_cb_t user_cb);
+
+/**
+ * 基于变换的缩放过渡 - 把对象从当前区域缩放移动到目标区域
+ * 动画过程中只改变 transform_scale(必要时加 translate)，不触发重新布局，
+ * 对象内容通过渲染缓存只渲染一次；位置和尺寸在动画结束时一次性提交
+ * @param obj 要缩放的对象(通常位于顶层)
+ * @param to_area 目标区域(屏幕坐标)
+ * @param duration_ms 动画持续时间(ms)
+ * @param path_cb 动画路径(NULL时使用ease_out)
+ * @param ready_cb 动画完成后的回调函数(可为NULL)，a->var 为对象，a->user_data 为 user_data
+ * @param user_data 传给 ready_cb 的用户数据
+ */
+void ui_transition_zoom_obj(lv_obj_t *obj, const lv_area_t *to_area, uint32_t duration_ms, lv_anim_path_cb_t path_cb, lv_anim_completed_cb_t ready_cb, void *user_data);
+
+/**
+ * 立即完成正在进行的过渡(没有过渡时不做任何事)
+ */
+void ui_transition_finish(void);
+
+/**
+ * 判断是否有过渡正在进行
+ * @return 是否正在过渡
+ */
+bool ui_transition_is_running(void);
+
+#endif // UI_TRANSITION_H
@@ -1,4 +1,5 @@
 #include "ui_utils.h"
+#include "ui_transition.h"
 #include <stdio.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -16,6 +17,10 @@ static void _ui_anim_opacity_cb(void *obj, int32_t value) {
     lv_obj_set_style_opa(obj, value, 0);
 }
 
+static void _ui_anim_opa_layered_cb(void *obj, int32_t value) {
+    lv_obj_set_style_opa_layered(obj, value, 0);
+}
+
 static void _ui_anim_width_cb(void *obj, int32_t value) {
     lv_obj_set_width(obj, value);
 }
@@ -107,6 +112,10 @@ void ui_utils_page_transition(lv_obj_t *old_page, lv_obj_t *new_page, ui_anim_ty
     // 确保新页面存在
     if (new_page == NULL) return;
     
+    // 优先使用快照过渡：每帧只混合两张位图，不再重绘两棵控件树
+    // 快照内存不足或无动画时，使用下面的实时动画
+    if (ui_transition_pages(old_page, new_page, anim_type, duration_ms, destroy_old, user_cb)) return;
+    
     // 获取屏幕尺寸
     lv_coord_t scr_width = lv_display_get_horizontal_resolution(NULL);
     lv_coord_t scr_height = lv_display_get_vertical_resolution(NULL);
@@ -276,6 +285,9 @@ void ui_utils_page_enter_anim(lv_obj_t *page, ui_anim_type_t anim_type, uint32_t
 void ui_utils_page_exit_anim(lv_obj_t *page, ui_anim_type_t anim_type, uint32_t duration_ms, bool destroy, lv_anim_ready_cb_t user_cb) {
     if (page == NULL) return;
     
+    // 优先使用快照过渡，结束后页面被销毁或隐藏
+    if (ui_transition_pages(page, NULL, anim_type, duration_ms, destroy, user_cb)) return;
+    
     ui_page_anim_data_t *exit_data = (ui_page_anim_data_t *)malloc(sizeof(ui_page_anim_data_t));
     if (!exit_data) return;
     
@@ -441,42 +453,6 @@ void ui_utils_screen_transition(lv_obj_t *old_screen, void (*create_new_screen)(
     }
 }
 
-// 颜色过渡动画回调 - 更新菜单背景色为渐变效果
-static void _ui_anim_color_cb(void *var, int32_t v) {
-    lv_obj_t *obj = (lv_obj_t *)var;
-    
-    // 精确控制颜色过渡：从蓝色(0x26a0da)到紫红色(0x9B1842)
-    uint8_t r = lv_map(v, 0, 255, 0x26, 0x9B);
-    uint8_t g = lv_map(v, 0, 255, 0xa0, 0x18);
-    uint8_t b = lv_map(v, 0, 255, 0xda, 0x42);
-    
-    lv_obj_set_style_bg_color(obj, lv_color_make(r, g, b), 0);
-    
-    // 创建动态渐变效果 - 逐渐从无渐变过渡到有渐变
-    if (v > 128) {
-        // 设置渐变颜色并调整渐变强度
-        lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0x000000), 0);
-        lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
-        
-        // 动态调整渐变不透明度，使过渡更平滑
-        lv_opa_t grad_opa = lv_map(v, 129, 255, LV_OPA_10, LV_OPA_40);
-        lv_obj_set_style_bg_grad_opa(obj, grad_opa, 0);
-    }
-}
-
-// 增强玻璃效果动画回调
-static void _ui_anim_glass_effect_cb(void *var, int32_t v) {
-    lv_obj_t *obj = (lv_obj_t *)var;
-    
-    // 动态调整阴影宽度，创造立体感变化
-    uint8_t shadow_width = lv_map(v, 0, 255, 15, 25);
-    lv_obj_set_style_shadow_width(obj, shadow_width, 0);
-    
-    // 动态调整模糊效果
-    uint8_t blur = lv_map(v, 0, 255, 0, 5);
-    lv_obj_set_style_shadow_spread(obj, blur, 0);
-}
-
 // 卡片淡出完成后的回调
 static void _card_fade_ready_cb(lv_anim_t *a) {
     // 删除过渡卡片
@@ -614,6 +590,25 @@ void ui_utils_zoom_transition(lv_obj_t *selected_item, void (*create_screen_func
     lv_color_t item_color = lv_obj_get_style_bg_color(selected_item, 0);
     lv_coord_t item_radius = lv_obj_get_style_radius(selected_item, 0);
     
+    // 目标外观卡片 - 放在过渡卡片下方，直接使用展开后的颜色、渐变和玻璃效果
+    // 过渡卡片淡出时露出它，代替逐帧修改颜色、阴影和圆角
+    // 它没有子对象，直接改变尺寸的开销比缩放一张全屏位图更小
+    lv_obj_t *target_card = lv_obj_create(lv_layer_top());
+    lv_obj_clear_flag(target_card, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_pos(target_card, item_coords.x1, item_coords.y1);
+    lv_obj_set_size(target_card, lv_area_get_width(&item_coords), lv_area_get_height(&item_coords));
+    lv_obj_set_style_border_width(target_card, 0, 0);
+    lv_obj_set_style_radius(target_card, 0, 0);
+    lv_obj_set_style_bg_color(target_card, lv_color_hex(0x9B1842), 0);
+    lv_obj_set_style_bg_opa(target_card, 220, 0);
+    lv_obj_set_style_bg_grad_color(target_card, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_grad_dir(target_card, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_grad_opa(target_card, LV_OPA_40, 0);
+    lv_obj_set_style_shadow_width(target_card, 25, 0);
+    lv_obj_set_style_shadow_spread(target_card, 5, 0);
+    lv_obj_set_style_shadow_color(target_card, lv_color_hex(0x26a0da), 0);
+    lv_obj_set_style_shadow_opa(target_card, LV_OPA_40, 0);
+    
     // 创建一个临时对象作为过渡用的"卡片"
     lv_obj_t *transition_card = lv_obj_create(lv_layer_top());
     lv_obj_set_pos(transition_card, item_coords.x1, item_coords.y1);
@@ -672,99 +667,66 @@ void ui_utils_zoom_transition(lv_obj_t *selected_item, void (*create_screen_func
     lv_coord_t scr_width = lv_display_get_horizontal_resolution(NULL);
     lv_coord_t scr_height = lv_display_get_vertical_resolution(NULL);
     
-    // 计算终点位置，完全覆盖屏幕
-    lv_coord_t end_width = scr_width + 20;
-    lv_coord_t end_height = scr_height + 20;
-    lv_coord_t end_x = -10;
-    lv_coord_t end_y = -10;
+    // 计算终点区域，完全覆盖屏幕
+    lv_area_t end_area;
+    end_area.x1 = -10;
+    end_area.y1 = -10;
+    end_area.x2 = end_area.x1 + scr_width + 20 - 1;
+    end_area.y2 = end_area.y1 + scr_height + 20 - 1;
     
-    // 创建卡片动画序列 - 优化时序
-    lv_anim_t a_pos_x, a_pos_y, a_width, a_height, a_radius, a_color, a_glass;
     uint16_t anim_time = 400; // 增加动画时间使过渡更加平滑
     
-    // 1. 位置X动画 - 使用缓动函数创造更自然的运动
+    // 带内容的过渡卡片只做变换缩放，内容只渲染一次，不再逐帧重新布局；结束时删除
+    ui_transition_zoom_obj(transition_card, &end_area, anim_time, lv_anim_path_ease_out, _card_fade_ready_cb, NULL);
+    
+    // 过渡卡片在前40%的时间内淡出，露出目标颜色，代替原来的颜色渐变和内容淡出
+    // 此时卡片还较小，之后不再绘制放大的位图；opa_layered在混合缓存图像时才应用，不会重新渲染
+    lv_anim_t a_fade;
+    lv_anim_init(&a_fade);
+    lv_anim_set_var(&a_fade, transition_card);
+    lv_anim_set_values(&a_fade, LV_OPA_COVER, LV_OPA_0);
+    lv_anim_set_exec_cb(&a_fade, _ui_anim_opa_layered_cb);
+    lv_anim_set_time(&a_fade, anim_time * 2 / 5);
+    lv_anim_set_path_cb(&a_fade, lv_anim_path_linear);
+    lv_anim_start(&a_fade);
+    
+    // 目标卡片展开到全屏，完成后继续执行屏幕加载
+    lv_anim_t a_pos_x, a_pos_y, a_width, a_height;
+    
     lv_anim_init(&a_pos_x);
-    lv_anim_set_var(&a_pos_x, transition_card);
-    lv_anim_set_values(&a_pos_x, item_coords.x1, end_x);
+    lv_anim_set_var(&a_pos_x, target_card);
+    lv_anim_set_values(&a_pos_x, item_coords.x1, end_area.x1);
     lv_anim_set_exec_cb(&a_pos_x, (lv_anim_exec_xcb_t)lv_obj_set_x);
     lv_anim_set_time(&a_pos_x, anim_time);
     lv_anim_set_path_cb(&a_pos_x, lv_anim_path_ease_out);
     
-    // 2. 位置Y动画
     lv_anim_init(&a_pos_y);
-    lv_anim_set_var(&a_pos_y, transition_card);
-    lv_anim_set_values(&a_pos_y, item_coords.y1, end_y);
+    lv_anim_set_var(&a_pos_y, target_card);
+    lv_anim_set_values(&a_pos_y, item_coords.y1, end_area.y1);
     lv_anim_set_exec_cb(&a_pos_y, (lv_anim_exec_xcb_t)lv_obj_set_y);
     lv_anim_set_time(&a_pos_y, anim_time);
     lv_anim_set_path_cb(&a_pos_y, lv_anim_path_ease_out);
     
-    // 3. 宽度动画 - 稍快的扩展速度
     lv_anim_init(&a_width);
-    lv_anim_set_var(&a_width, transition_card);
-    lv_anim_set_values(&a_width, lv_area_get_width(&item_coords), end_width);
+    lv_anim_set_var(&a_width, target_card);
+    lv_anim_set_values(&a_width, lv_area_get_width(&item_coords), lv_area_get_width(&end_area));
     lv_anim_set_exec_cb(&a_width, (lv_anim_exec_xcb_t)lv_obj_set_width);
-    lv_anim_set_time(&a_width, anim_time - 20); // 略微提前完成
+    lv_anim_set_time(&a_width, anim_time);
     lv_anim_set_path_cb(&a_width, lv_anim_path_ease_out);
     
-    // 4. 高度动画
     lv_anim_init(&a_height);
-    lv_anim_set_var(&a_height, transition_card);
-    lv_anim_set_values(&a_height, lv_area_get_height(&item_coords), end_height);
+    lv_anim_set_var(&a_height, target_card);
+    lv_anim_set_values(&a_height, lv_area_get_height(&item_coords), lv_area_get_height(&end_area));
     lv_anim_set_exec_cb(&a_height, (lv_anim_exec_xcb_t)lv_obj_set_height);
     lv_anim_set_time(&a_height, anim_time);
     lv_anim_set_path_cb(&a_height, lv_anim_path_ease_out);
-    
-    // 在卡片内容变化到一定程度后才隐藏内容
-    if (content) {
-        lv_obj_t *clone_content = lv_obj_get_child(transition_card, 0);
-        if (clone_content) {
-            lv_anim_t fade_content;
-            lv_anim_init(&fade_content);
-            lv_anim_set_var(&fade_content, clone_content);
-            lv_anim_set_values(&fade_content, LV_OPA_COVER, LV_OPA_0);
-            lv_anim_set_time(&fade_content, anim_time / 2);
-            lv_anim_set_exec_cb(&fade_content, (lv_anim_exec_xcb_t)lv_obj_set_style_opa);
-            lv_anim_set_path_cb(&fade_content, lv_anim_path_ease_out);
-            lv_anim_start(&fade_content);
-        }
-    }
-    
-    // 5. 圆角动画 - 从圆角渐变到无圆角
-    lv_anim_init(&a_radius);
-    lv_anim_set_var(&a_radius, transition_card);
-    lv_anim_set_values(&a_radius, item_radius, 0);
-    lv_anim_set_exec_cb(&a_radius, (lv_anim_exec_xcb_t)lv_obj_set_style_radius);
-    lv_anim_set_time(&a_radius, anim_time * 0.7); // 更短的时间让圆角先消失
-    lv_anim_set_path_cb(&a_radius, lv_anim_path_ease_in); // 使用ease-in让变化更早发生
-    
-    // 6. 颜色渐变动画 - 从当前颜色到目标颜色
-    lv_anim_init(&a_color);
-    lv_anim_set_var(&a_color, transition_card);
-    lv_anim_set_values(&a_color, 0, 255);
-    lv_anim_set_exec_cb(&a_color, _ui_anim_color_cb);
-    lv_anim_set_time(&a_color, anim_time + 50); // 延长颜色变化时间，使其在尺寸变化后继续
-    lv_anim_set_path_cb(&a_color, lv_anim_path_linear); // 线性颜色变化效果最好
-    
-    // 7. 玻璃效果动画 - 增强立体质感变化
-    lv_anim_init(&a_glass);
-    lv_anim_set_var(&a_glass, transition_card);
-    lv_anim_set_values(&a_glass, 0, 255);
-    lv_anim_set_exec_cb(&a_glass, _ui_anim_glass_effect_cb);
-    lv_anim_set_time(&a_glass, anim_time + 100); // 最长的动画时间
-    lv_anim_set_path_cb(&a_glass, lv_anim_path_overshoot); // 使用弹性效果
-    
-    // 存储屏幕创建函数并设置回调
     lv_anim_set_user_data(&a_height, (void*)create_screen_func);
     lv_anim_set_ready_cb(&a_height, _zoom_anim_ready_cb);
     
-    // 启动所有动画
     lv_anim_start(&a_pos_x);
     lv_anim_start(&a_pos_y);
     lv_anim_start(&a_width);
     lv_anim_start(&a_height);
-    lv_anim_start(&a_radius);
-    lv_anim_start(&a_color);
-    lv_anim_start(&a_glass);
     
     // 添加音效或触觉反馈逻辑可以在这里插入
 }
@@ -19,6 +19,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <poll.h>
 
 #include "lvgl/lvgl.h"
 #if LV_USE_LINUX_DRM
@@ -105,12 +106,22 @@ static lv_display_t *init_drm(void)
 static void run_loop_drm(void)
 {
     uint32_t idle_time;
+    lv_display_t *disp = lv_display_get_default();
+    struct pollfd pfd;
+
+    pfd.fd = lv_linux_drm_get_fd(disp);
+    pfd.events = POLLIN;
 
     /* Handle LVGL tasks */
     while (true) {
         /* Returns the time to the next timer execution */
         idle_time = lv_timer_handler();
-        usleep(idle_time * 1000);
+
+        /* Sleep until the next timer or a page flip event,
+         * a completed flip frees a buffer and commits the queued frame */
+        if (poll(&pfd, 1, idle_time) > 0) {
+            lv_linux_drm_handle_events(disp);
+        }
     }
 }
 
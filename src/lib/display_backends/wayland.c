@@ -16,6 +16,7 @@
  *      INCLUDES
  *********************/
 #include <unistd.h>
+#include <poll.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
@@ -114,15 +115,19 @@ static lv_display_t *init_wayland(void)
 }
 
 /**
- * The run loop of the DRM driver
+ * The run loop of the Wayland driver
  *
- * @note Currently, the wayland driver calls lv_timer_handler internaly
- * The wayland driver needs to be re-written to match the other backends
+ * @note The wayland driver calls lv_timer_handler internaly, rendering
+ * is paced by the compositor's frame callbacks
  */
 static void run_loop_wayland(void)
 {
-
     bool completed;
+    uint32_t idle_time;
+    struct pollfd pfd;
+
+    pfd.fd = lv_wayland_get_fd();
+    pfd.events = POLLIN;
 
     /* Handle LVGL tasks */
     while (true) {
@@ -130,8 +135,10 @@ static void run_loop_wayland(void)
         completed = lv_wayland_timer_handler();
 
         if (completed) {
-            /* wait only if the cycle was completed */
-            usleep(LV_DEF_REFR_PERIOD * 1000);
+            /* Sleep until the next LVGL timer is due or the compositor
+             * sends an event (input, frame done, configure) */
+            idle_time = lv_timer_get_time_until_next();
+            poll(&pfd, 1, idle_time == LV_NO_TIMER_READY ? -1 : (int)idle_time);
         }
 
         /* Run until the last window closes */
@@ -44,6 +44,9 @@ static void print_usage(void);
  * has specified one on the command line */
 static char *selected_backend;
 
+/* Show the overdraw heatmap and print the per-frame fill-rate CSV (-O) */
+static bool overdraw_debug;
+
 /* Global simulator settings, defined in lv_linux_backend.c */
 extern simulator_settings_t settings;
 
@@ -66,11 +69,29 @@ static void print_lvgl_version(void)
  */
 static void print_usage(void)
 {
-    fprintf(stdout, "\nlvglsim [-V] [-B] [-b backend_name] [-W window_width] [-H window_height]\n\n");
+    fprintf(stdout, "\nlvglsim [-V] [-B] [-O] [-b backend_name] [-W window_width] [-H window_height]\n\n");
     fprintf(stdout, "-V print LVGL version\n");
     fprintf(stdout, "-B list supported backends\n");
+    fprintf(stdout, "-O show the overdraw heatmap and print the per-frame fill-rate statistics as CSV\n");
 }
 
+#if LV_USE_OVERDRAW_DEBUG
+/**
+ * @brief Print the fill-rate statistics of a frame as a CSV line to stdout
+ */
+static void overdraw_report_cb(lv_display_t *disp, const lv_refr_overdraw_stats_t *stats)
+{
+    char line[256];
+
+    LV_UNUSED(disp);
+    if (stats->frame == 1) {
+        fprintf(stdout, "%s\n", lv_refr_overdraw_get_csv_header());
+    }
+    lv_refr_overdraw_stats_to_csv(stats, line, sizeof(line));
+    fprintf(stdout, "%s\n", line);
+}
+#endif
+
 /**
  * @brief Configure simulator
  * @description process arguments recieved by the program to select
@@ -91,7 +112,7 @@ static void configure_simulator(int argc, char **argv)
     settings.window_height = atoi(getenv("LV_SIM_WINDOW_HEIGHT") ? : "480");
 
     /* Parse the command-line options. */
-    while ((opt = getopt (argc, argv, "b:fmW:H:BVh")) != -1) {
+    while ((opt = getopt (argc, argv, "b:fmW:H:BVOh")) != -1) {
         switch (opt) {
         case 'h':
             print_usage();
@@ -105,6 +126,9 @@ static void configure_simulator(int argc, char **argv)
             driver_backends_print_supported();
             exit(EXIT_SUCCESS);
             break;
+        case 'O':
+            overdraw_debug = true;
+            break;
         case 'b':
             if (driver_backends_is_supported(optarg) == 0) {
                 die("error no such backend: %s\n", optarg);
@@ -156,6 +180,15 @@ int main(int argc, char **argv)
 
     // 删除对不存在的UDP初始化和定时器的调用
 
+    if (overdraw_debug) {
+#if LV_USE_OVERDRAW_DEBUG
+        lv_refr_overdraw_set_heatmap(NULL, true);
+        lv_refr_overdraw_set_report_cb(NULL, overdraw_report_cb);
+#else
+        fprintf(stderr, "-O requires LV_USE_OVERDRAW_DEBUG in lv_conf.h\n");
+#endif
+    }
+
     /*Create a Demo*/
     //lv_demo_widgets();
     //lv_demo_widgets_start_slideshow();